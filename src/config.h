@@ -12,8 +12,11 @@ const int DEFAULT_TIMEOUT_EXIT_VALUE = 41;
 const int DEFAULT_TEST_CASE_SUCCESSFUL_EXIT_VALUE = 42;
 const int DEFAULT_PRECONDITIONS_NOT_MET_EXIT_VALUE = 43;
 const int DEFAULT_TEST_CASE_FAILED_EXIT_VALUE = 44;
+const int DEFAULT_RESOURCE_EXHAUSTED_EXIT_VALUE = 45;
 
 // how many seconds to wait before a timeout
 const int DEFAULT_TIMEOUT_IN_SECS = 60;
 
 const char TEST_CASE_BINARIES_DIR_NAME[] = "test_case_binaries";
+// binaries shared by several variants during an evaluation, within the binaries directory
+const char BUILD_CACHE_DIR_NAME[] = ".builds";
@@ -0,0 +1,225 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "binary_footprint.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring> // memcpy, strerror, strnlen
+#include <elf.h>
+#include <fstream>
+#include <iterator>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+struct check_symbol_t
+{
+  const char *prefix;
+  const char *infix; // if set, must follow the prefix somewhere in the name
+};
+
+struct section_t
+{
+  std::string name;
+  Elf64_Shdr header;
+};
+}
+
+// the functions of the sanitizer runtimes that report or perform checks
+static const check_symbol_t CHECK_SYMBOLS[] = {
+  {"__asan_report_", nullptr}, {"__asan_load", nullptr}, {"__asan_store", nullptr},
+  {"__hwasan_", nullptr},
+  {"__softboundcets_", "check"},
+};
+
+static const size_t PLT_ENTRY_SIZE = 16; // of the x86-64 PLT, if the section does not tell
+
+static bool is_check_symbol(const char *name)
+{
+  for ( const check_symbol_t &check_symbol: CHECK_SYMBOLS )
+  {
+    const size_t prefix_length = std::strlen(check_symbol.prefix);
+    if ( std::strncmp(name, check_symbol.prefix, prefix_length) != 0 ) continue;
+    if ( !check_symbol.infix || std::strstr(name + prefix_length, check_symbol.infix) ) return true;
+  }
+  return false;
+}
+
+template <typename T>
+static bool read_struct(const std::vector<unsigned char> &data, uint64_t offset, T &value)
+{
+  if ( offset > data.size() || data.size() - offset < sizeof(T) ) return false;
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  return true;
+}
+
+static bool is_in_file(const std::vector<unsigned char> &data, const Elf64_Shdr &header)
+{
+  return header.sh_type == SHT_NOBITS || (header.sh_offset <= data.size() && data.size() - header.sh_offset >= header.sh_size);
+}
+
+static const char *get_string(const std::vector<unsigned char> &data, const Elf64_Shdr &string_table, uint64_t offset)
+{
+  // a string table without contents in the file, or reaching past its end, has no strings
+  if ( string_table.sh_type == SHT_NOBITS || string_table.sh_offset > data.size() || data.size() - string_table.sh_offset < string_table.sh_size ) return "";
+  if ( offset >= string_table.sh_size ) return "";
+  const char *string = reinterpret_cast<const char *>(data.data() + string_table.sh_offset + offset);
+  return strnlen(string, string_table.sh_size - offset) < string_table.sh_size - offset ? string : "";
+}
+
+static const section_t *find_section(const std::vector<section_t> &sections, const std::string &name)
+{
+  for ( const section_t &section: sections )
+  {
+    if ( section.name == name ) return &section;
+  }
+  return nullptr;
+}
+
+/**
+ * Collects the addresses that a check site calls, resp. the GOT slots that it calls through.
+ */
+static void find_check_targets(const std::vector<unsigned char> &data, const std::vector<section_t> &sections,
+  std::unordered_set<uint64_t> &call_targets, std::unordered_set<uint64_t> &got_slots)
+{
+  const section_t *plt_sec = find_section(sections, ".plt.sec"); // the PLT entries called with IBT
+  const section_t *plt = find_section(sections, ".plt");
+  for ( const section_t &section: sections )
+  {
+    const Elf64_Word type = section.header.sh_type;
+    if ( type != SHT_SYMTAB && type != SHT_DYNSYM && type != SHT_RELA ) continue;
+    if ( section.header.sh_link >= sections.size() ) continue;
+    const section_t &linked = sections[section.header.sh_link];
+    if ( type == SHT_SYMTAB || type == SHT_DYNSYM )
+    {
+      for ( uint64_t offset = 0; offset + sizeof(Elf64_Sym) <= section.header.sh_size; offset += sizeof(Elf64_Sym) )
+      {
+        Elf64_Sym symbol;
+        read_struct(data, section.header.sh_offset + offset, symbol);
+        if ( ELF64_ST_TYPE(symbol.st_info) != STT_FUNC || symbol.st_shndx == SHN_UNDEF || symbol.st_value == 0 ) continue;
+        if ( is_check_symbol(get_string(data, linked.header, symbol.st_name)) ) call_targets.insert(symbol.st_value);
+      }
+      continue;
+    }
+
+    // the relocations of the imported functions, against the dynamic symbols
+    if ( linked.header.sh_type != SHT_DYNSYM || linked.header.sh_link >= sections.size() ) continue;
+    const Elf64_Shdr &symbol_names = sections[linked.header.sh_link].header;
+    const bool is_plt = section.name == ".rela.plt";
+    for ( uint64_t index = 0; (index + 1) * sizeof(Elf64_Rela) <= section.header.sh_size; index++ )
+    {
+      Elf64_Rela relocation;
+      Elf64_Sym symbol;
+      read_struct(data, section.header.sh_offset + index * sizeof(Elf64_Rela), relocation);
+      if ( !read_struct(data, linked.header.sh_offset + ELF64_R_SYM(relocation.r_info) * sizeof(Elf64_Sym), symbol) ) continue;
+      if ( !is_check_symbol(get_string(data, symbol_names, symbol.st_name)) ) continue;
+      got_slots.insert(relocation.r_offset);
+      if ( !is_plt ) continue;
+      if ( plt_sec )
+      {
+        call_targets.insert(plt_sec->header.sh_addr + index * (plt_sec->header.sh_entsize ? plt_sec->header.sh_entsize : PLT_ENTRY_SIZE));
+      }
+      else if ( plt ) // the first entry resolves the others
+      {
+        call_targets.insert(plt->header.sh_addr + (index + 1) * (plt->header.sh_entsize ? plt->header.sh_entsize : PLT_ENTRY_SIZE));
+      }
+    }
+  }
+}
+
+/**
+ * Counts the calls to the check targets in the code: call rel32 (E8) and call *disp32(%rip) (FF 15). The code is not
+ * disassembled, so any such bytes count, which is unlikely to hit a target by chance.
+ */
+static size_t count_check_sites(const std::vector<unsigned char> &data, const std::vector<section_t> &sections)
+{
+  std::unordered_set<uint64_t> call_targets;
+  std::unordered_set<uint64_t> got_slots;
+  find_check_targets(data, sections, call_targets, got_slots);
+  if ( call_targets.empty() && got_slots.empty() ) return 0;
+
+  size_t check_sites = 0;
+  for ( const section_t &section: sections )
+  {
+    const Elf64_Shdr &header = section.header;
+    if ( header.sh_type != SHT_PROGBITS || !(header.sh_flags & SHF_EXECINSTR) || section.name.compare(0, 4, ".plt") == 0 ) continue;
+    const unsigned char *code = data.data() + header.sh_offset;
+    for ( uint64_t offset = 0; offset + 5 <= header.sh_size; offset++ )
+    {
+      int32_t displacement;
+      if ( code[offset] == 0xe8 )
+      {
+        std::memcpy(&displacement, code + offset + 1, sizeof(displacement));
+        if ( call_targets.count(header.sh_addr + offset + 5 + displacement) ) check_sites++;
+      }
+      else if ( code[offset] == 0xff && offset + 6 <= header.sh_size && code[offset + 1] == 0x15 )
+      {
+        std::memcpy(&displacement, code + offset + 2, sizeof(displacement));
+        if ( got_slots.count(header.sh_addr + offset + 6 + displacement) ) check_sites++;
+      }
+    }
+  }
+  return check_sites;
+}
+
+bool read_binary_footprint(const std::string &path, binary_footprint_t &footprint, std::string &error)
+{
+  std::ifstream file(path, std::ios::binary);
+  const std::vector<unsigned char> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+  if ( !file.good() && !file.eof() )
+  {
+    error = "Error reading file: " + path + ": " + std::strerror(errno);
+    return false;
+  }
+
+  Elf64_Ehdr elf_header;
+  if ( !read_struct(data, 0, elf_header) || std::memcmp(elf_header.e_ident, ELFMAG, SELFMAG) != 0 )
+  {
+    error = path + " is not an ELF file";
+    return false;
+  }
+  if ( elf_header.e_ident[EI_CLASS] != ELFCLASS64 || elf_header.e_ident[EI_DATA] != ELFDATA2LSB || elf_header.e_shentsize != sizeof(Elf64_Shdr) )
+  {
+    error = path + " is not a 64-bit little-endian ELF file";
+    return false;
+  }
+
+  std::vector<section_t> sections(elf_header.e_shnum);
+  for ( size_t index = 0; index < sections.size(); index++ )
+  {
+    if ( !read_struct(data, elf_header.e_shoff + index * sizeof(Elf64_Shdr), sections[index].header) || !is_in_file(data, sections[index].header) )
+    {
+      error = path + " has a truncated section";
+      return false;
+    }
+  }
+  if ( elf_header.e_shstrndx < sections.size() )
+  {
+    for ( section_t &section: sections )
+    {
+      section.name = get_string(data, sections[elf_header.e_shstrndx].header, section.header.sh_name);
+    }
+  }
+
+  footprint = binary_footprint_t();
+  footprint.file_size = data.size();
+  for ( const section_t &section: sections )
+  {
+    if ( section.name == ".text" ) footprint.text_size += section.header.sh_size;
+    else if ( section.name == ".data" ) footprint.data_size += section.header.sh_size;
+    else if ( section.name == ".bss" ) footprint.bss_size += section.header.sh_size;
+    else if ( section.name == ".data.index" ) footprint.data_index_size += section.header.sh_size;
+  }
+  footprint.counts_check_sites = elf_header.e_machine == EM_X86_64;
+  if ( footprint.counts_check_sites )
+  {
+    footprint.check_sites = count_check_sites(data, sections);
+  }
+  return true;
+}
@@ -0,0 +1,34 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * The sizes of the sections of a binary that sanitizers grow, in bytes, and the number of calls to sanitizer checks in
+ * its code.
+ */
+struct binary_footprint_t
+{
+  size_t file_size = 0;
+  size_t text_size = 0;
+  size_t data_size = 0;
+  size_t bss_size = 0;
+  size_t data_index_size = 0; // the variables of the test case in their own section, see CodeCanvas::add_to_custom_section()
+  size_t check_sites = 0;
+  bool counts_check_sites = false; // the call sites are only decoded in x86-64 code
+};
+
+/**
+ * Reads the footprint of the 64-bit little-endian ELF binary at path. A check site is a direct call, or an indirect
+ * call through the GOT, to a function of the sanitizer runtimes that reports or performs a check, e.g.,
+ * __asan_report_load4, __hwasan_load4 or __softboundcets_spatial_load_dereference_check, either defined in the binary
+ * or imported through the PLT or the GOT. Returns false and sets error if the binary cannot be read or is no such ELF
+ * file.
+ */
+bool read_binary_footprint(const std::string &path, binary_footprint_t &footprint, std::string &error);
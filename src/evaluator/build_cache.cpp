@@ -0,0 +1,397 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "build_cache.h"
+
+#include <algorithm>
+#include <climits>    // PATH_MAX
+#include <cstdio>     // remove
+#include <cstdlib>    // getenv, realpath
+#include <ctime>
+#include <dirent.h>
+#include <fcntl.h>    // open
+#include <fstream>
+#include <functional> // greater
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/file.h> // flock
+#include <sys/stat.h>
+#include <unistd.h>   // link, rmdir
+#include <vector>
+
+#include "misc.h"
+
+static const char INDEX_FILE_NAME[] = "index";
+static const char LOCK_FILE_NAME[] = "index.lock"; // held while the index is merged and written
+static const char INDEX_MAGIC[] = "mset_builds";
+static const int INDEX_VERSION = 2; // 2: keys include the toolchain, entries their last use
+
+static const int64_t MAX_UNUSED_SECONDS = 30 * 24 * 60 * 60; // entries unused for longer are evicted
+static const uint64_t MAX_CACHED_BYTES = 4ULL << 30;         // the least recently used binaries beyond are evicted
+static const int64_t ORPHAN_SECONDS = 24 * 60 * 60;          // age of binaries missing from the index when they are removed
+
+static int64_t get_time()
+{
+  return static_cast<int64_t>(std::time(nullptr));
+}
+
+/**
+ * The path of the executable that the shell runs for name, or an empty string if there is none.
+ */
+static std::string find_executable(const std::string &name)
+{
+  if ( name.find('/') != std::string::npos ) return name;
+  const char *path = std::getenv("PATH");
+  std::istringstream directories(path ? path : "");
+  std::string directory;
+  while ( std::getline(directories, directory, ':') )
+  {
+    const std::string candidate = (directory.empty() ? "." : directory) + "/" + name;
+    if ( access(candidate.c_str(), X_OK) == 0 ) return candidate;
+  }
+  return "";
+}
+
+static void add_file_identity(const std::string &path, std::string &identity)
+{
+  char real_path[PATH_MAX];
+  struct stat file_stat;
+  if ( !realpath(path.c_str(), real_path) || stat(real_path, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) ) return;
+  identity += std::string(real_path) + " " + std::to_string(file_stat.st_size) + " " + std::to_string(file_stat.st_mtim.tv_sec)
+    + "." + std::to_string(file_stat.st_mtim.tv_nsec) + "\n";
+}
+
+/**
+ * Identifies the files that the commands of a signature use: the executable of each command line, e.g., the compiler,
+ * and the existing files named in its words, e.g., "-fplugin=/path/plugin.so", "-Wl,-T,/path/script.ld" or
+ * "LD_PRELOAD=/path/runtime.so", by their path, size and modification time. Upgrading any of them changes the identity.
+ */
+static std::string describe_toolchain(const std::string &signature)
+{
+  std::string identity;
+  std::istringstream lines(signature);
+  std::string line;
+  while ( std::getline(lines, line) )
+  {
+    std::istringstream words(line);
+    std::string word;
+    bool is_first_word = true;
+    while ( words >> word )
+    {
+      word.erase(std::remove_if(word.begin(), word.end(), [](char c) { return c == '"' || c == '\'' || c == ';'; }), word.end());
+      if ( is_first_word && word.find('=') == std::string::npos ) // after the variable assignments of the command
+      {
+        is_first_word = false;
+        if ( !word.empty() && word[0] != '$' ) add_file_identity(find_executable(word), identity);
+        continue;
+      }
+      std::string part;
+      std::istringstream parts(word);
+      while ( std::getline(parts, part, ',') )
+      {
+        std::istringstream paths(part.substr(part.find('=') + 1)); // the whole part without '='
+        std::string path;
+        while ( std::getline(paths, path, ':') )
+        {
+          if ( path.find('/') != std::string::npos && path.find('$') == std::string::npos ) add_file_identity(path, identity);
+        }
+      }
+    }
+  }
+  return identity;
+}
+
+BuildCache::BuildCache(std::string dir_path, bool persistent): dir_path(std::move(dir_path)), persistent(persistent)
+{
+  create_directory(this->dir_path);
+  if ( persistent ) load_index(builds, results);
+}
+
+BuildCache::~BuildCache()
+{
+  if ( persistent )
+  {
+    save_index();
+    return;
+  }
+  // builds planned for variants that were skipped, e.g., after a successful variant
+  for ( const auto &build: builds )
+  {
+    if ( build.second.is_cached ) remove(get_cached_path(build.first).c_str());
+  }
+  rmdir(dir_path.c_str());
+}
+
+uint64_t BuildCache::hash_source(const char *source, size_t source_length)
+{
+  std::string stripped;
+  stripped.reserve(source_length);
+  size_t i = 0;
+  while ( i < source_length )
+  {
+    const char c = source[i];
+    if ( c == '"' || c == '\'' )
+    {
+      // literals are kept as they are, they may contain comment delimiters
+      stripped += source[i++];
+      while ( i < source_length && source[i] != c )
+      {
+        if ( source[i] == '\\' && i + 1 < source_length ) stripped += source[i++];
+        stripped += source[i++];
+      }
+      if ( i < source_length ) stripped += source[i++];
+    }
+    else if ( c == '/' && i + 1 < source_length && source[i + 1] == '/' )
+    {
+      while ( i < source_length && source[i] != '\n' ) i++;
+    }
+    else if ( c == '/' && i + 1 < source_length && source[i + 1] == '*' )
+    {
+      i += 2;
+      while ( i + 1 < source_length && !(source[i] == '*' && source[i + 1] == '/') ) i++;
+      i += 2;
+      stripped += ' '; // a comment separates tokens
+    }
+    else
+    {
+      stripped += source[i++];
+    }
+  }
+  return fnv1a_64(stripped.data(), stripped.size());
+}
+
+const std::string &BuildCache::get_toolchain(const std::string &signature)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  auto toolchain = toolchains.find(signature);
+  if ( toolchain == toolchains.end() ) toolchain = toolchains.emplace(signature, describe_toolchain(signature)).first;
+  return toolchain->second;
+}
+
+uint64_t BuildCache::make_build_key(const std::string &compile_signature, uint64_t source_hash)
+{
+  const std::string key = compile_signature + "\n" + get_toolchain(compile_signature) + std::to_string(source_hash);
+  return fnv1a_64(key.data(), key.size());
+}
+
+uint64_t BuildCache::make_run_key(uint64_t binary_hash, const std::string &run_signature, const std::string &compile_signature)
+{
+  // the runtime of the sanitizer is usually installed with its compiler, without being named in the commands
+  const std::string key = run_signature + "\n" + get_toolchain(run_signature) + get_toolchain(compile_signature) + std::to_string(binary_hash);
+  return fnv1a_64(key.data(), key.size());
+}
+
+std::string BuildCache::get_cached_path(uint64_t build_key) const
+{
+  std::ostringstream path;
+  path << dir_path << "/" << std::hex << std::setw(16) << std::setfill('0') << build_key;
+  return path.str();
+}
+
+void BuildCache::plan(uint64_t build_key)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  builds[build_key].remaining_uses++;
+}
+
+bool BuildCache::link_binary(uint64_t build_key, const std::string &binary_path, uint64_t &binary_hash)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  Build &build = builds[build_key];
+  if ( build.remaining_uses > 0 ) build.remaining_uses--;
+  if ( !build.is_cached ) return false;
+  build.last_used = get_time();
+
+  const std::string cached_path = get_cached_path(build_key);
+  remove(binary_path.c_str()); // e.g., kept by a previous evaluation
+  if ( link(cached_path.c_str(), binary_path.c_str()) != 0 ) return false;
+  binary_hash = build.binary_hash;
+  if ( build.remaining_uses == 0 && !persistent )
+  {
+    remove(cached_path.c_str());
+    build.is_cached = false;
+  }
+  reused_binaries++;
+  return true;
+}
+
+void BuildCache::add_binary(uint64_t build_key, const std::string &binary_path, uint64_t binary_hash)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  Build &build = builds[build_key];
+  if ( build.is_cached || (build.remaining_uses == 0 && !persistent) ) return; // no further use, or compiled concurrently
+  if ( link(binary_path.c_str(), get_cached_path(build_key).c_str()) == 0 )
+  {
+    build.is_cached = true;
+    build.binary_hash = binary_hash;
+    build.last_used = get_time();
+  }
+}
+
+bool BuildCache::find_result(uint64_t run_key, exec_result_t &result)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto found = results.find(run_key);
+  if ( found == results.end() ) return false;
+  result = found->second.result;
+  found->second.last_used = get_time();
+  reused_results++;
+  return true;
+}
+
+void BuildCache::add_result(uint64_t run_key, exec_result_t result)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  results.emplace(run_key, Result{result, get_time()});
+}
+
+/**
+ * The index lists a line "b <build key> <binary hash> <last use>" per cached binary and "r <run key> <result> <last use>"
+ * per result, with the last use in seconds since the epoch. Binaries removed from the directory meanwhile are dropped,
+ * and an unreadable index, e.g., of an older version, only costs the cached builds.
+ */
+void BuildCache::load_index(std::unordered_map<uint64_t, Build> &index_builds, std::unordered_map<uint64_t, Result> &index_results) const
+{
+  std::ifstream in(dir_path + "/" + INDEX_FILE_NAME);
+  std::string magic;
+  int version = 0;
+  if ( !(in >> magic >> version) || magic != INDEX_MAGIC || version != INDEX_VERSION ) return;
+  char type;
+  uint64_t key;
+  uint64_t value;
+  int64_t last_used;
+  while ( in >> type >> std::hex >> key >> value >> std::dec >> last_used )
+  {
+    if ( type == 'b' && access(get_cached_path(key).c_str(), F_OK) == 0 )
+    {
+      Build &build = index_builds[key];
+      build.is_cached = true;
+      build.binary_hash = value;
+      build.last_used = last_used;
+    }
+    else if ( type == 'r' && value <= RESOURCE_EXHAUSTED )
+    {
+      index_results[key] = Result{static_cast<exec_result_t>(value), last_used};
+    }
+  }
+}
+
+/**
+ * Evicts the entries unused for MAX_UNUSED_SECONDS and the least recently used binaries beyond MAX_CACHED_BYTES, and
+ * removes the binaries of the directory that no index lists since ORPHAN_SECONDS, e.g., of a killed evaluation.
+ */
+void BuildCache::prune(std::unordered_map<uint64_t, Build> &index_builds, std::unordered_map<uint64_t, Result> &index_results) const
+{
+  const int64_t now = get_time();
+  for ( auto result = index_results.begin(); result != index_results.end(); )
+  {
+    if ( now - result->second.last_used > MAX_UNUSED_SECONDS ) result = index_results.erase(result);
+    else ++result;
+  }
+
+  std::vector<std::pair<int64_t, uint64_t>> cached; // last use and key, most recent first
+  for ( const auto &build: index_builds )
+  {
+    if ( build.second.is_cached ) cached.emplace_back(build.second.last_used, build.first);
+  }
+  std::sort(cached.begin(), cached.end(), std::greater<std::pair<int64_t, uint64_t>>());
+  uint64_t cached_bytes = 0;
+  for ( const auto &build: cached )
+  {
+    const std::string cached_path = get_cached_path(build.second);
+    struct stat file_stat;
+    if ( stat(cached_path.c_str(), &file_stat) == 0 ) cached_bytes += static_cast<uint64_t>(file_stat.st_size);
+    if ( now - build.first > MAX_UNUSED_SECONDS || cached_bytes > MAX_CACHED_BYTES )
+    {
+      remove(cached_path.c_str());
+      index_builds.erase(build.second);
+    }
+  }
+
+  DIR *dir = opendir(dir_path.c_str());
+  if ( !dir ) return;
+  while ( const struct dirent *entry = readdir(dir) )
+  {
+    const std::string name = entry->d_name;
+    if ( name.size() != 16 || name.find_first_not_of("0123456789abcdef") != std::string::npos ) continue;
+    const auto build = index_builds.find(std::stoull(name, nullptr, 16));
+    if ( build != index_builds.end() && build->second.is_cached ) continue;
+    const std::string orphan_path = dir_path + "/" + name;
+    struct stat file_stat;
+    if ( stat(orphan_path.c_str(), &file_stat) == 0 && now - static_cast<int64_t>(file_stat.st_mtime) > ORPHAN_SECONDS )
+    {
+      remove(orphan_path.c_str());
+    }
+  }
+  closedir(dir);
+}
+
+/**
+ * Merges the index with the one written meanwhile by other evaluations using the directory, prunes it and writes it,
+ * all under the lock file, so that concurrent evaluations do not drop the entries of each other.
+ */
+void BuildCache::save_index()
+{
+  const std::string path = dir_path + "/" + INDEX_FILE_NAME;
+  const std::string tmp_path = path + ".tmp";
+  const std::string lock_path = dir_path + "/" + LOCK_FILE_NAME;
+  const int lock_fd = open(lock_path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+  if ( lock_fd == -1 || flock(lock_fd, LOCK_EX) != 0 )
+  {
+    std::cerr << "WARNING: Could not lock the index of the build cache " << lock_path << ".\n";
+    if ( lock_fd != -1 ) close(lock_fd);
+    return;
+  }
+
+  std::unordered_map<uint64_t, Build> index_builds;
+  std::unordered_map<uint64_t, Result> index_results;
+  load_index(index_builds, index_results);
+  for ( const auto &build: builds )
+  {
+    if ( !build.second.is_cached ) continue;
+    Build &index_build = index_builds[build.first];
+    index_build.last_used = std::max(index_build.last_used, build.second.last_used);
+    index_build.is_cached = true;
+    index_build.binary_hash = build.second.binary_hash;
+  }
+  for ( const auto &result: results )
+  {
+    auto index_result = index_results.emplace(result.first, result.second).first;
+    index_result->second.last_used = std::max(index_result->second.last_used, result.second.last_used);
+  }
+  prune(index_builds, index_results);
+
+  std::ofstream out(tmp_path);
+  out << INDEX_MAGIC << " " << INDEX_VERSION << "\n";
+  for ( const auto &build: index_builds )
+  {
+    out << "b " << std::hex << build.first << " " << build.second.binary_hash << std::dec << " " << build.second.last_used << "\n";
+  }
+  for ( const auto &result: index_results )
+  {
+    out << "r " << std::hex << result.first << " " << static_cast<uint64_t>(result.second.result) << std::dec << " " << result.second.last_used << "\n";
+  }
+  out.close();
+  if ( !out || rename(tmp_path.c_str(), path.c_str()) != 0 )
+  {
+    std::cerr << "WARNING: Could not write the index of the build cache " << path << ".\n";
+    remove(tmp_path.c_str());
+  }
+  close(lock_fd); // releases the lock
+}
+
+bool hash_file(const std::string &path, uint64_t &hash)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  if ( !file ) return false;
+  const std::string data = content.str();
+  hash = fnv1a_64(data.data(), data.size());
+  return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "evaluator/sanitizer.h"
+
+/**
+ * Shares binaries and execution results between test case variants that build to the same binary.
+ *
+ * A build is identified by the compile commands, the files they use (see describe_toolchain()) and the source with its
+ * comments stripped, since the variants of a test case (and a variant and its baseline, if both are compiled alike)
+ * often differ only in their descriptions. Builds expected to be used more than once are kept in the cache directory
+ * and hardlinked to the binary path of each further use. An execution is identified by the hash of the binary, the run
+ * command and the files that both the run and the compile commands use, e.g., the sanitizer runtime installed with the
+ * compiler, so that the result of a deterministic sanitizer can be reused for any variant building to the same binary.
+ *
+ * A persistent cache keeps its binaries and results, and its index, in the cache directory when destroyed, so that
+ * the next evaluation using the directory starts with them, see --serve. Before writing its index, it merges the index
+ * written meanwhile by other evaluations under a lock, and evicts the entries that were not used for a month and the
+ * least recently used binaries beyond MAX_CACHED_BYTES.
+ */
+class BuildCache
+{
+public:
+  explicit BuildCache(std::string dir_path, bool persistent = false);
+  ~BuildCache();
+  BuildCache(const BuildCache &) = delete;
+  BuildCache &operator=(const BuildCache &) = delete;
+
+  /**
+   * FNV-1a hash of a C source without its comments.
+   */
+  static uint64_t hash_source(const char *source, size_t source_length);
+  uint64_t make_build_key(const std::string &compile_signature, uint64_t source_hash);
+  uint64_t make_run_key(uint64_t binary_hash, const std::string &run_signature, const std::string &compile_signature);
+
+  /**
+   * Announces a use of the build, so that its binary is kept until its last announced use.
+   */
+  void plan(uint64_t build_key);
+
+  /**
+   * Hardlinks the binary of the build to binary_path. Returns false if the build is not cached, i.e., if it has to
+   * be compiled and passed to add_binary().
+   */
+  bool link_binary(uint64_t build_key, const std::string &binary_path, uint64_t &binary_hash);
+  void add_binary(uint64_t build_key, const std::string &binary_path, uint64_t binary_hash);
+
+  bool find_result(uint64_t run_key, exec_result_t &result);
+  void add_result(uint64_t run_key, exec_result_t result);
+
+  size_t get_reused_binaries() const { return reused_binaries; }
+  size_t get_reused_results() const { return reused_results; }
+
+private:
+  struct Build
+  {
+    size_t remaining_uses = 0;
+    bool is_cached = false;
+    uint64_t binary_hash = 0;
+    int64_t last_used = 0; // seconds since the epoch
+  };
+
+  struct Result
+  {
+    exec_result_t result;
+    int64_t last_used;
+  };
+
+  std::string get_cached_path(uint64_t build_key) const;
+  const std::string &get_toolchain(const std::string &signature);
+  void load_index(std::unordered_map<uint64_t, Build> &index_builds, std::unordered_map<uint64_t, Result> &index_results) const;
+  void save_index();
+  void prune(std::unordered_map<uint64_t, Build> &index_builds, std::unordered_map<uint64_t, Result> &index_results) const;
+
+  std::string dir_path;
+  bool persistent;
+  std::mutex mutex;
+  std::unordered_map<uint64_t, Build> builds;
+  std::unordered_map<uint64_t, Result> results;
+  std::unordered_map<std::string, std::string> toolchains; // per signature, see describe_toolchain()
+  std::atomic<size_t> reused_binaries{0};
+  std::atomic<size_t> reused_results{0};
+};
+
+/**
+ * FNV-1a hash of the content of a file. Returns false if the file cannot be read.
+ */
+bool hash_file(const std::string &path, uint64_t &hash);
@@ -0,0 +1,53 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <csignal>
+#include <mutex>
+#include <sys/types.h>
+
+/**
+ * Lets one thread cancel the execution of a test case running on another thread, see Sanitizer::execute().
+ * The execution runs in its own process group, which is killed as a whole on cancellation.
+ */
+class CancellationToken
+{
+public:
+  void cancel()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled = true;
+    if ( process_group != 0 ) kill(-process_group, SIGKILL);
+  }
+
+  bool is_cancelled()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return cancelled;
+  }
+
+  /**
+   * Registers the process group of a starting execution. Returns false if already cancelled.
+   */
+  bool start(pid_t new_process_group)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    process_group = new_process_group;
+    return !cancelled;
+  }
+
+  void finish()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    process_group = 0;
+  }
+
+private:
+  std::mutex mutex;
+  bool cancelled = false;
+  pid_t process_group = 0;
+};
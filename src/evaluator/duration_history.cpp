@@ -0,0 +1,84 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "duration_history.h"
+
+#include <cstdio> // rename
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+static const char DURATIONS_MAGIC[] = "mset_durations 1";
+
+std::string DurationHistory::make_key(const std::string &sanitizer_name, bool is_baseline, const std::string &test_case_id)
+{
+  return std::string(is_baseline ? "b" : "n") + " " + test_case_id + " " + sanitizer_name;
+}
+
+bool DurationHistory::load(const std::string &path)
+{
+  std::ifstream file(path);
+  if ( !file ) return true;
+
+  std::string line;
+  if ( !std::getline(file, line) || line != DURATIONS_MAGIC ) return false;
+  std::lock_guard<std::mutex> lock(mutex);
+  while ( std::getline(file, line) )
+  {
+    std::istringstream entry(line);
+    double compile_seconds;
+    double run_seconds;
+    std::string key;
+    if ( !(entry >> compile_seconds >> run_seconds) || compile_seconds < 0 || run_seconds < 0 ) return false;
+    entry >> std::ws;
+    std::getline(entry, key);
+    if ( key.empty() ) return false;
+    durations[key] = std::make_pair(compile_seconds, run_seconds);
+  }
+  return true;
+}
+
+bool DurationHistory::save(const std::string &path) const
+{
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::trunc);
+    file << DURATIONS_MAGIC << "\n" << std::fixed << std::setprecision(3);
+    std::lock_guard<std::mutex> lock(mutex);
+    for ( const auto &duration: durations )
+    {
+      file << duration.second.first << " " << duration.second.second << " " << duration.first << "\n";
+    }
+    if ( !file.flush() ) return false;
+  }
+  return rename(tmp_path.c_str(), path.c_str()) == 0;
+}
+
+void DurationHistory::record(const std::string &sanitizer_name, bool is_baseline, const std::string &test_case_id,
+                             double compile_seconds, double run_seconds)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  const std::string key = make_key(sanitizer_name, is_baseline, test_case_id);
+  const auto recorded = durations.find(key);
+  if ( compile_seconds < 0 || run_seconds < 0 )
+  {
+    if ( recorded == durations.end() ) return;
+    if ( compile_seconds < 0 ) compile_seconds = recorded->second.first;
+    if ( run_seconds < 0 ) run_seconds = recorded->second.second;
+  }
+  durations[key] = std::make_pair(compile_seconds, run_seconds);
+}
+
+bool DurationHistory::find(const std::string &sanitizer_name, bool is_baseline, const std::string &test_case_id,
+                           double &seconds) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto found = durations.find(make_key(sanitizer_name, is_baseline, test_case_id));
+  if ( found == durations.end() ) return false;
+  seconds = found->second.first + found->second.second;
+  return true;
+}
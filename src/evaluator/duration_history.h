@@ -0,0 +1,52 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <map>
+#include <mutex>
+#include <string>
+
+/**
+ * Compile and run durations of test case variants measured by previous evaluations, used to start the longest jobs
+ * first and to estimate the remaining time of an evaluation.
+ *
+ * The durations file holds one line per variant, keyed by the phase (b for baseline, n for sanitizer), the test case
+ * ID and the sanitizer name:
+ *   <compile seconds> <run seconds> <b|n> <test case ID> <sanitizer name>
+ * Durations measured again replace the recorded ones.
+ */
+class DurationHistory
+{
+public:
+  /**
+   * Reads the durations recorded in path; a missing file is an empty history. Returns false on malformed files.
+   */
+  bool load(const std::string &path);
+
+  /**
+   * Writes all durations to path, replacing it atomically. Returns false on errors.
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * Records the durations of a variant. A negative duration was not measured, e.g., the compile duration of a reused
+   * binary, and keeps the recorded one; without one, the variant is not recorded.
+   */
+  void record(const std::string &sanitizer_name, bool is_baseline, const std::string &test_case_id,
+              double compile_seconds, double run_seconds);
+
+  /**
+   * Gets the recorded compile plus run duration of a variant. Returns false if it has none.
+   */
+  bool find(const std::string &sanitizer_name, bool is_baseline, const std::string &test_case_id, double &seconds) const;
+
+private:
+  static std::string make_key(const std::string &sanitizer_name, bool is_baseline, const std::string &test_case_id);
+
+  mutable std::mutex mutex;
+  std::map<std::string, std::pair<double, double>> durations; // compile and run seconds per key
+};
@@ -8,28 +8,52 @@
 #include "evaluator.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
-
-#include <csignal>   // signal
+#include <chrono>
+#include <climits>   // PATH_MAX
+#include <cmath>     // ceil, lround
 #include <cstdio>    // remove
+#include <cstdlib>   // realpath
 #include <cstring>   // strerror
 #include <dirent.h>  // opendir, readdir, closedir
+#include <fstream>
 #include <functional>
+#include <future>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <unistd.h>
 #include <set>
 #include <sstream>
 #include <stddef.h>
 #include <sys/stat.h> // stat
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 
 #include "config.h"
+#include "misc.h"
+#include "packed_suite.h"
+#include "test_case_selector.h"
+#include "trace.h"
+#include "evaluator/binary_footprint.h"
+#include "evaluator/build_cache.h"
+#include "evaluator/duration_history.h"
+#include "evaluator/journal.h"
 #include "evaluator/logger.h"
+#include "evaluator/metrics.h"
+#include "evaluator/prelude.h"
+#include "evaluator/result_store.h"
+#include "evaluator/results_exporter.h"
+#include "evaluator/sampling.h"
+#include "evaluator/scheduler.h"
 #include "evaluator/sanitizer.h"
 #include "evaluator/test_case_information.h"
-
-log_level_t Logger::allowed_log_level = log_level_t::NORMAL;
+#include "evaluator/work_queue.h"
+#include "generator/code_canvas.h"
 
 struct FileInfo
 {
@@ -116,141 +140,309 @@ static std::set<FileInfo> get_binaries_from_dir(const std::string& dir_path)
   return parse_dir(dir_path, is_valid_binary_file);
 }
 
-static std::vector<exec_result_t> raw_overall_results;
-static std::vector<exec_result_t> raw_overall_baseline_results;
-static std::map<std::string, std::vector<exec_result_t>> raw_temporal_results;
-static std::map<std::string, std::vector<exec_result_t>> raw_spatial_results;
-static std::map<std::string, std::vector<exec_result_t>> raw_temporal_baseline_results;
-static std::map<std::string, std::vector<exec_result_t>> raw_spatial_baseline_results;
-static std::map<std::shared_ptr<TemporalTestCaseInformation>, std::vector<exec_result_t>, CompareTestCaseInformation> temporal_results;
-static std::map<std::shared_ptr<SpatialTestCaseInformation>, std::vector<exec_result_t>, CompareTestCaseInformation> spatial_results;
-static std::map<std::shared_ptr<TemporalTestCaseInformation>, std::vector<exec_result_t>, CompareTestCaseInformation> temporal_baseline_results;
-static std::map<std::shared_ptr<SpatialTestCaseInformation>, std::vector<exec_result_t>, CompareTestCaseInformation> spatial_baseline_results;
+static std::unique_ptr<PackedSuite> packed_suite;
 
-static bool collect_result(const std::shared_ptr<TestCaseInformation> &test_case_information, exec_result_t result, const std::string &file_name, bool is_baseline)
+static std::vector<std::shared_ptr<TestCaseInformation>> get_test_cases_from_packed_suite(const std::string& packed_suite_path)
 {
-  bool can_stop = false;
-  if (is_baseline) Logger(log_level_t::VERBOSE) << "Baseline result for ";
-  else Logger(log_level_t::VERBOSE) << "Result for ";
-  Logger(log_level_t::VERBOSE) << test_case_information->to_string() << " (" << file_name << "): ";
+  std::vector<std::shared_ptr<TestCaseInformation>> test_cases;
+  packed_suite = PackedSuite::open(packed_suite_path);
+  if ( !packed_suite )
+  {
+    exit(EXIT_FAILURE);
+  }
+  test_cases.reserve(packed_suite->size());
+  for ( size_t i = 0; i < packed_suite->size(); i++ )
+  {
+    const PackedSuiteEntry &entry = packed_suite->entry(i);
+    if ( !packed_suite->verify(i) )
+    {
+      std::cerr << "ERROR: content hash mismatch for " << packed_suite->name(i) << " in " << packed_suite_path << ". Aborting.\n";
+      exit(EXIT_FAILURE);
+    }
+    std::shared_ptr<TestCaseInformation> test_case_information = TestCaseInformation::construct_from_dimension_ids(
+      std::vector<uint8_t>(entry.dimension_ids, entry.dimension_ids + entry.dimension_count),
+      entry.is_validation != 0,
+      entry.variant_number,
+      packed_suite->name(i),
+      entry.origin_size,
+      entry.target_size
+    );
+    if ( !test_case_information )
+    {
+      std::cerr << "ERROR: invalid dimensions for " << packed_suite->name(i) << " in " << packed_suite_path << ". Aborting.\n";
+      exit(EXIT_FAILURE);
+    }
+    test_case_information->set_source(packed_suite->source(i), entry.source_length);
+    test_cases.push_back(test_case_information);
+  }
+  return test_cases;
+}
 
-  switch (result)
+static std::vector<std::shared_ptr<TestCaseInformation>> get_test_cases_from_generated(const std::vector<GeneratedTestCase>& generated_test_cases)
+{
+  std::vector<std::shared_ptr<TestCaseInformation>> test_cases;
+  test_cases.reserve(generated_test_cases.size());
+  for ( const auto& generated_test_case : generated_test_cases )
   {
-    case PRECONDITIONS_FAILED:
-      Logger(log_level_t::VERBOSE) << "PRECONDITIONS_FAILED\n";
-      break;
-    case FAILED:
-      Logger(log_level_t::VERBOSE) << "FAILED\n";
-      break;
-    case FAILED_SIGSEGV:
-      Logger(log_level_t::VERBOSE) << "FAILED_SIGSEGV\n";
-      break;
-    case TIMEOUT:
-      Logger(log_level_t::VERBOSE) << "TIMEOUT\n";
-      break;
-    case SUCCESSFUL:
-      Logger(log_level_t::VERBOSE) << "SUCCESSFUL\n";
-      can_stop = true;
-      break;
-    default:
-      break;
+    std::shared_ptr<TestCaseInformation> test_case_information = TestCaseInformation::construct_from_file_name(generated_test_case.name, "", /*is_binary=*/true);
+    test_case_information->set_source(generated_test_case.source.data(), generated_test_case.source.size());
+    test_cases.push_back(test_case_information);
   }
+  return test_cases;
+}
 
-  const std::shared_ptr<TemporalTestCaseInformation> temporal_ptr = std::dynamic_pointer_cast<TemporalTestCaseInformation>(test_case_information);
-  if ( temporal_ptr )
+static bool is_selected(const EvaluationOptions &options, const std::shared_ptr<TestCaseInformation> &test_case_information)
+{
+  if ( options.shard_count > 1 && !is_in_shard(*test_case_information, options.shard_index, options.shard_count) )
   {
-    if (is_baseline) temporal_baseline_results[temporal_ptr].push_back(result);
-    else temporal_results[temporal_ptr].push_back(result);
+    return false;
   }
-  else
+  return !options.selector
+    || ( options.selector->matches_group(*test_case_information)
+      && options.selector->matches_variant(test_case_information->get_is_validation(), test_case_information->get_variant_number()) );
+}
+
+/**
+ * A sanitizer configuration parsed by preload().
+ */
+struct ResidentSanitizer
+{
+  std::string version; // see get_file_version()
+  Sanitizer sanitizer;
+};
+
+/**
+ * The test cases of a directory or packed suite indexed by preload().
+ */
+struct ResidentSuite
+{
+  std::string version; // see get_file_version()
+  std::unique_ptr<PackedSuite> packed_suite; // holds the sources of the test cases, if read from a packed suite
+  std::vector<std::shared_ptr<TestCaseInformation>> test_cases; // before selection
+};
+
+static std::map<std::string, ResidentSanitizer> resident_sanitizers; // per real path of the configuration
+static std::map<std::string, ResidentSuite> resident_suites; // per real path of the directory or packed suite
+
+/**
+ * Identifies the content of a file, or the file names of a directory, by its size and modification time. Returns an
+ * empty string if the path does not exist.
+ */
+static std::string get_file_version(const std::string &path, std::string &real_path)
+{
+  char resolved_path[PATH_MAX];
+  struct stat file_stat{};
+  if ( !realpath(path.c_str(), resolved_path) || stat(resolved_path, &file_stat) != 0 ) return "";
+  real_path = resolved_path;
+  return std::to_string(file_stat.st_size) + " " + std::to_string(file_stat.st_mtim.tv_sec) + "." + std::to_string(file_stat.st_mtim.tv_nsec);
+}
+
+static Sanitizer load_sanitizer(const std::string &config_path)
+{
+  std::string real_path;
+  const std::string version = get_file_version(config_path, real_path);
+  const auto resident = resident_sanitizers.find(real_path);
+  if ( !version.empty() && resident != resident_sanitizers.end() && resident->second.version == version )
   {
-    const std::shared_ptr<SpatialTestCaseInformation> spatial_ptr = std::dynamic_pointer_cast<SpatialTestCaseInformation>(test_case_information);
-    assert(spatial_ptr);
-    if (is_baseline) spatial_baseline_results[spatial_ptr].push_back(result);
-    else spatial_results[spatial_ptr].push_back(result);
+    return resident->second.sanitizer;
   }
-  return can_stop;
+  return Sanitizer(config_path);
 }
 
-static bool collect_validation_result(const std::shared_ptr<TestCaseInformation> &test_case_information, exec_result_t result, const std::string &file_name)
+static std::string get_suite_path(const EvaluationOptions &options)
 {
-  bool valid = false;
-  Logger(log_level_t::VERBOSE) << "Validation result for " << test_case_information->to_string() << " (" << file_name << "): ";
-  switch (result)
+  return options.packed_suite_path.empty() ? options.test_cases_dir_path : options.packed_suite_path;
+}
+
+/**
+ * All test cases of options, before selection.
+ */
+static std::vector<std::shared_ptr<TestCaseInformation>> load_test_cases(const EvaluationOptions &options)
+{
+  std::vector<std::shared_ptr<TestCaseInformation>> test_cases;
+  if ( options.generated_test_cases )
   {
-    case PRECONDITIONS_FAILED:
-      Logger(log_level_t::VERBOSE) << "PRECONDITIONS_FAILED\n";
-      break;
-    case FAILED:
-      Logger(log_level_t::VERBOSE) << "FAILED\n";
-      break;
-    case FAILED_SIGSEGV:
-      Logger(log_level_t::VERBOSE) << "FAILED_SIGSEGV\n";
-      break;
-    case TIMEOUT:
-      Logger(log_level_t::VERBOSE) << "TIMEOUT\n";
-      break;
-    case SUCCESSFUL:
-      Logger(log_level_t::VERBOSE) << "SUCCESSFUL\n";
-      valid = true;
-      break;
-    default:
-      break;
+    return get_test_cases_from_generated(*options.generated_test_cases);
   }
 
-  if (valid)
+  std::string real_path;
+  const std::string version = get_file_version(get_suite_path(options), real_path);
+  const auto resident = resident_suites.find(real_path);
+  if ( !version.empty() && resident != resident_suites.end() && resident->second.version == version )
   {
-    return false; // continue validating
+    return resident->second.test_cases;
   }
+  if ( !options.packed_suite_path.empty() )
+  {
+    return get_test_cases_from_packed_suite(options.packed_suite_path);
+  }
+  for ( const auto& file_path : get_sources_from_dir(options.test_cases_dir_path) )
+  {
+    test_cases.push_back( TestCaseInformation::construct_from_file_name(file_path.name, file_path.path, /*is_binary=*/false) );
+  }
+  return test_cases;
+}
+
+static std::vector<std::shared_ptr<TestCaseInformation>> get_test_cases(const EvaluationOptions &options)
+{
+  std::vector<std::shared_ptr<TestCaseInformation>> test_cases = load_test_cases(options);
+
+  test_cases.erase(std::remove_if(test_cases.begin(), test_cases.end(), [&options](const std::shared_ptr<TestCaseInformation> &test_case_information) {
+    return !is_selected(options, test_case_information);
+  }), test_cases.end());
+  return test_cases;
+}
 
+/**
+ * Compiles a test case. Sources held in memory are piped to the compiler when running in memory,
+ * otherwise they are written next to the binary for the duration of the compilation.
+ */
+static bool compile_test_case(const Sanitizer &sanitizer, const std::shared_ptr<TestCaseInformation> &test_case_info,
+  const std::string &binary_path, bool is_baseline, bool in_memory)
+{
+  if ( !test_case_info->has_source_in_memory() )
+  {
+    if ( is_baseline ) return sanitizer.compile_baseline(test_case_info->get_file_path(), binary_path);
+    return sanitizer.compile(test_case_info->get_file_path(), binary_path);
+  }
 
-  const std::shared_ptr<TemporalTestCaseInformation> temporal_ptr = std::dynamic_pointer_cast<TemporalTestCaseInformation>(test_case_information);
-  if ( temporal_ptr )
+  if ( in_memory )
   {
-    temporal_results[temporal_ptr].push_back(INVALID);
+    if ( is_baseline ) return sanitizer.compile_baseline_from_memory(test_case_info->get_source(), test_case_info->get_source_length(), binary_path);
+    return sanitizer.compile_from_memory(test_case_info->get_source(), test_case_info->get_source_length(), binary_path);
   }
-  else
+
+  std::string source_path = binary_path + ".c";
+  FILE *source_file = fopen(source_path.c_str(), "w");
+  if ( !source_file
+    || fwrite(test_case_info->get_source(), 1, test_case_info->get_source_length(), source_file) != test_case_info->get_source_length() )
   {
-    const std::shared_ptr<SpatialTestCaseInformation> spatial_ptr = std::dynamic_pointer_cast<SpatialTestCaseInformation>(test_case_information);
-    assert(spatial_ptr);
-    spatial_results[spatial_ptr].push_back(INVALID);
+    std::cerr << "Error writing source file " << source_path << ": " << strerror(errno) << '\n';
+    exit(EXIT_FAILURE);
   }
-  return true;
+  fclose(source_file);
+  bool compiled = is_baseline ? sanitizer.compile_baseline(source_path, binary_path) : sanitizer.compile(source_path, binary_path);
+  remove(source_path.c_str());
+  return compiled;
 }
 
-static exec_result_t compute_overall_result( const std::vector<exec_result_t> &results )
+static std::string describe_source(const std::shared_ptr<TestCaseInformation> &test_case_info)
 {
-  exec_result_t overall_result;
-  size_t precond_failed = 0;
-  size_t failures = 0;
-  size_t successes = 0;
-  size_t validation_failures = 0;
-  for ( const auto result: results )
+  if ( test_case_info->has_source_in_memory() ) return test_case_info->get_file_name();
+  return test_case_info->get_file_path();
+}
+
+/**
+ * Directory for binaries that are removed right after their execution. With in_memory, a tmpfs scratch directory is
+ * used if available, so that the binaries never reach the disk.
+ */
+static std::string get_binaries_dir(const EvaluationOptions &options, std::string &scratch_dir)
+{
+  if ( options.in_memory && !options.keep_binaries )
   {
-    if ( result == INVALID ) validation_failures++;
-    else if ( result == PRECONDITIONS_FAILED ) precond_failed++;
-    else if ( result == SUCCESSFUL || result == TIMEOUT ) successes++;
-    else failures++;
+    char scratch_template[] = "/dev/shm/mset-XXXXXX";
+    if ( mkdtemp(scratch_template) )
+    {
+      scratch_dir = scratch_template;
+      return scratch_dir;
+    }
+    std::cerr << "WARNING: cannot create a scratch directory in /dev/shm: " << strerror(errno) << ". Using " << TEST_CASE_BINARIES_DIR_NAME << ".\n";
   }
-  (void)precond_failed;
-  if ( validation_failures > 0 )
-  { // if any variant is invalid
-    overall_result = INVALID;
+  std::string dir_path = options.test_cases_dir_path;
+  if (dir_path.back() != '/')
+  {
+    dir_path += "/";
   }
-  else if ( successes > 0 )
-  { // if any variant is successful
-    overall_result = SUCCESSFUL;
+  return dir_path + TEST_CASE_BINARIES_DIR_NAME;
+}
+
+/**
+ * Compact test cases include the shared prelude. If any of test_cases does, it is written into a directory of its own,
+ * to be added to the include path of the sanitizers, so that piped sources and sources compiled from a temporary file
+ * find it as well. Returns the prelude, to be kept until the compilations are done, or nullptr if none includes it.
+ */
+static std::unique_ptr<Prelude> provide_prelude(const std::vector<std::shared_ptr<TestCaseInformation>> &test_cases)
+{
+  if ( std::none_of(test_cases.begin(), test_cases.end(), [](const std::shared_ptr<TestCaseInformation> &test_case_info) {
+    return Prelude::is_included(*test_case_info);
+  }) )
+  {
+    return nullptr;
   }
-  else if ( failures > 0 )
+  std::string error;
+  std::unique_ptr<Prelude> prelude = Prelude::write(error);
+  if ( !prelude )
   {
-    overall_result = FAILED;
+    std::cerr << error;
+    exit(EXIT_FAILURE);
   }
-  else
-  { // only if all variants have failing preconditions
-    overall_result = PRECONDITIONS_FAILED;
+  return prelude;
+}
+
+static std::mutex output_mutex; // serializes the output and the collected results of concurrent jobs
+
+/**
+ * Prints a message at once, so that the output of concurrent jobs does not interleave.
+ */
+static void print_message(log_level_t log_level, const std::string &message)
+{
+  std::lock_guard<std::mutex> lock(output_mutex);
+  Logger(log_level) << message;
+}
+
+/**
+ * Logs the result of a variant and adds it to results (see ResultStore::add_variant()). Returns whether the following
+ * variants of the test case can be skipped.
+ */
+static bool collect_result(ResultStore &results, const std::shared_ptr<TestCaseInformation> &test_case_information, exec_result_t result, const std::string &file_name, bool is_baseline)
+{
+  std::ostringstream message;
+  if (is_baseline) message << "Baseline result for ";
+  else if (test_case_information->get_is_validation()) message << "Validation result for ";
+  else message << "Result for ";
+  message << test_case_information->to_string() << " (" << file_name << ", "
+    << make_test_case_id(*test_case_information) << "): ";
+
+  switch (result)
+  {
+    case PRECONDITIONS_FAILED:
+      message << "PRECONDITIONS_FAILED\n";
+      break;
+    case FAILED:
+      message << "FAILED\n";
+      break;
+    case FAILED_SIGSEGV:
+      message << "FAILED_SIGSEGV\n";
+      break;
+    case TIMEOUT:
+      message << "TIMEOUT\n";
+      break;
+    case SUCCESSFUL:
+      message << "SUCCESSFUL\n";
+      break;
+    case COMPILE_FAILED:
+      message << "COMPILE_FAILED\n";
+      break;
+    case RESOURCE_EXHAUSTED:
+      message << "RESOURCE_EXHAUSTED\n";
+      break;
+    default:
+      break;
   }
 
-  return overall_result;
+  std::lock_guard<std::mutex> lock(output_mutex);
+  Logger(log_level_t::VERBOSE) << message.str();
+  return results.add_variant(*test_case_information, result, is_baseline);
+}
+
+/**
+ * Prints an error at once, so that it does not interleave with the output of concurrent jobs.
+ */
+static void print_error(const std::string &message)
+{
+  std::lock_guard<std::mutex> lock(output_mutex);
+  Logger::flush(); // after the messages logged before it
+  std::cerr << message;
 }
 
 static void print_overall_result(exec_result_t overall_result, const std::string& test_info_string)
@@ -263,87 +455,36 @@ static void print_overall_result_with_baseline(exec_result_t overall_result, exe
   Logger(log_level_t::NORMAL) << "For " << test_info_string << ", the overall result is " << exec_result_to_string(overall_result) << " (Baseline: " << exec_result_to_string(overall_baseline_result) << ").\n";
 }
 
-static void collapse_results(bool compute_baseline)
+static std::string get_test_case_key(const ResultStore &results, size_t row)
 {
-  for ( auto key_val: temporal_results )
-  {
-    std::shared_ptr<TemporalTestCaseInformation> compressed_result_info = std::dynamic_pointer_cast<TemporalTestCaseInformation>(std::get<0>(key_val));
-    std::vector<exec_result_t> results = std::get<1>(key_val);
-
-    exec_result_t overall_result = compute_overall_result( results );
-
-    raw_temporal_results[compressed_result_info->temporal_bug_name].push_back(overall_result);
-    raw_temporal_results[compressed_result_info->temporal_memory_state_name].push_back(overall_result);
-    raw_temporal_results[compressed_result_info->region_name].push_back(overall_result);
-    raw_temporal_results[compressed_result_info->access_location_name].push_back(overall_result);
-    raw_temporal_results[compressed_result_info->access_action_name].push_back(overall_result);
-    raw_temporal_results["all"].push_back(overall_result);
-    raw_overall_results.push_back(overall_result);
-
-    if ( compute_baseline )
-    {
-      assert(temporal_baseline_results.find(compressed_result_info) != temporal_baseline_results.end());
-      std::vector<exec_result_t> baseline_results = temporal_baseline_results.at(compressed_result_info);
-
-      exec_result_t overall_baseline_result = compute_overall_result( baseline_results );
-
-      raw_temporal_baseline_results[compressed_result_info->temporal_bug_name].push_back(overall_baseline_result);
-      raw_temporal_baseline_results[compressed_result_info->temporal_memory_state_name].push_back(overall_baseline_result);
-      raw_temporal_baseline_results[compressed_result_info->region_name].push_back(overall_baseline_result);
-      raw_temporal_baseline_results[compressed_result_info->access_location_name].push_back(overall_baseline_result);
-      raw_temporal_baseline_results[compressed_result_info->access_action_name].push_back(overall_baseline_result);
-      raw_temporal_baseline_results["all"].push_back(overall_baseline_result);
-      raw_overall_baseline_results.push_back(overall_baseline_result);
+  return TestCaseInformation::construct_from_dimension_ids(
+    results.get_dimension_ids(row), false, 0, "", results.get_origin_size(row), results.get_target_size(row)
+  )->get_test_case_key();
+}
 
-      print_overall_result_with_baseline(overall_result, overall_baseline_result, compressed_result_info->get_test_case_key());
+static void collapse_results(ResultStore &results, bool compute_baseline)
+{
+  results.collapse();
 
-    }
-    else
-    {
-      print_overall_result(overall_result, compressed_result_info->get_test_case_key());
-    }
+  // temporal test cases first, each kind sorted by key
+  std::vector<std::tuple<bool, std::string, size_t>> ordered_rows;
+  for ( size_t row = 0; row < results.size(); row++ )
+  {
+    ordered_rows.emplace_back(!results.is_temporal(row), get_test_case_key(results, row), row);
   }
+  std::sort(ordered_rows.begin(), ordered_rows.end());
 
-
-  for ( auto key_val: spatial_results )
+  for ( const auto &ordered_row: ordered_rows )
   {
-    std::shared_ptr<SpatialTestCaseInformation> compressed_result_info = std::get<0>(key_val);
-    std::vector<exec_result_t> results = std::get<1>(key_val);
-
-    exec_result_t overall_result = compute_overall_result( results );
-
-    raw_spatial_results["origin " + compressed_result_info->origin_name].push_back(overall_result);
-    raw_spatial_results["target " + compressed_result_info->target_name].push_back(overall_result);
-    raw_spatial_results[compressed_result_info->origin_target_relation_name].push_back(overall_result);
-    raw_spatial_results[compressed_result_info->flow_name].push_back(overall_result);
-    raw_spatial_results[compressed_result_info->spatial_bug_name].push_back(overall_result);
-    raw_spatial_results[compressed_result_info->access_location_name].push_back(overall_result);
-    raw_spatial_results[compressed_result_info->access_action_name].push_back(overall_result);
-    raw_spatial_results["all"].push_back(overall_result);
-    raw_overall_results.push_back(overall_result);
-
+    const size_t row = std::get<2>(ordered_row);
     if ( compute_baseline )
     {
-      assert(spatial_baseline_results.find(compressed_result_info) != spatial_baseline_results.end());
-      std::vector<exec_result_t> baseline_results = spatial_baseline_results.at(compressed_result_info);
-
-      exec_result_t overall_baseline_result = compute_overall_result( baseline_results );
-
-      raw_spatial_baseline_results["origin " + compressed_result_info->origin_name].push_back(overall_baseline_result);
-      raw_spatial_baseline_results["target " + compressed_result_info->target_name].push_back(overall_baseline_result);
-      raw_spatial_baseline_results[compressed_result_info->origin_target_relation_name].push_back(overall_baseline_result);
-      raw_spatial_baseline_results[compressed_result_info->flow_name].push_back(overall_baseline_result);
-      raw_spatial_baseline_results[compressed_result_info->spatial_bug_name].push_back(overall_baseline_result);
-      raw_spatial_baseline_results[compressed_result_info->access_location_name].push_back(overall_baseline_result);
-      raw_spatial_baseline_results[compressed_result_info->access_action_name].push_back(overall_baseline_result);
-      raw_spatial_baseline_results["all"].push_back(overall_baseline_result);
-      print_overall_result_with_baseline(overall_result, overall_baseline_result, compressed_result_info->get_test_case_key());
-
-      raw_overall_baseline_results.push_back(overall_baseline_result);
+      assert(results.has_baseline_results(row));
+      print_overall_result_with_baseline(results.get_overall_result(row), results.get_overall_baseline_result(row), std::get<1>(ordered_row));
     }
     else
     {
-      print_overall_result(overall_result, compressed_result_info->get_test_case_key());
+      print_overall_result(results.get_overall_result(row), std::get<1>(ordered_row));
     }
   }
 }
@@ -357,36 +498,14 @@ std::string score_to_str(const double value)
   return percentage.str() + "%";
 }
 
-struct counters_t
-{
-  size_t precond_failed = 0;
-  size_t failures = 0;
-  size_t successes = 0;
-  size_t invalids = 0;
-};
-
-counters_t compute_counters(const std::vector<exec_result_t> &raw_results)
-{
-  counters_t counters;
-  for ( auto result: raw_results )
-  {
-    if ( result == INVALID ) counters.invalids++;
-    else if ( result == PRECONDITIONS_FAILED ) counters.precond_failed++;
-    else if ( result == SUCCESSFUL || result == TIMEOUT ) counters.successes++;
-    else counters.failures++;
-  }
-  return counters;
-}
-
-
-static void print_results(const std::vector<exec_result_t> &raw_results, const std::vector<exec_result_t> &baseline_results, const log_level_t log_level)
+static void print_results(const counters_t &counters, const counters_t &baseline_counters, const log_level_t log_level)
 {
   std::string overall_detection_rate;
   std::string precond_failed_percentage;
   std::string failures_percentage;
   std::string successes_percentage;
-  counters_t counters = compute_counters(raw_results);
-  if ( raw_results.empty() )
+  const size_t total = counters.total();
+  if ( total == 0 )
   {
     overall_detection_rate = "N/A";
     precond_failed_percentage = "N/A";
@@ -395,40 +514,29 @@ static void print_results(const std::vector<exec_result_t> &raw_results, const s
   }
   else
   {
-    overall_detection_rate = score_to_str( (static_cast<double>(counters.precond_failed + counters.failures) * 100) / static_cast<double>(raw_results.size()) );
-    precond_failed_percentage = score_to_str( (static_cast<double>(counters.precond_failed) * 100) / static_cast<double>(raw_results.size()) );
-    failures_percentage = score_to_str( (static_cast<double>(counters.failures) * 100) / static_cast<double>(raw_results.size()) );
-    successes_percentage = score_to_str( (static_cast<double>(counters.successes + counters.invalids) * 100) / static_cast<double>(raw_results.size()) );
+    overall_detection_rate = score_to_str( (static_cast<double>(counters.precond_failed + counters.failures) * 100) / static_cast<double>(total) );
+    precond_failed_percentage = score_to_str( (static_cast<double>(counters.precond_failed) * 100) / static_cast<double>(total) );
+    failures_percentage = score_to_str( (static_cast<double>(counters.failures) * 100) / static_cast<double>(total) );
+    successes_percentage = score_to_str( (static_cast<double>(counters.successes + counters.invalids) * 100) / static_cast<double>(total) );
   }
 
-  bool with_baseline = !baseline_results.empty();
+  const size_t baseline_total = baseline_counters.total();
+  bool with_baseline = baseline_total > 0;
 
   std::string overall_baseline_detection_rate;
   std::string precond_failed_baseline_percentage;
   std::string failures_baseline_percentage;
   std::string successes_baseline_percentage;
-  counters_t baseline_counters;
 
   if (with_baseline)
   {
-    baseline_counters = compute_counters(baseline_results);
-    if ( baseline_results.empty() )
-    {
-      overall_baseline_detection_rate = "N/A";
-      precond_failed_baseline_percentage = "N/A";
-      failures_baseline_percentage = "N/A";
-      successes_baseline_percentage = "N/A";
-    }
-    else
-    {
-      overall_baseline_detection_rate = score_to_str( (static_cast<double>(baseline_counters.precond_failed + baseline_counters.failures) * 100) / static_cast<double>(baseline_results.size()) );
-      precond_failed_baseline_percentage = score_to_str( (static_cast<double>(baseline_counters.precond_failed) * 100) / static_cast<double>(baseline_results.size()) );
-      failures_baseline_percentage = score_to_str( (static_cast<double>(baseline_counters.failures) * 100) / static_cast<double>(baseline_results.size()) );
-      successes_baseline_percentage = score_to_str( (static_cast<double>(baseline_counters.successes + baseline_counters.invalids) * 100) / static_cast<double>(baseline_results.size()) );
-    }
+    overall_baseline_detection_rate = score_to_str( (static_cast<double>(baseline_counters.precond_failed + baseline_counters.failures) * 100) / static_cast<double>(baseline_total) );
+    precond_failed_baseline_percentage = score_to_str( (static_cast<double>(baseline_counters.precond_failed) * 100) / static_cast<double>(baseline_total) );
+    failures_baseline_percentage = score_to_str( (static_cast<double>(baseline_counters.failures) * 100) / static_cast<double>(baseline_total) );
+    successes_baseline_percentage = score_to_str( (static_cast<double>(baseline_counters.successes + baseline_counters.invalids) * 100) / static_cast<double>(baseline_total) );
   }
 
-  Logger(log_level) << "Detection rate: " << overall_detection_rate << " (" << counters.precond_failed + counters.failures << " out of " << raw_results.size() << " test cases)";
+  Logger(log_level) << "Detection rate: " << overall_detection_rate << " (" << counters.precond_failed + counters.failures << " out of " << total << " test cases)";
   if (with_baseline) Logger(log_level) << " / Baseline: " << overall_baseline_detection_rate;
   Logger(log_level) << "\n";
   Logger(log_level) << "Results for test cases:\n";
@@ -453,279 +561,1533 @@ static void print_results(const std::vector<exec_result_t> &raw_results, const s
     if (with_baseline) Logger(log_level) << " / Baseline: " << successes_baseline_percentage;
     Logger(log_level) << "\n";
   }
+
+  if ( counters.compile_failures > 0 || baseline_counters.compile_failures > 0 )
+  {
+    // test cases none of whose variants compiled are neither detected nor missed
+    Logger(log_level) << "- Compile failures: " << (total == 0 ? "N/A" : score_to_str( (static_cast<double>(counters.compile_failures) * 100) / static_cast<double>(total) ))
+      << " (" << counters.compile_failures << ")";
+    if (with_baseline) Logger(log_level) << " / Baseline: " << score_to_str( (static_cast<double>(baseline_counters.compile_failures) * 100) / static_cast<double>(baseline_total) );
+    Logger(log_level) << "\n";
+  }
+
+  if ( counters.resource_exhaustions > 0 || baseline_counters.resource_exhaustions > 0 )
+  {
+    // test cases that ran out of memory or CPU time are neither detected nor missed either
+    Logger(log_level) << "- Resource exhausted: " << (total == 0 ? "N/A" : score_to_str( (static_cast<double>(counters.resource_exhaustions) * 100) / static_cast<double>(total) ))
+      << " (" << counters.resource_exhaustions << ")";
+    if (with_baseline) Logger(log_level) << " / Baseline: " << score_to_str( (static_cast<double>(baseline_counters.resource_exhaustions) * 100) / static_cast<double>(baseline_total) );
+    Logger(log_level) << "\n";
+  }
+}
+
+/**
+ * Prints the results per primitive of one dimension (file name order of kind).
+ */
+static void print_distribution(const ResultStore &results, test_case_kind_t kind, size_t dimension, const std::string &dimension_name)
+{
+  Logger(log_level_t::VERBOSE) << "Bug detection distribution per " << dimension_name << ":\n";
+  const std::vector<counters_t> counters = results.count(kind, {dimension}, /*baseline=*/false);
+  const std::vector<counters_t> baseline_counters = results.count(kind, {dimension}, /*baseline=*/true);
+  const PrimitiveDimension &names = TestCaseInformation::get_dimension_names(kind == TEMPORAL_KIND, dimension);
+  for ( size_t id = 0; id < names.size(); id++ )
+  {
+    Logger(log_level_t::VERBOSE) << names[id].printable_name << ":\n";
+    print_results(counters[id], baseline_counters[id], log_level_t::VERBOSE);
+  }
+}
+
+static size_t count_prevented(const counters_t &counters)
+{
+  return counters.precond_failed + counters.failures;
 }
 
-static void process_results(bool print_table_summary, bool with_baseline)
+static void process_results(const ResultStore &results, bool print_table_summary, bool with_baseline)
 {
   Logger(log_level_t::VERBOSE) << "==============================\n\n";
 
   Logger(log_level_t::VERBOSE) << "Temporal bugs:\n";
-  print_results(raw_temporal_results["all"], raw_temporal_baseline_results["all"], log_level_t::VERBOSE);
+  print_results(results.count(TEMPORAL_KIND, {}, false)[0], results.count(TEMPORAL_KIND, {}, true)[0], log_level_t::VERBOSE);
+
+  print_distribution(results, TEMPORAL_KIND, 0, "bug type");
+  print_distribution(results, TEMPORAL_KIND, 2, "region");
+  print_distribution(results, TEMPORAL_KIND, 1, "memory state");
+  print_distribution(results, TEMPORAL_KIND, 3, "access type location");
+  print_distribution(results, TEMPORAL_KIND, 4, "access type action");
 
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per bug type:\n";
-  for ( const auto& info: temporal_bugs_info )
+  Logger(log_level_t::VERBOSE) << "==============================\n\n";
+  Logger(log_level_t::VERBOSE) << "Spatial bugs:\n";
+  print_results(results.count(SPATIAL_KIND, {}, false)[0], results.count(SPATIAL_KIND, {}, true)[0], log_level_t::VERBOSE);
+
+  print_distribution(results, SPATIAL_KIND, 0, "bug type");
+  print_distribution(results, SPATIAL_KIND, 1, "origin");
+  print_distribution(results, SPATIAL_KIND, 2, "target");
+  print_distribution(results, SPATIAL_KIND, 3, "origin-target relation");
+  print_distribution(results, SPATIAL_KIND, 4, "flow");
+  print_distribution(results, SPATIAL_KIND, 5, "access type location");
+  print_distribution(results, SPATIAL_KIND, 6, "access type action");
+
+  const std::vector<counters_t> size_counters = results.count_by_object_sizes(/*baseline=*/false);
+  const std::vector<counters_t> size_baseline_counters = results.count_by_object_sizes(/*baseline=*/true);
+  std::vector<size_t> size_indexes; // object sizes present in the spatial results, in ascending order
+  for ( size_t i = 0; i < size_counters.size(); i++ )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_temporal_results[info], raw_temporal_baseline_results[info], log_level_t::VERBOSE);
+    if ( size_counters[i].total() > 0 ) size_indexes.push_back(i);
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per region:\n";
-  for ( const auto& info: regions_info )
+  const std::vector<std::pair<size_t, size_t>> &object_sizes = results.get_object_sizes();
+  std::sort(size_indexes.begin(), size_indexes.end(), [&object_sizes](size_t lhs, size_t rhs) { return object_sizes[lhs] < object_sizes[rhs]; });
+  if ( size_indexes.size() > 1 ) // only when generated with a generation profile
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_temporal_results[info], raw_temporal_baseline_results[info], log_level_t::VERBOSE);
+    Logger(log_level_t::VERBOSE) << "Bug detection distribution per object size (origin x target):\n";
+    for ( const size_t i: size_indexes )
+    {
+      Logger(log_level_t::VERBOSE) << object_sizes[i].first << "x" << object_sizes[i].second << ":\n";
+      print_results(size_counters[i], size_baseline_counters[i], log_level_t::VERBOSE);
+    }
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per memory state:\n";
-  for ( const auto& info: temporal_memory_states_info )
+
+  Logger(log_level_t::VERBOSE) << "==============================\n\n";
+  Logger(log_level_t::NORMAL) << "Overall results:\n";
+  print_results(results.count_all(false), results.count_all(true), log_level_t::NORMAL);
+
+  if (print_table_summary)
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_temporal_results[info], raw_temporal_baseline_results[info], log_level_t::VERBOSE);
+    std::ostringstream summary;
+    summary << "Prevented summary:\n";
+    summary << std::left << std::setw(12) << "Linear OOBA" << "| " << std::setw(16) << "Non-Linear OOBA " << "| " <<
+      std::setw(20) << "Type Confusion OOBA" << "| " << std::setw(12) << "Use-after-*" << "| " <<
+      std::setw(12) << "Double-free" << "| " << std::setw(14) << "Misuse-of-free\n";
+    for ( const bool baseline: {false, true} )
+    {
+      if ( baseline && !with_baseline ) break;
+      const std::vector<counters_t> spatial_counters = results.count(SPATIAL_KIND, {0}, baseline);
+      const std::vector<counters_t> temporal_counters = results.count(TEMPORAL_KIND, {0}, baseline);
+      summary << std::left << std::setw(12) << count_prevented(spatial_counters[static_cast<size_t>(spatial_bug_id_t::LINEAR_OOBA)]) << "| ";
+      summary << std::setw(16) << count_prevented(spatial_counters[static_cast<size_t>(spatial_bug_id_t::NON_LINEAR_OOBA)]) << "| ";
+      summary << std::setw(20) << count_prevented(spatial_counters[static_cast<size_t>(spatial_bug_id_t::TYPE_CONFUSION_OOBA)]) << "| ";
+      summary << std::setw(12) << count_prevented(temporal_counters[static_cast<size_t>(temporal_bug_id_t::USE_AFTER_STAR)]) << "| ";
+      summary << std::setw(12) << count_prevented(temporal_counters[static_cast<size_t>(temporal_bug_id_t::DOUBLE_FREE)]) << "| ";
+      summary << std::setw(14) << count_prevented(temporal_counters[static_cast<size_t>(temporal_bug_id_t::MISUSE_OF_FREE)]) << (baseline ? "  (baseline)\n" : "\n");
+    }
+    Logger(log_level_t::NORMAL) << summary.str();
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per access type location:\n";
-  for ( const auto& info: access_locations_info )
+}
+
+/**
+ * Results of one sanitizer, as reported at the end of an evaluation and written by save_results().
+ */
+struct SanitizerResults
+{
+  std::string sanitizer_name;
+  ResultStore store;
+  size_t test_case_counter = 0;
+  size_t variant_eval_counter = 0;
+};
+
+static const char RESULTS_FILE_MAGIC[] = "mset_results";
+static const int RESULTS_FILE_VERSION = 1;
+
+/**
+ * Writes the results of all sanitizers, so that the results of several shards can be combined by merge_results():
+ *   mset_results 1
+ *   baseline yes|no
+ *   sanitizers <count>
+ * followed by, for each sanitizer:
+ *   sanitizer <name>
+ *   test_cases <count>
+ *   variants <count>
+ *   rows <count>
+ *   <rows, see ResultStore::write()>
+ */
+static void save_results(const std::string &path, const std::vector<std::shared_ptr<SanitizerResults>> &all_results, bool with_baseline)
+{
+  std::ofstream file(path);
+  file << RESULTS_FILE_MAGIC << " " << RESULTS_FILE_VERSION << "\n";
+  file << "baseline " << (with_baseline ? "yes" : "no") << "\n";
+  file << "sanitizers " << all_results.size() << "\n";
+  for ( const auto &results: all_results )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_temporal_results[info], raw_temporal_baseline_results[info], log_level_t::VERBOSE);
+    file << "sanitizer " << results->sanitizer_name << "\n";
+    file << "test_cases " << results->test_case_counter << "\n";
+    file << "variants " << results->variant_eval_counter << "\n";
+    file << "rows " << results->store.size() << "\n";
+    results->store.write(file);
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per access type action:\n";
-  for ( const auto& info: access_actions_info )
+  file.close();
+  if ( !file )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_temporal_results[info], raw_temporal_baseline_results[info], log_level_t::VERBOSE);
+    std::cerr << "Error writing file: " << path << ": " << std::strerror(errno) << std::endl;
+    exit(EXIT_FAILURE);
   }
+}
 
-  Logger(log_level_t::VERBOSE) << "==============================\n\n";
-  Logger(log_level_t::VERBOSE) << "Spatial bugs:\n";
-  print_results(raw_spatial_results["all"], raw_spatial_baseline_results["all"], log_level_t::VERBOSE);
+static void invalid_results_file(const std::string &path, const std::string &reason)
+{
+  std::cerr << "ERROR: invalid results file " << path << ": " << reason << ". Aborting.\n";
+  exit(EXIT_FAILURE);
+}
 
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per bug type:\n";
-  for ( const auto& info: spatial_bugs_info )
+static std::string read_field(std::istream &in, const std::string &path, const std::string &name)
+{
+  std::string line;
+  std::getline(in >> std::ws, line);
+  if ( line.compare(0, name.size() + 1, name + " ") != 0 )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_spatial_results[info], raw_spatial_baseline_results[info], log_level_t::VERBOSE);
+    invalid_results_file(path, "expected " + name);
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per origin:\n";
-  for ( const auto& info: regions_info )
+  return line.substr(name.size() + 1);
+}
+
+static size_t read_count(std::istream &in, const std::string &path, const std::string &name)
+{
+  const std::string value = read_field(in, path, name);
+  if ( value.empty() || value.find_first_not_of("0123456789") != std::string::npos )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_spatial_results["origin " + info], raw_spatial_baseline_results["origin " + info], log_level_t::VERBOSE);
+    invalid_results_file(path, "expected a number after " + name);
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per target:\n";
-  for ( const auto& info: regions_info )
+  return static_cast<size_t>(std::stoull(value));
+}
+
+/**
+ * Adds the results written by save_results() to all_results, matching sanitizers by name.
+ * Returns whether the file contains baseline results.
+ */
+static bool load_results(const std::string &path, std::vector<std::shared_ptr<SanitizerResults>> &all_results)
+{
+  std::ifstream file(path);
+  if ( !file )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_spatial_results["target " + info], raw_spatial_baseline_results["target " + info], log_level_t::VERBOSE);
+    std::cerr << "Error reading file: " << path << ": " << std::strerror(errno) << std::endl;
+    exit(EXIT_FAILURE);
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per origin-target relation:\n";
-  for ( const auto& info: origin_target_relations_info )
+  if ( read_field(file, path, RESULTS_FILE_MAGIC) != std::to_string(RESULTS_FILE_VERSION) )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_spatial_results[info], raw_spatial_baseline_results[info], log_level_t::VERBOSE);
+    invalid_results_file(path, "unsupported version");
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per flow:\n";
-  for ( const auto& info: flows_info )
+  const bool with_baseline = read_field(file, path, "baseline") == "yes";
+  const size_t sanitizer_count = read_count(file, path, "sanitizers");
+  const bool is_first = all_results.empty();
+  if ( !is_first && sanitizer_count != all_results.size() )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_spatial_results[info], raw_spatial_baseline_results[info], log_level_t::VERBOSE);
+    invalid_results_file(path, "other sanitizers than in the previous files");
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per access type location:\n";
-  for ( const auto& info: access_locations_info )
+  for ( size_t i = 0; i < sanitizer_count; i++ )
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_spatial_results[info], raw_spatial_baseline_results[info], log_level_t::VERBOSE);
+    const std::string sanitizer_name = read_field(file, path, "sanitizer");
+    if ( is_first )
+    {
+      all_results.push_back(std::make_shared<SanitizerResults>());
+      all_results.back()->sanitizer_name = sanitizer_name;
+    }
+    else if ( all_results[i]->sanitizer_name != sanitizer_name )
+    {
+      invalid_results_file(path, "other sanitizers than in the previous files");
+    }
+    SanitizerResults &results = *all_results[i];
+    results.test_case_counter += read_count(file, path, "test_cases");
+    results.variant_eval_counter += read_count(file, path, "variants");
+    const size_t row_count = read_count(file, path, "rows");
+    if ( !results.store.read(file, row_count) )
+    {
+      invalid_results_file(path, "malformed row or test case also in another file");
+    }
   }
-  Logger(log_level_t::VERBOSE) << "Bug detection distribution per access type action:\n";
-  for ( const auto& info: access_actions_info )
+  return with_baseline;
+}
+
+/**
+ * State of the evaluation of one sanitizer configuration.
+ */
+struct SanitizerRun
+{
+  explicit SanitizerRun(const Sanitizer &sanitizer):
+    sanitizer(sanitizer), results(std::make_shared<SanitizerResults>())
   {
-    Logger(log_level_t::VERBOSE) << info << ":\n";
-    print_results(raw_spatial_results[info], raw_spatial_baseline_results[info], log_level_t::VERBOSE);
+    results->sanitizer_name = sanitizer.get_name();
   }
 
-  Logger(log_level_t::VERBOSE) << "==============================\n\n";
-  Logger(log_level_t::NORMAL) << "Overall results:\n";
-  print_results(raw_overall_results, raw_overall_baseline_results, log_level_t::NORMAL);
+  Sanitizer sanitizer;
+  std::string binaries_dir;
+  std::shared_ptr<SanitizerResults> results;
+  std::atomic<size_t> variant_eval_counter{0};
+};
 
-  if (print_table_summary)
-  {
-    std::cout << "Prevented summary:\n";
-    std::cout << std::left << std::setw(12) << "Linear OOBA" << "| " << std::setw(16) << "Non-Linear OOBA " << "| " <<
-      std::setw(20) << "Type Confusion OOBA" << "| " << std::setw(12) << "Use-after-*" << "| " <<
-      std::setw(12) << "Double-free" << "| " << std::setw(14) << "Misuse-of-free\n";
-    counters_t counters = compute_counters(raw_spatial_results["Linear OOBA"]);
-    std::cout << std::left << std::setw(12) << counters.precond_failed + counters.failures << "| ";
-    counters = compute_counters(raw_spatial_results["Non-Linear OOBA"]);
-    std::cout << std::setw(16) << counters.precond_failed + counters.failures << "| ";
-    counters = compute_counters(raw_spatial_results["Type Confusion OOBA"]);
-    std::cout << std::setw(20) << counters.precond_failed + counters.failures << "| ";
-    counters = compute_counters(raw_temporal_results["Use-after-*"]);
-    std::cout << std::setw(12) << counters.precond_failed + counters.failures << "| ";
-    counters = compute_counters(raw_temporal_results["Double-free"]);
-    std::cout << std::setw(12) << counters.precond_failed + counters.failures << "| ";
-    counters = compute_counters(raw_temporal_results["Misuse-of-free"]);
-    std::cout << std::setw(14) << counters.precond_failed + counters.failures << "\n";
-    if (with_baseline)
-    {
-      counters = compute_counters(raw_spatial_baseline_results["Linear OOBA"]);
-      std::cout << std::left << std::setw(12) << counters.precond_failed + counters.failures << "| ";
-      counters = compute_counters(raw_spatial_baseline_results["Non-Linear OOBA"]);
-      std::cout << std::setw(16) << counters.precond_failed + counters.failures << "| ";
-      counters = compute_counters(raw_spatial_baseline_results["Type Confusion OOBA"]);
-      std::cout << std::setw(20) << counters.precond_failed + counters.failures << "| ";
-      counters = compute_counters(raw_temporal_baseline_results["Use-after-*"]);
-      std::cout << std::setw(12) << counters.precond_failed + counters.failures << "| ";
-      counters = compute_counters(raw_temporal_baseline_results["Double-free"]);
-      std::cout << std::setw(12) << counters.precond_failed + counters.failures << "| ";
-      counters = compute_counters(raw_temporal_baseline_results["Misuse-of-free"]);
-      std::cout << std::setw(14) << counters.precond_failed + counters.failures << "  (baseline)\n";
-    }
-  }
-}
-
-extern void compile_and_evaluate(
-  const std::string &test_cases_dir_path,
-  const std::string &sanitizer_config,
-  bool print_table_summary,
-  bool run_all_variants,
-  bool verbose,
-  bool compute_baseline,
-  bool keep_binaries
-)
-{
-  if (verbose)
-  {
-    Logger::allowed_log_level = log_level_t::VERBOSE;
-  }
-  size_t variant_eval_counter = 0;
-  Sanitizer sanitizer{sanitizer_config};
+static std::unique_ptr<Journal> journal; // set with EvaluationOptions::journal_path
 
-  const std::set<FileInfo> generated_files = get_sources_from_dir(test_cases_dir_path);
+static std::unique_ptr<ResultsExporter> results_exporter; // set with EvaluationOptions::export_path
 
-  if (generated_files.empty())
+static void open_results_exporter(const EvaluationOptions &options)
+{
+  if ( options.export_path.empty() ) return;
+  results_exporter = ResultsExporter::open(options.export_path);
+  if ( !results_exporter )
   {
-    std::cerr << "ERROR: No test files found. Aborting.\n";
     exit(EXIT_FAILURE);
   }
+}
 
-  std::map< std::string, std::vector<std::shared_ptr<TestCaseInformation>> > grouped_test_cases;
-  for (const auto& file_path : generated_files)
-  {
-    std::shared_ptr<TestCaseInformation> test_case_information = TestCaseInformation::construct_from_file_name(file_path.name, file_path.path, /*is_binary=*/false);
-    grouped_test_cases[test_case_information->get_test_case_key()].push_back(test_case_information);
-  }
-  for (auto& grouped_test_case : grouped_test_cases)
-  {
-    std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos = grouped_test_case.second;
-    std::sort(test_case_infos.begin(), test_case_infos.end(), compare_test_case_variants);
-
-    Logger(log_level_t::VERBOSE) << "Evaluating baseline: " << grouped_test_case.first << "\n";
-    if (compute_baseline)
-    {
-      for (const auto& test_case_info : test_case_infos)
-      {
-        if ( test_case_info->get_is_validation() ) continue; // only normal phase for the baseline
+static std::unique_ptr<BuildCache> build_cache; // unless EvaluationOptions::no_dedup
+static std::unordered_map<const TestCaseInformation *, uint64_t> source_hashes; // filled before the jobs run, see plan_builds()
 
-        std::string dir_path = test_cases_dir_path;
-        if (dir_path.back() != '/')
-        {
-          dir_path += "/";
-        }
-        std::string binary_path = dir_path + "/" + TEST_CASE_BINARIES_DIR_NAME + "/" + test_case_info->get_file_name_without_suffix() + "_baseline";
+static std::unique_ptr<DurationHistory> duration_history; // set with EvaluationOptions::durations_path
 
-        if ( !sanitizer.compile_baseline(test_case_info->get_file_path(), binary_path) )
-        {
-          std::cerr << "Failed to compile baseline " << test_case_info->get_file_path() << '\n';
-          std::cerr << "Aborting.\n";
-          exit(EXIT_FAILURE);
-        }
-        exec_result_t result = sanitizer.execute_baseline(binary_path);
+static std::unique_ptr<Metrics> metrics; // instrumentation of compile_and_evaluate(), see --stats
 
-        if (!keep_binaries)
-        {
-          remove(binary_path.c_str());
-        }
+/**
+ * What the executions of a sanitizer cost, the overhead compared by print_sweep_report().
+ */
+struct execution_costs_t
+{
+  size_t executions = 0;
+  double run_seconds = 0;
+  size_t peak_memory_kb = 0;
+};
+
+static std::map<std::string, execution_costs_t> execution_costs; // per sanitizer name, guarded by output_mutex
+
+static void record_execution(const Sanitizer &sanitizer, double run_seconds, size_t peak_memory_kb)
+{
+  std::lock_guard<std::mutex> lock(output_mutex);
+  execution_costs_t &costs = execution_costs[sanitizer.get_name()];
+  costs.executions++;
+  costs.run_seconds += run_seconds;
+  costs.peak_memory_kb = std::max(costs.peak_memory_kb, peak_memory_kb);
+}
+
+// per test case ID, of the sanitizers per name and of the baseline, guarded by output_mutex; see EvaluationOptions::measure_footprint
+static std::map<std::string, std::map<std::string, binary_footprint_t>> footprints;
+static std::map<std::string, binary_footprint_t> baseline_footprints;
+
+/**
+ * Records the footprint of a committed variant; a footprint that could not be read, i.e., of size 0, is skipped.
+ */
+static void record_footprint(const Sanitizer &sanitizer, const TestCaseInformation &test_case_info, const binary_footprint_t &footprint, bool is_baseline)
+{
+  if ( footprint.file_size == 0 ) return;
+  std::lock_guard<std::mutex> lock(output_mutex);
+  (is_baseline ? baseline_footprints : footprints[sanitizer.get_name()])[make_test_case_id(test_case_info)] = footprint;
+}
+
+// per sanitizer name and bug type, of the detected variants, guarded by output_mutex; see EvaluationOptions::measure_latency
+static std::map<std::string, std::map<std::string, std::vector<double>>> detection_latencies;
+static std::atomic<size_t> triggered_executions{0}; // that reported a trigger, detected or not
+
+static void record_detection_latency(const Sanitizer &sanitizer, const TestCaseInformation &test_case_info, double latency_seconds)
+{
+  const std::string &bug_type = TestCaseInformation::get_dimension_names(test_case_info.is_temporal(), 0)[test_case_info.get_dimension_ids()[0]].printable_name;
+  std::lock_guard<std::mutex> lock(output_mutex);
+  detection_latencies[sanitizer.get_name()][bug_type].push_back(latency_seconds);
+}
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint64_t hash_test_case_source(const TestCaseInformation &test_case_info)
+{
+  std::string content;
+  if ( test_case_info.has_source_in_memory() )
+  {
+    content.assign(test_case_info.get_source(), test_case_info.get_source_length());
+  }
+  else
+  {
+    std::ifstream file(test_case_info.get_file_path());
+    std::ostringstream source;
+    source << file.rdbuf();
+    if ( !file )
+    {
+      std::cerr << "Error reading file: " << test_case_info.get_file_path() << ": " << std::strerror(errno) << std::endl;
+      exit(EXIT_FAILURE);
+    }
+    content = source.str();
+  }
+  // the included prelude is part of the build as well, but not of the compile signature, see Sanitizer::add_include_dir()
+  if ( Prelude::is_included(content.data(), content.size()) ) content += CodeCanvas::get_prelude_header();
+  return BuildCache::hash_source(content.data(), content.size());
+}
+
+/**
+ * Announces the builds of a job to the build cache, so that binaries shared with later jobs are kept until then.
+ */
+static void plan_builds(const Sanitizer &sanitizer, const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos, bool is_baseline)
+{
+  if ( !build_cache ) return;
+  const std::string compile_signature = sanitizer.get_compile_signature(is_baseline);
+  for ( const auto &test_case_info: test_case_infos )
+  {
+    if ( is_baseline && test_case_info->get_is_validation() ) continue;
+    auto source_hash = source_hashes.find(test_case_info.get());
+    if ( source_hash == source_hashes.end() )
+    {
+      source_hash = source_hashes.emplace(test_case_info.get(), hash_test_case_source(*test_case_info)).first;
+    }
+    build_cache->plan(build_cache->make_build_key(compile_signature, source_hash->second));
+  }
+}
+
+/**
+ * Compiles and executes a variant. The binary of an identical build is reused if cached and, for deterministic
+ * sanitizers, so is the result of executing an identical binary. If given, stats is set to what the variant cost, and
+ * with options.measure_footprint, footprint to that of the binary, to be recorded once the result is committed.
+ */
+static exec_result_t build_and_execute(const Sanitizer &sanitizer, const std::shared_ptr<TestCaseInformation> &test_case_info,
+  const std::string &binary_path, bool is_baseline, const EvaluationOptions &options, const std::string &label, CancellationToken *cancellation,
+  variant_stats_t *stats = nullptr, binary_footprint_t *footprint = nullptr)
+{
+  if ( cancellation && cancellation->is_cancelled() ) return SUCCESSFUL; // discarded
+  TraceSpan variant_span(is_baseline ? "baseline variant" : "variant", make_test_case_id(*test_case_info), sanitizer.get_name());
+  uint64_t build_key = 0;
+  uint64_t binary_hash = 0;
+  bool has_binary_hash = false;
+  if ( build_cache )
+  {
+    build_key = build_cache->make_build_key(sanitizer.get_compile_signature(is_baseline), source_hashes.at(test_case_info.get()));
+    has_binary_hash = build_cache->link_binary(build_key, binary_path, binary_hash);
+  }
+  const bool reuses_binary = has_binary_hash;
+  double compile_seconds = 0; // stays 0 for reused binaries and results, which is what they cost
+  double run_seconds = 0;
+  if ( !has_binary_hash )
+  {
+    const auto compile_start = std::chrono::steady_clock::now();
+    if ( !compile_test_case(sanitizer, test_case_info, binary_path, is_baseline, options.in_memory) )
+    {
+      print_error(std::string("Failed to compile ") + (is_baseline ? "baseline " : "") + describe_source(test_case_info) + label + "\n");
+      if ( stats ) stats->compile_seconds = seconds_since(compile_start);
+      return COMPILE_FAILED;
+    }
+    compile_seconds = seconds_since(compile_start);
+    if ( metrics ) metrics->get_compile_latencies().add(compile_seconds);
+    if ( build_cache && hash_file(binary_path, binary_hash) )
+    {
+      has_binary_hash = true;
+      build_cache->add_binary(build_key, binary_path, binary_hash);
+    }
+  }
+
+  std::string footprint_error;
+  if ( options.measure_footprint && footprint && !read_binary_footprint(binary_path, *footprint, footprint_error) )
+  {
+    print_error("Failed to read the footprint: " + footprint_error + "\n");
+    *footprint = binary_footprint_t();
+  }
+
+  exec_result_t result;
+  const bool reuses_results = has_binary_hash && sanitizer.is_deterministic();
+  const uint64_t run_key = reuses_results ? build_cache->make_run_key(binary_hash, sanitizer.get_run_signature(is_baseline), sanitizer.get_compile_signature(is_baseline)) : 0;
+  const bool found_result = reuses_results && build_cache->find_result(run_key, result);
+  size_t peak_memory_kb = 0;
+  double latency_seconds = -1;
+  if ( !found_result )
+  {
+    const auto run_start = std::chrono::steady_clock::now();
+    result = is_baseline ? sanitizer.execute_baseline(binary_path, cancellation, &peak_memory_kb)
+      : sanitizer.execute(binary_path, cancellation, &peak_memory_kb, options.measure_latency ? &latency_seconds : nullptr);
+    run_seconds = seconds_since(run_start);
+    const bool is_cancelled = cancellation && cancellation->is_cancelled(); // killed partway, so the costs are cut short
+    if ( metrics && !is_cancelled ) metrics->get_run_latencies().add(run_seconds);
+    if ( !is_baseline && !is_cancelled ) record_execution(sanitizer, run_seconds, peak_memory_kb); // the overhead of the sanitizer alone
+    if ( latency_seconds >= 0 ) triggered_executions++;
+    if ( (result == FAILED || result == FAILED_SIGSEGV) && latency_seconds >= 0 && !(cancellation && cancellation->is_cancelled()) )
+    {
+      record_detection_latency(sanitizer, *test_case_info, latency_seconds);
+    }
+    // exhaustion depends on the load of the host as well, so it is not reused
+    if ( reuses_results && result != RESOURCE_EXHAUSTED && !(cancellation && cancellation->is_cancelled()) ) build_cache->add_result(run_key, result);
+  }
+  if ( duration_history && !(cancellation && cancellation->is_cancelled()) )
+  {
+    // reused binaries and results cost nothing this time, but would again without the build cache
+    duration_history->record(sanitizer.get_name(), is_baseline, make_test_case_id(*test_case_info),
+      reuses_binary ? -1 : compile_seconds, found_result ? -1 : run_seconds);
+  }
+  if ( stats )
+  {
+    stats->compile_seconds = compile_seconds;
+    stats->run_seconds = run_seconds;
+    stats->peak_memory_kb = peak_memory_kb;
+    stats->reused_binary = reuses_binary;
+    stats->reused_result = found_result;
+  }
+
+  if (!options.keep_binaries)
+  {
+    remove(binary_path.c_str());
+  }
+  return result;
+}
+
+/**
+ * Expected duration of a job, the sum of the recorded durations of its variants; since only evaluated variants are
+ * recorded, the variants that were skipped after a detection do not count. Returns -1 if none is recorded.
+ */
+static double get_expected_duration(const Sanitizer &sanitizer, const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos, bool is_baseline)
+{
+  if ( !duration_history ) return -1;
+  double expected_duration = -1;
+  for ( const auto &test_case_info: test_case_infos )
+  {
+    double seconds;
+    if ( is_baseline && test_case_info->get_is_validation() ) continue;
+    if ( !duration_history->find(sanitizer.get_name(), is_baseline, make_test_case_id(*test_case_info), seconds) ) continue;
+    expected_duration = std::max(expected_duration, 0.0) + seconds;
+  }
+  return expected_duration;
+}
+
+static std::string format_duration(double seconds)
+{
+  const long total = std::lround(seconds);
+  std::ostringstream formatted;
+  if ( total >= 3600 ) formatted << total / 3600 << "h" << std::setw(2) << std::setfill('0');
+  if ( total >= 60 ) formatted << total / 60 % 60 << "m" << std::setw(2) << std::setfill('0');
+  formatted << total % 60 << "s";
+  return formatted.str();
+}
+
+static const std::chrono::seconds PROGRESS_INTERVAL{10}; // time between two estimates of the remaining time
+
+/**
+ * Prints the expected remaining time once in a while, extrapolating the time taken so far by the expected durations
+ * of the finished and remaining jobs. Called by the scheduler after each job.
+ */
+class ProgressReporter
+{
+public:
+  ProgressReporter(size_t job_count, double expected_total): job_count(job_count), expected_total(expected_total),
+    start(std::chrono::steady_clock::now()), last_report(start) { }
+
+  void finish_job(double expected_duration)
+  {
+    std::lock_guard<std::mutex> lock(output_mutex);
+    finished_jobs++;
+    expected_finished += expected_duration;
+    const auto now = std::chrono::steady_clock::now();
+    if ( now - last_report < PROGRESS_INTERVAL || finished_jobs == job_count || expected_finished <= 0 ) return;
+    last_report = now;
+    const double elapsed = seconds_since(start);
+    const double remaining = elapsed * std::max(expected_total - expected_finished, 0.0) / expected_finished;
+    Logger(log_level_t::NORMAL) << "Progress: " << finished_jobs << " of " << job_count << " evaluations done, "
+      << format_duration(remaining) << " remaining.\n";
+  }
+
+private:
+  size_t job_count;
+  double expected_total;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point last_report;
+  size_t finished_jobs = 0;
+  double expected_finished = 0;
+};
+
+static const char BASELINE_JOB[] = "b"; // journal job of the baseline, the jobs of the sanitizers are their indexes
+
+/**
+ * Evaluates count variants in order: evaluate(i) returns the result of variant i and commit(i, result) records it,
+ * returning whether the following variants can be skipped. With options.speculation > 1, up to that many variants are
+ * evaluated concurrently, but their results are still committed in order; the variants following a variant whose
+ * commit stops the evaluation are cancelled and their results discarded, as if never evaluated.
+ */
+static void evaluate_in_order(size_t count, const EvaluationOptions &options,
+  const std::function<exec_result_t(size_t, CancellationToken *)> &evaluate, const std::function<bool(size_t, exec_result_t)> &commit)
+{
+  if ( options.speculation <= 1 )
+  {
+    for ( size_t i = 0; i < count; i++ )
+    {
+      if ( commit(i, evaluate(i, nullptr)) ) return;
+    }
+    return;
+  }
+
+  std::vector<std::unique_ptr<CancellationToken>> cancellations(count);
+  std::vector<std::future<exec_result_t>> results(count);
+  size_t started = 0;
+  for ( size_t i = 0; i < count; i++ )
+  {
+    for ( ; started < count && started < i + options.speculation; started++ )
+    {
+      cancellations[started].reset(new CancellationToken());
+      CancellationToken *cancellation = cancellations[started].get();
+      const size_t index = started;
+      results[started] = std::async(std::launch::async, [&evaluate, index, cancellation]() {
+        return evaluate(index, cancellation);
+      });
+    }
+    if ( commit(i, results[i].get()) )
+    {
+      for ( size_t j = i + 1; j < started; j++ )
+      {
+        cancellations[j]->cancel();
+      }
+      break; // the destructors of the remaining futures wait for the cancelled variants
+    }
+  }
+}
+
+/**
+ * Compiles and executes the baseline variants of a test case. The baseline is shared by all runs and built with the
+ * baseline setup of the first one. If job_results is given, the results are added to it as well.
+ */
+static void evaluate_baseline(const std::vector<std::shared_ptr<SanitizerRun>> &runs, const std::string &binaries_dir,
+  const std::string &test_case_key, const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos, const EvaluationOptions &options,
+  job_results_t *job_results = nullptr)
+{
+  const Sanitizer &sanitizer = runs[0]->sanitizer;
+  const std::string group_id = make_test_case_group_id(*test_case_infos.front());
+  print_message(log_level_t::VERBOSE, "Evaluating baseline: " + test_case_key + "\n");
+  TraceSpan span("evaluate baseline", test_case_key, sanitizer.get_name());
+
+  std::vector<std::shared_ptr<TestCaseInformation>> normal_infos; // only normal phase for the baseline
+  std::copy_if(test_case_infos.begin(), test_case_infos.end(), std::back_inserter(normal_infos), [](const std::shared_ptr<TestCaseInformation> &test_case_info) {
+    return !test_case_info->get_is_validation();
+  });
+
+  std::vector<variant_stats_t> stats(normal_infos.size()); // each set by the evaluation of its variant, before the commit
+  std::vector<binary_footprint_t> variant_footprints(normal_infos.size()); // likewise
+  auto evaluate = [&](size_t i, CancellationToken *cancellation) {
+    const std::string binary_path = binaries_dir + "/" + normal_infos[i]->get_file_name_without_suffix() + "_baseline";
+    return build_and_execute(sanitizer, normal_infos[i], binary_path, /*is_baseline=*/true, options, "", cancellation, &stats[i], &variant_footprints[i]);
+  };
+  auto commit = [&](size_t i, exec_result_t result) {
+    const std::shared_ptr<TestCaseInformation> &test_case_info = normal_infos[i];
+    record_footprint(sanitizer, *test_case_info, variant_footprints[i], /*is_baseline=*/true);
+    bool can_stop = collect_result(runs[0]->results->store, test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/true);
+    if ( results_exporter ) results_exporter->add_variant(sanitizer.get_name(), *test_case_info, /*is_baseline=*/true, result, &stats[i]);
+    {
+      std::lock_guard<std::mutex> lock(output_mutex);
+      for ( size_t j = 1; j < runs.size(); j++ )
+      {
+        runs[j]->results->store.add(*test_case_info, result, /*is_baseline=*/true);
+      }
+    }
+    if ( journal ) journal->add(BASELINE_JOB, group_id, 'b', result);
+    if ( job_results ) job_results->emplace_back('b', result);
+    return can_stop && !options.run_all_variants;
+  };
+  evaluate_in_order(normal_infos.size(), options, evaluate, commit);
+  if ( journal ) journal->finish(BASELINE_JOB, group_id);
+}
+
+/**
+ * Compiles and executes the validation and normal variants of a test case with the sanitizer of run. If job_results
+ * is given, the results are added to it as well.
+ */
+static void evaluate_variants(SanitizerRun &run, const std::string &job, const std::string &label,
+  const std::string &test_case_key, const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos, const EvaluationOptions &options,
+  job_results_t *job_results = nullptr)
+{
+  const std::string group_id = make_test_case_group_id(*test_case_infos.front());
+  print_message(log_level_t::NORMAL, "Evaluating" + label + ": " + test_case_key + "\n");
+  TraceSpan span("evaluate", test_case_key, run.sanitizer.get_name());
+
+  std::vector<variant_stats_t> stats(test_case_infos.size()); // each set by the evaluation of its variant, before the commit
+  std::vector<binary_footprint_t> variant_footprints(test_case_infos.size()); // likewise
+  auto evaluate = [&](size_t i, CancellationToken *cancellation) {
+    const std::string binary_path = run.binaries_dir + "/" + test_case_infos[i]->get_file_name_without_suffix();
+    return build_and_execute(run.sanitizer, test_case_infos[i], binary_path, /*is_baseline=*/false, options, label, cancellation, &stats[i],
+      &variant_footprints[i]);
+  };
+  auto commit = [&](size_t i, exec_result_t result) {
+    const std::shared_ptr<TestCaseInformation> &test_case_info = test_case_infos[i];
+    record_footprint(run.sanitizer, *test_case_info, variant_footprints[i], /*is_baseline=*/false);
+    bool can_stop = collect_result(run.results->store, test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/false);
+    if ( !test_case_info->get_is_validation() ) run.variant_eval_counter++;
+    const char phase = test_case_info->get_is_validation() ? 'v' : 'n';
+    if ( results_exporter ) results_exporter->add_variant(run.sanitizer.get_name(), *test_case_info, /*is_baseline=*/false, result, &stats[i]);
+    if ( journal ) journal->add(job, group_id, phase, result);
+    if ( job_results ) job_results->emplace_back(phase, result);
+    return can_stop && !options.run_all_variants;
+  };
+  evaluate_in_order(test_case_infos.size(), options, evaluate, commit);
+  if ( journal ) journal->finish(job, group_id);
+}
+
+typedef std::map<std::string, std::vector<std::shared_ptr<TestCaseInformation>>> test_case_groups_t; // variants per test case key
+
+/**
+ * Stratum of a test case when sampling: its bug type and the region (temporal) or origin-target relation (spatial).
+ */
+static std::tuple<bool, uint8_t, uint8_t> get_stratum(const TestCaseInformation &test_case_info)
+{
+  const std::vector<uint8_t> &dimension_ids = test_case_info.get_dimension_ids();
+  return std::make_tuple(test_case_info.is_temporal(), dimension_ids[0], dimension_ids[test_case_info.is_temporal() ? 2 : 3]);
+}
+
+/**
+ * Selects the test cases evaluated within options.budget_seconds: the longest prefix of a stratified sample (see
+ * order_stratified_sample()) whose recorded durations fit in the budget on options.jobs threads. Test cases without
+ * recorded durations are expected to take as long as the average one; without any, all test cases are selected and
+ * the budget is only kept by skipping the test cases not started by its end. Returns the keys of the selected test
+ * cases in sampling order.
+ */
+static std::vector<std::string> select_sample(const test_case_groups_t &grouped_test_cases,
+  const std::vector<std::shared_ptr<SanitizerRun>> &runs, const EvaluationOptions &options)
+{
+  std::map<std::tuple<bool, uint8_t, uint8_t>, size_t> stratum_indexes;
+  std::vector<size_t> strata;
+  std::vector<uint64_t> shuffle_keys;
+  std::vector<const std::string *> keys;
+  std::vector<double> costs; // -1 if unknown
+  double known_cost = 0;
+  size_t known_count = 0;
+  for ( const auto &grouped_test_case: grouped_test_cases )
+  {
+    const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos = grouped_test_case.second;
+    strata.push_back(stratum_indexes.emplace(get_stratum(*test_case_infos.front()), stratum_indexes.size()).first->second);
+    shuffle_keys.push_back(fnv1a_64(grouped_test_case.first.data(), grouped_test_case.first.size()));
+    keys.push_back(&grouped_test_case.first);
+
+    double cost = options.compute_baseline ? get_expected_duration(runs[0]->sanitizer, test_case_infos, /*is_baseline=*/true) : 0;
+    for ( size_t i = 0; i < runs.size() && cost >= 0; i++ )
+    {
+      const double expected_duration = get_expected_duration(runs[i]->sanitizer, test_case_infos, /*is_baseline=*/false);
+      cost = expected_duration < 0 ? -1 : cost + expected_duration;
+    }
+    if ( cost >= 0 )
+    {
+      known_cost += cost;
+      known_count++;
+    }
+    costs.push_back(cost);
+  }
+
+  const std::vector<size_t> order = order_stratified_sample(strata, shuffle_keys);
+  std::vector<std::string> sample;
+  const double capacity = static_cast<double>(options.budget_seconds * options.jobs);
+  const double average_cost = known_count == 0 ? 0 : known_cost / static_cast<double>(known_count);
+  double total_cost = 0;
+  for ( const size_t i: order )
+  {
+    total_cost += costs[i] < 0 ? average_cost : costs[i];
+    if ( known_count > 0 && total_cost > capacity && !sample.empty() ) break;
+    sample.push_back(*keys[i]);
+  }
+  if ( known_count == 0 )
+  {
+    Logger(log_level_t::NORMAL) << "No recorded durations (see --durations), evaluating test cases until the budget is spent.\n";
+  }
+  else
+  {
+    Logger(log_level_t::NORMAL) << "Sampled " << sample.size() << " of " << grouped_test_cases.size() << " test cases expected to fit in "
+      << format_duration(static_cast<double>(options.budget_seconds)) << ".\n";
+  }
+  return sample;
+}
 
-        bool can_stop = collect_result(test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/true);
-        if (can_stop && !run_all_variants)
+/**
+ * Keeps an evaluation within its budget when the recorded durations underestimate it: once the deadline passed, the
+ * jobs of test cases not started yet are skipped, while the test cases already started are completed.
+ */
+class BudgetDeadline
+{
+public:
+  explicit BudgetDeadline(std::chrono::steady_clock::time_point deadline): deadline(deadline) { }
+
+  /**
+   * Returns whether a job of the test case can run.
+   */
+  bool admit(const std::string &test_case_key)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if ( started.count(test_case_key) != 0 ) return true;
+    if ( skipped.count(test_case_key) != 0 ) return false;
+    if ( std::chrono::steady_clock::now() >= deadline )
+    {
+      skipped.insert(test_case_key);
+      return false;
+    }
+    started.insert(test_case_key);
+    return true;
+  }
+
+  size_t get_skipped_count() const { return skipped.size(); }
+
+private:
+  std::mutex mutex;
+  std::chrono::steady_clock::time_point deadline;
+  std::set<std::string> started;
+  std::set<std::string> skipped;
+};
+
+static std::unique_ptr<BudgetDeadline> budget_deadline; // set with EvaluationOptions::budget_seconds
+
+/**
+ * Prints the detection rates of the whole population estimated from the sampled results, per primitive of the
+ * dimensions printed by process_results(). population holds one row per test case of the population.
+ */
+static void print_estimates(const std::vector<std::shared_ptr<SanitizerResults>> &all_results, const ResultStore &population)
+{
+  static const std::vector<std::pair<size_t, std::string>> TEMPORAL_DIMENSIONS = {
+    {0, "bug type"}, {2, "region"}, {1, "memory state"}, {3, "access type location"}, {4, "access type action"}
+  };
+  static const std::vector<std::pair<size_t, std::string>> SPATIAL_DIMENSIONS = {
+    {0, "bug type"}, {1, "origin"}, {2, "target"}, {3, "origin-target relation"}, {4, "flow"}, {5, "access type location"}, {6, "access type action"}
+  };
+
+  auto print_estimate = [](const std::string &name, const counters_t &sampled, const counters_t &total) {
+    if ( total.total() == 0 ) return;
+    Logger(log_level_t::NORMAL) << name << ": ";
+    if ( sampled.total() == 0 )
+    {
+      Logger(log_level_t::NORMAL) << "N/A (0 out of " << total.total() << " test cases sampled)\n";
+      return;
+    }
+    const rate_estimate_t estimate = estimate_rate(count_prevented(sampled), sampled.total(), total.total());
+    Logger(log_level_t::NORMAL) << score_to_str(estimate.rate * 100) << " [" << score_to_str(estimate.lower * 100) << ", "
+      << score_to_str(estimate.upper * 100) << "] (" << sampled.total() << " out of " << total.total() << " test cases sampled)\n";
+  };
+
+  for ( const auto &results: all_results )
+  {
+    Logger(log_level_t::NORMAL) << "==============================\n\n";
+    Logger(log_level_t::NORMAL) << "Estimated detection rates" << (all_results.size() > 1 ? " for " + results->sanitizer_name : "")
+      << " (95% confidence intervals):\n";
+    print_estimate("Overall", results->store.count_all(/*baseline=*/false), population.count_all(/*baseline=*/false));
+    for ( const test_case_kind_t kind: {TEMPORAL_KIND, SPATIAL_KIND} )
+    {
+      const counters_t kind_total = population.count(kind, {}, /*baseline=*/false)[0];
+      if ( kind_total.total() == 0 ) continue;
+      print_estimate(kind == TEMPORAL_KIND ? "Temporal bugs" : "Spatial bugs", results->store.count(kind, {}, /*baseline=*/false)[0], kind_total);
+      for ( const auto &dimension: kind == TEMPORAL_KIND ? TEMPORAL_DIMENSIONS : SPATIAL_DIMENSIONS )
+      {
+        Logger(log_level_t::NORMAL) << "Per " << dimension.second << ":\n";
+        const std::vector<counters_t> sampled = results->store.count(kind, {dimension.first}, /*baseline=*/false);
+        const std::vector<counters_t> total = population.count(kind, {dimension.first}, /*baseline=*/false);
+        const PrimitiveDimension &names = TestCaseInformation::get_dimension_names(kind == TEMPORAL_KIND, dimension.first);
+        for ( size_t id = 0; id < names.size(); id++ )
         {
-          break;
+          print_estimate(std::string("- ") + names[id].printable_name, sampled[id], total[id]);
         }
       }
     }
+  }
+}
 
-    Logger(log_level_t::NORMAL) << "Evaluating: " << grouped_test_case.first << "\n";
-    for (const auto& test_case_info : test_case_infos)
+/**
+ * Adds the results of a job evaluated elsewhere, i.e., before resuming or by a worker, as evaluate_baseline() and
+ * evaluate_variants() did. The results are in the order of the sorted test_case_infos, without the validation
+ * variants for the baseline, since they were committed in order.
+ */
+static void add_job_results(const std::vector<std::shared_ptr<SanitizerRun>> &runs, const std::string &job,
+  const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos, const job_results_t &results)
+{
+  std::vector<std::shared_ptr<TestCaseInformation>> variants = test_case_infos;
+  if ( job == BASELINE_JOB )
+  {
+    variants.erase(std::remove_if(variants.begin(), variants.end(), [](const std::shared_ptr<TestCaseInformation> &test_case_info) {
+      return test_case_info->get_is_validation();
+    }), variants.end());
+  }
+  for ( size_t i = 0; i < results.size(); i++ )
+  {
+    const char phase = results[i].first;
+    const exec_result_t result = results[i].second;
+    // all variants share the dimensions and object sizes, so the store only needs one if the journal is longer
+    const TestCaseInformation &test_case_info = *variants[std::min(i, variants.size() - 1)];
+    if ( phase == 'b' )
+    {
+      for ( const auto &run: runs )
+      {
+        run->results->store.add(test_case_info, result, /*is_baseline=*/true);
+      }
+      if ( results_exporter && i < variants.size() )
+      {
+        results_exporter->add_variant(runs[0]->sanitizer.get_name(), test_case_info, /*is_baseline=*/true, result, nullptr);
+      }
+      continue;
+    }
+    SanitizerRun &run = *runs[std::stoul(job)];
+    if ( results_exporter && i < variants.size() )
+    {
+      results_exporter->add_variant(run.sanitizer.get_name(), test_case_info, /*is_baseline=*/false, result, nullptr);
+    }
+    if ( phase == 'v' )
+    {
+      if ( result != SUCCESSFUL ) run.results->store.add(test_case_info, INVALID, /*is_baseline=*/false);
+      continue;
+    }
+    run.results->store.add(test_case_info, result, /*is_baseline=*/false);
+    run.variant_eval_counter++;
+  }
+}
+
+/**
+ * Adds the results of a job finished before resuming. Returns false if the job has to be evaluated.
+ */
+static bool replay_job(const std::vector<std::shared_ptr<SanitizerRun>> &runs, const std::string &job,
+  const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos)
+{
+  if ( !journal ) return false;
+  job_results_t results;
+  const bool is_finished = journal->replay(job, make_test_case_group_id(*test_case_infos.front()), [&results](char phase, exec_result_t result) {
+    results.emplace_back(phase, result);
+  });
+  if ( is_finished ) add_job_results(runs, job, test_case_infos, results);
+  return is_finished;
+}
+
+/**
+ * Options and configurations that the results depend on, a journal can only be resumed by an evaluation with the same
+ * ones.
+ */
+static std::string make_journal_header(const std::vector<std::shared_ptr<SanitizerRun>> &runs, const EvaluationOptions &options)
+{
+  std::ostringstream header;
+  header << "baseline " << (options.compute_baseline ? "yes" : "no") << "\n";
+  header << "all_variants " << (options.run_all_variants ? "yes" : "no") << "\n";
+  header << "shard " << options.shard_index << "/" << options.shard_count << "\n";
+  header << "sanitizers " << runs.size() << "\n";
+  for ( const auto &run: runs )
+  {
+    header << "sanitizer " << run->sanitizer.get_name() << "\n";
+    for ( const bool is_baseline: {false, true} )
     {
-      std::string dir_path = test_cases_dir_path;
-      if (dir_path.back() != '/')
+      header << run->sanitizer.get_compile_signature(is_baseline) << "\n";
+      header << run->sanitizer.get_run_signature(is_baseline) << "\n";
+    }
+  }
+  return header.str();
+}
+
+/**
+ * Options and configurations that the results of a job depend on, a worker must evaluate with the same ones as its
+ * coordinator.
+ */
+static std::string make_work_header(const std::vector<std::shared_ptr<SanitizerRun>> &runs, const EvaluationOptions &options)
+{
+  std::ostringstream header;
+  header << "baseline " << (options.compute_baseline ? "yes" : "no") << "\n";
+  header << "all_variants " << (options.run_all_variants ? "yes" : "no") << "\n";
+  for ( const auto &run: runs )
+  {
+    header << "sanitizer " << run->sanitizer.get_name() << "\n";
+    header << run->sanitizer.get_run_signature(/*is_baseline=*/false) << "\n";
+    header << run->sanitizer.get_run_signature(/*is_baseline=*/true) << "\n";
+  }
+  return header.str();
+}
+
+/**
+ * Prints the prevented test cases per bug type and sanitizer, formatted like the table in the README.
+ */
+static void print_comparison_table(const std::vector<std::shared_ptr<SanitizerResults>> &all_results, bool with_baseline)
+{
+  Logger(log_level_t::NORMAL) << "==============================\n\n";
+  Logger(log_level_t::NORMAL) << "Prevented test cases per bug type:\n";
+  Logger(log_level_t::NORMAL) << "| Sanitizer | Linear OOBA | Non-linear OOBA | Type confusion OOBA | Use-after-* | Double-free | Misuse-of-free |\n";
+  Logger(log_level_t::NORMAL) << "|:----------|:------------|:----------------|:--------------------|:------------|:------------|:---------------|\n";
+
+  auto print_row = [](const std::string &name, const ResultStore &results, bool baseline)
+  {
+    const std::vector<counters_t> spatial_counters = results.count(SPATIAL_KIND, {0}, baseline);
+    const std::vector<counters_t> temporal_counters = results.count(TEMPORAL_KIND, {0}, baseline);
+    const counters_t columns[] = {
+      spatial_counters[static_cast<size_t>(spatial_bug_id_t::LINEAR_OOBA)],
+      spatial_counters[static_cast<size_t>(spatial_bug_id_t::NON_LINEAR_OOBA)],
+      spatial_counters[static_cast<size_t>(spatial_bug_id_t::TYPE_CONFUSION_OOBA)],
+      temporal_counters[static_cast<size_t>(temporal_bug_id_t::USE_AFTER_STAR)],
+      temporal_counters[static_cast<size_t>(temporal_bug_id_t::DOUBLE_FREE)],
+      temporal_counters[static_cast<size_t>(temporal_bug_id_t::MISUSE_OF_FREE)]
+    };
+    Logger(log_level_t::NORMAL) << "| " << name << " |";
+    for ( const counters_t &counters: columns )
+    {
+      const size_t prevented = count_prevented(counters);
+      if ( counters.total() == 0 )
       {
-        dir_path += "/";
+        Logger(log_level_t::NORMAL) << " N/A |";
+        continue;
       }
-      std::string binary_path = dir_path + "/" + TEST_CASE_BINARIES_DIR_NAME + "/" + test_case_info->get_file_name_without_suffix();
+      Logger(log_level_t::NORMAL) << " " << prevented << " (" << score_to_str(static_cast<double>(prevented) * 100 / static_cast<double>(counters.total())) << ") |";
+    }
+    Logger(log_level_t::NORMAL) << "\n";
+  };
 
-      if ( !sanitizer.compile(test_case_info->get_file_path(), binary_path) )
+  if ( with_baseline )
+  {
+    print_row("Baseline", all_results[0]->store, /*baseline=*/true);
+  }
+  for ( const auto &results: all_results )
+  {
+    print_row(results->sanitizer_name, results->store, /*baseline=*/false);
+  }
+}
+
+/**
+ * Prints the prevented test cases and the execution costs of each sanitizer, i.e., of each point of the sweeps, and
+ * marks the Pareto frontier: the sanitizers that no other one beats in prevented test cases, mean run time and peak
+ * memory at once. Requires collapsed results.
+ */
+static void print_sweep_report(const std::vector<std::shared_ptr<SanitizerRun>> &runs)
+{
+  struct point_t
+  {
+    size_t prevented;
+    double mean_run_ms;
+    size_t peak_memory_kb;
+  };
+  std::vector<point_t> points;
+  for ( const auto &run: runs )
+  {
+    const execution_costs_t &costs = execution_costs[run->sanitizer.get_name()];
+    const double mean_run_ms = costs.executions == 0 ? 0 : costs.run_seconds * 1000 / static_cast<double>(costs.executions);
+    points.push_back({count_prevented(run->results->store.count_all(/*baseline=*/false)), mean_run_ms, costs.peak_memory_kb});
+  }
+  auto dominates = [](const point_t &lhs, const point_t &rhs) {
+    return lhs.prevented >= rhs.prevented && lhs.mean_run_ms <= rhs.mean_run_ms && lhs.peak_memory_kb <= rhs.peak_memory_kb
+      && (lhs.prevented > rhs.prevented || lhs.mean_run_ms < rhs.mean_run_ms || lhs.peak_memory_kb < rhs.peak_memory_kb);
+  };
+
+  Logger(log_level_t::NORMAL) << "==============================\n\n";
+  Logger(log_level_t::NORMAL) << "Detection and overhead per sweep point (* on the Pareto frontier):\n";
+  Logger(log_level_t::NORMAL) << "| Sanitizer | Prevented | Mean run time | Peak memory | Pareto |\n";
+  Logger(log_level_t::NORMAL) << "|:----------|:----------|:--------------|:------------|:-------|\n";
+  for ( size_t i = 0; i < runs.size(); i++ )
+  {
+    const bool is_dominated = std::any_of(points.begin(), points.end(), [&](const point_t &other) { return dominates(other, points[i]); });
+    const size_t total = runs[i]->results->store.count_all(/*baseline=*/false).total();
+    std::ostringstream row;
+    row << "| " << runs[i]->sanitizer.get_name() << " | " << points[i].prevented << " (" << score_to_str(total == 0 ? 0
+      : static_cast<double>(points[i].prevented) * 100 / static_cast<double>(total)) << ") | " << std::fixed << std::setprecision(2)
+      << points[i].mean_run_ms << " ms | " << points[i].peak_memory_kb << " KiB | " << (is_dominated ? "" : "*") << " |\n";
+    Logger(log_level_t::NORMAL) << row.str();
+  }
+}
+
+static std::string format_growth(size_t size, size_t baseline_size)
+{
+  if ( baseline_size == 0 ) return size == 0 ? "+0.00%" : "N/A";
+  const double growth = (static_cast<double>(size) - static_cast<double>(baseline_size)) * 100 / static_cast<double>(baseline_size);
+  return (growth >= 0 ? "+" : "") + score_to_str(growth);
+}
+
+static void add_footprint(binary_footprint_t &sum, const binary_footprint_t &footprint)
+{
+  sum.file_size += footprint.file_size;
+  sum.text_size += footprint.text_size;
+  sum.data_size += footprint.data_size;
+  sum.bss_size += footprint.bss_size;
+  sum.data_index_size += footprint.data_index_size;
+  sum.check_sites += footprint.check_sites;
+  sum.counts_check_sites = sum.counts_check_sites && footprint.counts_check_sites;
+}
+
+static const std::pair<const char *, size_t binary_footprint_t::*> FOOTPRINT_SIZES[] = {
+  {"file", &binary_footprint_t::file_size}, {".text", &binary_footprint_t::text_size}, {".data", &binary_footprint_t::data_size},
+  {".bss", &binary_footprint_t::bss_size}, {".data.index", &binary_footprint_t::data_index_size}
+};
+
+/**
+ * The mean sizes per binary of a sum of binary_count footprints, with their growth against the baseline if given, and
+ * the number of check sites.
+ */
+static std::vector<std::string> format_footprint(const binary_footprint_t &footprint, const binary_footprint_t *baseline, size_t binary_count)
+{
+  std::vector<std::string> cells;
+  for ( const auto &size: FOOTPRINT_SIZES )
+  {
+    cells.push_back(std::to_string(footprint.*size.second / binary_count));
+    if ( baseline ) cells.back() += " (" + format_growth(footprint.*size.second, baseline->*size.second) + ")";
+  }
+  cells.push_back(footprint.counts_check_sites ? std::to_string(footprint.check_sites) : "N/A");
+  return cells;
+}
+
+/**
+ * Prints the sizes of the sections of the binaries of each sanitizer and the number of sanitizer check sites in them,
+ * with their growth against the baseline binaries of the same variants: per variant if verbose, and as the mean per
+ * binary over all variants. Only the variants with a baseline binary are compared, unless there is none at all.
+ */
+static void print_footprint_report(const std::vector<std::shared_ptr<SanitizerRun>> &runs)
+{
+  std::vector<std::string> rows;
+  for ( const auto &run: runs )
+  {
+    const std::map<std::string, binary_footprint_t> &sanitizer_footprints = footprints[run->sanitizer.get_name()];
+    if ( sanitizer_footprints.empty() ) continue;
+    binary_footprint_t total, paired_total, paired_baseline_total;
+    total.counts_check_sites = paired_total.counts_check_sites = true;
+    size_t paired_count = 0;
+    for ( const auto &footprint: sanitizer_footprints )
+    {
+      add_footprint(total, footprint.second);
+      auto baseline = baseline_footprints.find(footprint.first);
+      if ( baseline == baseline_footprints.end() ) continue;
+      paired_count++;
+      add_footprint(paired_total, footprint.second);
+      add_footprint(paired_baseline_total, baseline->second);
+
+      const std::vector<std::string> cells = format_footprint(footprint.second, &baseline->second, 1);
+      std::ostringstream line;
+      line << "Footprint of " << footprint.first << " with " << run->sanitizer.get_name() << ":";
+      for ( size_t i = 0; i < cells.size() - 1; i++ )
       {
-        std::cerr << "Failed to compile " << test_case_info->get_file_path() << '\n';
-        std::cerr << "Aborting.\n";
-        exit(EXIT_FAILURE);
+        line << " " << FOOTPRINT_SIZES[i].first << " " << cells[i] << ",";
+      }
+      Logger(log_level_t::VERBOSE) << line.str() << " " << cells.back() << " check sites.\n";
+    }
+
+    const size_t binary_count = paired_count > 0 ? paired_count : sanitizer_footprints.size();
+    std::ostringstream row;
+    row << "| " << run->sanitizer.get_name() << " | " << binary_count;
+    for ( const std::string &cell: paired_count > 0 ? format_footprint(paired_total, &paired_baseline_total, binary_count) : format_footprint(total, nullptr, binary_count) )
+    {
+      row << " | " << cell;
+    }
+    rows.push_back(row.str() + " |\n");
+  }
+  if ( rows.empty() ) return;
+
+  Logger(log_level_t::NORMAL) << "==============================\n\n";
+  Logger(log_level_t::NORMAL) << "Binary footprint, mean bytes per binary (growth against the baseline binary), and check sites:\n";
+  Logger(log_level_t::NORMAL) << "| Sanitizer | Binaries | File | .text | .data | .bss | .data.index | Check sites |\n";
+  Logger(log_level_t::NORMAL) << "|:----------|:---------|:-----|:------|:------|:-----|:------------|:------------|\n";
+  for ( const std::string &row: rows )
+  {
+    Logger(log_level_t::NORMAL) << row;
+  }
+}
+
+/**
+ * The exact percentile of sorted values, by the nearest rank.
+ */
+static double get_percentile(const std::vector<double> &sorted_values, double percentile)
+{
+  const size_t rank = static_cast<size_t>(std::ceil(percentile / 100 * static_cast<double>(sorted_values.size())));
+  return sorted_values[rank == 0 ? 0 : rank - 1];
+}
+
+/**
+ * Prints the distribution of the detection latencies of each sanitizer per bug type: how long the detected test cases
+ * ran after triggering their bug. Reused results were not executed and have no latency.
+ */
+static void print_latency_report(const std::vector<std::shared_ptr<SanitizerRun>> &runs)
+{
+  if ( triggered_executions == 0 )
+  {
+    std::cerr << "WARNING: No executed test case reported triggering its bug, so no detection latency was measured. Test cases "
+      "generated before _trigger() was added to the prelude must be regenerated with --generate.\n";
+    return;
+  }
+  std::vector<std::string> rows;
+  for ( const auto &run: runs )
+  {
+    for ( auto &bug_type: detection_latencies[run->sanitizer.get_name()] )
+    {
+      std::vector<double> &latencies = bug_type.second;
+      std::sort(latencies.begin(), latencies.end());
+      std::ostringstream row;
+      row << "| " << run->sanitizer.get_name() << " | " << bug_type.first << " | " << latencies.size() << std::fixed << std::setprecision(3);
+      for ( const double percentile: {50.0, 90.0, 99.0, 100.0} )
+      {
+        row << " | " << get_percentile(latencies, percentile) * 1000 << " ms";
       }
-      exec_result_t result = sanitizer.execute(binary_path);
+      rows.push_back(row.str() + " |\n");
+    }
+  }
+  if ( rows.empty() ) return;
+
+  Logger(log_level_t::NORMAL) << "==============================\n\n";
+  Logger(log_level_t::NORMAL) << "Detection latency, from triggering the bug until the test case terminated:\n";
+  Logger(log_level_t::NORMAL) << "| Sanitizer | Bug type | Detections | p50 | p90 | p99 | Max |\n";
+  Logger(log_level_t::NORMAL) << "|:----------|:---------|:-----------|:----|:----|:----|:----|\n";
+  for ( const std::string &row: rows )
+  {
+    Logger(log_level_t::NORMAL) << row;
+  }
+}
 
-      if (!keep_binaries)
+/**
+ * Prints the results of all sanitizers and, if requested, writes them to options.results_path.
+ */
+static void report_results(const std::vector<std::shared_ptr<SanitizerResults>> &all_results, const EvaluationOptions &options)
+{
+  TraceSpan span("aggregate");
+  if ( !options.results_path.empty() )
+  {
+    save_results(options.results_path, all_results, options.compute_baseline);
+  }
+  const bool several_sanitizers = all_results.size() > 1;
+  for ( const auto &results: all_results )
+  {
+    if ( several_sanitizers )
+    {
+      Logger(log_level_t::NORMAL) << "==============================\n\n";
+      Logger(log_level_t::NORMAL) << "Results for " << results->sanitizer_name << ":\n";
+    }
+    Logger(log_level_t::NORMAL) << "Evaluated " << results->test_case_counter << " test cases, " << results->variant_eval_counter << " variants.\n";
+    collapse_results(results->store, options.compute_baseline);
+    process_results(results->store, options.print_table_summary, options.compute_baseline);
+    if ( results_exporter ) results_exporter->add_aggregates(results->sanitizer_name, results->store, options.compute_baseline);
+  }
+  if ( several_sanitizers )
+  {
+    print_comparison_table(all_results, options.compute_baseline);
+  }
+}
+
+extern void compile_and_evaluate(const EvaluationOptions &options)
+{
+  if (options.verbose)
+  {
+    Logger::allowed_log_level = log_level_t::VERBOSE;
+  }
+  if ( options.json_log )
+  {
+    Logger::log_format = log_format_t::JSON_LINES;
+  }
+  metrics.reset(new Metrics());
+  metrics->set_workers(options.jobs);
+  execution_costs.clear(); // of the previous job of the daemon
+  footprints.clear();
+  baseline_footprints.clear();
+  detection_latencies.clear();
+  triggered_executions = 0;
+  std::vector<std::shared_ptr<SanitizerRun>> runs;
+  std::set<std::string> sanitizer_names;
+  bool is_sweep = false;
+  {
+    PhaseTimer timer(*metrics, phase_t::PARSE_CONFIGS);
+    for ( const auto &sanitizer_config: options.sanitizer_configs )
+    {
+      const Sanitizer sanitizer = load_sanitizer(sanitizer_config);
+      is_sweep = is_sweep || sanitizer.is_sweep();
+      for ( const Sanitizer &point: sanitizer.expand_sweep() )
       {
-        remove(binary_path.c_str());
+        runs.push_back(std::make_shared<SanitizerRun>(point));
+        if ( !sanitizer_names.insert(runs.back()->sanitizer.get_name()).second )
+        {
+          std::cerr << "ERROR: Sanitizer " << runs.back()->sanitizer.get_name() << " is configured more than once. Aborting.\n";
+          exit(EXIT_FAILURE);
+        }
       }
+    }
+  }
+  const bool several_sanitizers = runs.size() > 1;
+
+  std::vector<std::shared_ptr<TestCaseInformation>> test_cases;
+  {
+    PhaseTimer timer(*metrics, phase_t::SCAN);
+    test_cases = get_test_cases(options);
+  }
+  const auto plan_start = std::chrono::steady_clock::now();
+
+  if (test_cases.empty())
+  {
+    std::cerr << "ERROR: No test files found. Aborting.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  std::string scratch_dir;
+  const std::string binaries_dir = get_binaries_dir(options, scratch_dir);
+  std::unique_ptr<Prelude> prelude = provide_prelude(test_cases);
+  for ( const auto &run: runs )
+  {
+    if ( prelude ) run->sanitizer.add_include_dir(prelude->get_dir_path());
+    // with several sanitizers, the binaries of each are kept apart, since the test cases share their file names
+    run->binaries_dir = several_sanitizers ? binaries_dir + "/" + run->sanitizer.get_name() : binaries_dir;
+    create_directory(run->binaries_dir);
+  }
+
+  test_case_groups_t grouped_test_cases;
+  for (const auto& test_case_information : test_cases)
+  {
+    grouped_test_cases[test_case_information->get_test_case_key()].push_back(test_case_information);
+  }
+
+  if ( !options.journal_path.empty() )
+  {
+    journal = Journal::open(options.journal_path, make_journal_header(runs, options), options.resume);
+    if ( !journal )
+    {
+      exit(EXIT_FAILURE);
+    }
+  }
+  open_results_exporter(options);
 
-      bool can_stop;
-      if ( test_case_info->get_is_validation() )
+  if ( !options.no_dedup && options.coordinator_address.empty() )
+  {
+    build_cache.reset(new BuildCache(binaries_dir + "/" + BUILD_CACHE_DIR_NAME, options.keep_build_cache && scratch_dir.empty()));
+  }
+
+  if ( !options.durations_path.empty() )
+  {
+    duration_history.reset(new DurationHistory());
+    if ( !duration_history->load(options.durations_path) )
+    {
+      std::cerr << "ERROR: " << options.durations_path << " is not a durations file. Aborting.\n";
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  std::vector<std::string> evaluation_order; // keys of grouped_test_cases
+  ResultStore population; // one row per test case, for the estimates of a sampled evaluation
+  if ( options.budget_seconds > 0 )
+  {
+    for ( const auto &grouped_test_case: grouped_test_cases )
+    {
+      population.add(*grouped_test_case.second.front(), SUCCESSFUL, /*is_baseline=*/false);
+    }
+    population.collapse();
+    evaluation_order = select_sample(grouped_test_cases, runs, options);
+    const std::set<std::string> sample(evaluation_order.begin(), evaluation_order.end());
+    for ( auto grouped_test_case = grouped_test_cases.begin(); grouped_test_case != grouped_test_cases.end(); )
+    {
+      grouped_test_case = sample.count(grouped_test_case->first) != 0 ? std::next(grouped_test_case) : grouped_test_cases.erase(grouped_test_case);
+    }
+  }
+  else
+  {
+    for ( const auto &grouped_test_case: grouped_test_cases )
+    {
+      evaluation_order.push_back(grouped_test_case.first);
+    }
+  }
+
+  // the jobs of all sanitizers are interleaved per test case, so that the threads stay busy with any mix of slow and fast sanitizers
+  Scheduler scheduler(options.jobs);
+  std::unique_ptr<WorkQueue> work_queue; // replaces the scheduler when coordinating workers
+  std::map<std::string, const test_case_groups_t::value_type *> groups_by_id; // of the jobs in work_queue
+  if ( !options.coordinator_address.empty() )
+  {
+    work_queue.reset(new WorkQueue(make_work_header(runs, options)));
+  }
+  size_t replayed_jobs = 0;
+  size_t job_count = 0;
+  size_t jobs_with_history = 0;
+  for ( const std::string &key: evaluation_order )
+  {
+    auto &grouped_test_case = *grouped_test_cases.find(key);
+    std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos = grouped_test_case.second;
+    std::sort(test_case_infos.begin(), test_case_infos.end(), compare_test_case_variants);
+
+    const std::string &test_case_key = grouped_test_case.first;
+    if (options.compute_baseline)
+    {
+      if ( replay_job(runs, BASELINE_JOB, test_case_infos) )
+      {
+        replayed_jobs++;
+      }
+      else if ( work_queue )
       {
-        // validation phase
-        can_stop = collect_validation_result(test_case_info, result, test_case_info->get_file_name());
+        const std::string group_id = make_test_case_group_id(*test_case_infos.front());
+        work_queue->add(BASELINE_JOB, group_id);
+        groups_by_id[group_id] = &grouped_test_case;
+        job_count++;
       }
       else
       {
-        // normal phase
-        can_stop = collect_result(test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/false);
-        variant_eval_counter++;
+        plan_builds(runs[0]->sanitizer, test_case_infos, /*is_baseline=*/true);
+        const double expected_duration = get_expected_duration(runs[0]->sanitizer, test_case_infos, /*is_baseline=*/true);
+        scheduler.add([&runs, &binaries_dir, &test_case_key, &test_case_infos, &options]() {
+          JobTimer timer(*metrics);
+          if ( budget_deadline && !budget_deadline->admit(test_case_key) ) return;
+          evaluate_baseline(runs, binaries_dir, test_case_key, test_case_infos, options);
+        }, expected_duration);
+        job_count++;
+        if ( expected_duration >= 0 ) jobs_with_history++;
       }
-      if (can_stop && !run_all_variants)
+    }
+    for ( size_t i = 0; i < runs.size(); i++ )
+    {
+      const std::string job = std::to_string(i);
+      if ( replay_job(runs, job, test_case_infos) )
       {
-        break;
+        replayed_jobs++;
+        continue;
+      }
+      if ( work_queue )
+      {
+        const std::string group_id = make_test_case_group_id(*test_case_infos.front());
+        work_queue->add(job, group_id);
+        groups_by_id[group_id] = &grouped_test_case;
+        job_count++;
+        continue;
+      }
+      const std::shared_ptr<SanitizerRun> &run = runs[i];
+      plan_builds(run->sanitizer, test_case_infos, /*is_baseline=*/false);
+      const std::string label = several_sanitizers ? " with " + run->sanitizer.get_name() : "";
+      const double expected_duration = get_expected_duration(run->sanitizer, test_case_infos, /*is_baseline=*/false);
+      scheduler.add([run, job, label, &test_case_key, &test_case_infos, &options]() {
+        JobTimer timer(*metrics);
+        if ( budget_deadline && !budget_deadline->admit(test_case_key) ) return;
+        evaluate_variants(*run, job, label, test_case_key, test_case_infos, options);
+      }, expected_duration);
+      job_count++;
+      if ( expected_duration >= 0 ) jobs_with_history++;
+    }
+  }
+  if ( options.resume )
+  {
+    Logger(log_level_t::NORMAL) << "Resuming: " << replayed_jobs << " evaluations of test cases restored from " << options.journal_path << ".\n";
+  }
+  metrics->add_jobs(job_count);
+  metrics->add_phase(phase_t::PLAN, seconds_since(plan_start));
+  std::unique_ptr<MetricsFileWriter> metrics_file;
+  if ( !options.metrics_path.empty() )
+  {
+    metrics_file.reset(new MetricsFileWriter(*metrics, options.metrics_path));
+  }
+  const auto evaluate_start = std::chrono::steady_clock::now();
+  if ( options.budget_seconds > 0 )
+  {
+    budget_deadline.reset(new BudgetDeadline(std::chrono::steady_clock::now() + std::chrono::seconds(options.budget_seconds)));
+  }
+  if ( work_queue )
+  {
+    auto on_done = [&runs, &groups_by_id, several_sanitizers](const std::string &job, const std::string &group_id, const job_results_t &results) {
+      const test_case_groups_t::value_type &grouped_test_case = *groups_by_id.at(group_id);
+      add_job_results(runs, job, grouped_test_case.second, results);
+      for ( const auto &result: results )
+      {
+        if ( journal ) journal->add(job, group_id, result.first, result.second);
       }
+      if ( journal ) journal->finish(job, group_id);
+      if ( job == BASELINE_JOB )
+      {
+        Logger(log_level_t::VERBOSE) << "Evaluated baseline: " << grouped_test_case.first << "\n";
+        return;
+      }
+      const std::string label = several_sanitizers ? " with " + runs[std::stoul(job)]->sanitizer.get_name() : "";
+      Logger(log_level_t::NORMAL) << "Evaluated" << label << ": " << grouped_test_case.first << "\n";
+    };
+    if ( !work_queue->run(options.coordinator_address, on_done) )
+    {
+      exit(EXIT_FAILURE);
+    }
+  }
+  else if ( jobs_with_history > 0 )
+  {
+    Logger(log_level_t::NORMAL) << "Expected duration: " << format_duration(scheduler.estimate_makespan()) << " with "
+      << options.jobs << " thread(s), from the recorded durations of " << jobs_with_history << " of " << job_count
+      << " evaluations of test cases.\n";
+    ProgressReporter progress(job_count, scheduler.get_expected_total());
+    scheduler.run([&progress](double expected_duration) { progress.finish_job(expected_duration); });
+  }
+  else
+  {
+    scheduler.run();
+  }
+  metrics->add_phase(phase_t::EVALUATE, seconds_since(evaluate_start));
+  journal.reset(); // syncs the remaining records
+  if ( duration_history )
+  {
+    if ( !duration_history->save(options.durations_path) )
+    {
+      std::cerr << "WARNING: Could not write the durations to " << options.durations_path << ".\n";
     }
+    duration_history.reset();
+  }
+  if ( build_cache )
+  {
+    Logger(log_level_t::VERBOSE) << "Reused " << build_cache->get_reused_binaries() << " binaries and "
+      << build_cache->get_reused_results() << " execution results of identical builds.\n";
+    build_cache.reset(); // removes the binaries kept for skipped variants
+  }
+  for ( const auto &costs: execution_costs )
+  {
+    Logger(log_level_t::VERBOSE) << "Peak memory of a test case with " << costs.first << ": " << costs.second.peak_memory_kb / 1024 << " MiB.\n";
   }
 
-  Logger(log_level_t::NORMAL) << "Evaluated " << grouped_test_cases.size() << " test cases, " << variant_eval_counter << " variants.\n";
-  collapse_results(compute_baseline);
-  process_results(print_table_summary, compute_baseline);
+  prelude.reset();
+  if ( several_sanitizers )
+  {
+    for ( const auto &run: runs )
+    {
+      rmdir(run->binaries_dir.c_str()); // only succeeds if no binary is kept
+    }
+  }
+  if ( !scratch_dir.empty() )
+  {
+    rmdir(scratch_dir.c_str());
+  }
+
+  size_t evaluated_test_cases = grouped_test_cases.size();
+  if ( budget_deadline )
+  {
+    evaluated_test_cases -= budget_deadline->get_skipped_count();
+    if ( budget_deadline->get_skipped_count() > 0 )
+    {
+      Logger(log_level_t::NORMAL) << "Budget spent: skipped " << budget_deadline->get_skipped_count() << " sampled test cases.\n";
+    }
+    budget_deadline.reset();
+  }
+
+  std::vector<std::shared_ptr<SanitizerResults>> all_results;
+  for ( const auto &run: runs )
+  {
+    run->results->test_case_counter = evaluated_test_cases;
+    run->results->variant_eval_counter = run->variant_eval_counter;
+    all_results.push_back(run->results);
+  }
+  {
+    PhaseTimer timer(*metrics, phase_t::AGGREGATE);
+    report_results(all_results, options);
+    if ( options.budget_seconds > 0 )
+    {
+      print_estimates(all_results, population);
+    }
+    if ( is_sweep && options.coordinator_address.empty() ) // the costs are only known where the variants execute
+    {
+      print_sweep_report(runs);
+    }
+    if ( options.measure_footprint )
+    {
+      print_footprint_report(runs);
+    }
+    if ( options.measure_latency )
+    {
+      print_latency_report(runs);
+    }
+  }
+  metrics_file.reset(); // writes the final metrics
+  if ( options.print_stats )
+  {
+    metrics->print_summary();
+  }
+  metrics.reset();
 }
 
-extern void evaluate_prebuilt_binaries(
-  const std::string &test_cases_dir_path,
-  const std::string &sanitizer_config,
-  bool print_table_summary,
-  bool run_all_variants,
-  bool verbose,
-  bool compute_baseline
-)
+extern void evaluate_prebuilt_binaries(const EvaluationOptions &options)
 {
-  if (verbose)
+  if (options.verbose)
   {
     Logger::allowed_log_level = log_level_t::VERBOSE;
   }
+  if ( options.json_log )
+  {
+    Logger::log_format = log_format_t::JSON_LINES;
+  }
   size_t variant_eval_counter = 0;
-  Sanitizer sanitizer{sanitizer_config};
+  Sanitizer sanitizer = load_sanitizer(options.sanitizer_configs.front());
+  if ( sanitizer.is_sweep() )
+  {
+    std::cerr << "ERROR: Sweeps over <env_var> values can only be evaluated with --evaluate. Aborting.\n";
+    exit(EXIT_FAILURE);
+  }
+  std::shared_ptr<SanitizerResults> results = std::make_shared<SanitizerResults>();
+  results->sanitizer_name = sanitizer.get_name();
 
-  const std::set<FileInfo> binary_files = get_binaries_from_dir(test_cases_dir_path);
+  const std::set<FileInfo> binary_files = get_binaries_from_dir(options.test_cases_dir_path);
 
   if (binary_files.empty())
   {
     std::cerr << "ERROR: No test files found. Aborting.\n";
     exit(EXIT_FAILURE);
   }
+  open_results_exporter(options);
 
-  std::map< std::string, std::vector<std::shared_ptr<TestCaseInformation>> > grouped_test_cases;
+  test_case_groups_t grouped_test_cases;
   for (const auto& binary_path : binary_files)
   {
     std::shared_ptr<TestCaseInformation> test_case_information = TestCaseInformation::construct_from_file_name(binary_path.name, binary_path.path, /*is_binary=*/true);
+    if ( !is_selected(options, test_case_information) )
+    {
+      continue;
+    }
     grouped_test_cases[test_case_information->get_test_case_key()].push_back(test_case_information);
   }
   for (auto& grouped_test_case : grouped_test_cases)
@@ -733,7 +2095,7 @@ extern void evaluate_prebuilt_binaries(
     std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos = grouped_test_case.second;
     std::sort(test_case_infos.begin(), test_case_infos.end(), compare_test_case_variants);
 
-    if (compute_baseline)
+    if (options.compute_baseline)
     {
       Logger(log_level_t::VERBOSE) << "Evaluating baseline: " << grouped_test_case.first << "\n";
       for (const auto& test_case_info : test_case_infos)
@@ -747,10 +2109,15 @@ extern void evaluate_prebuilt_binaries(
 
         std::string binary_path = test_case_info->get_file_path();
 
-        exec_result_t result = sanitizer.execute_baseline(binary_path);
+        TraceSpan variant_span("baseline variant", make_test_case_id(*test_case_info), sanitizer.get_name());
+        variant_stats_t stats;
+        const auto run_start = std::chrono::steady_clock::now();
+        exec_result_t result = sanitizer.execute_baseline(binary_path, nullptr, &stats.peak_memory_kb);
+        stats.run_seconds = seconds_since(run_start);
 
-        bool can_stop = collect_result(test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/true);
-        if (can_stop && !run_all_variants)
+        bool can_stop = collect_result(results->store, test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/true);
+        if ( results_exporter ) results_exporter->add_variant(sanitizer.get_name(), *test_case_info, /*is_baseline=*/true, result, &stats);
+        if (can_stop && !options.run_all_variants)
         {
           break;
         }
@@ -761,69 +2128,92 @@ extern void evaluate_prebuilt_binaries(
     for (const auto& test_case_info : test_case_infos)
     {
       std::string binary_path = test_case_info->get_file_path();
-      exec_result_t result = sanitizer.execute(binary_path);
-
-      bool can_stop;
-      if ( test_case_info->get_is_validation() )
-      {
-        // validation phase
-        can_stop = collect_validation_result(test_case_info, result, test_case_info->get_file_name());
-      }
-      else
-      {
-        // normal phase
-        can_stop = collect_result(test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/false);
-        variant_eval_counter++;
-      }
-      if (can_stop && !run_all_variants)
+      TraceSpan variant_span("variant", make_test_case_id(*test_case_info), sanitizer.get_name());
+      variant_stats_t stats;
+      const auto run_start = std::chrono::steady_clock::now();
+      exec_result_t result = sanitizer.execute(binary_path, nullptr, &stats.peak_memory_kb);
+      stats.run_seconds = seconds_since(run_start);
+      if ( results_exporter ) results_exporter->add_variant(sanitizer.get_name(), *test_case_info, /*is_baseline=*/false, result, &stats);
+
+      bool can_stop = collect_result(results->store, test_case_info, result, test_case_info->get_file_name(), /*is_baseline=*/false);
+      if ( !test_case_info->get_is_validation() ) variant_eval_counter++;
+      if (can_stop && !options.run_all_variants)
       {
         break;
       }
     }
   }
 
-  Logger(log_level_t::NORMAL) << "Evaluated " << grouped_test_cases.size() << " test cases, " << variant_eval_counter << " variants.\n";
-  collapse_results(compute_baseline);
-  process_results(print_table_summary, compute_baseline);
+  results->test_case_counter = grouped_test_cases.size();
+  results->variant_eval_counter = variant_eval_counter;
+  report_results({results}, options);
+}
+
+extern void merge_results(const EvaluationOptions &options)
+{
+  if (options.verbose)
+  {
+    Logger::allowed_log_level = log_level_t::VERBOSE;
+  }
+  if ( options.json_log )
+  {
+    Logger::log_format = log_format_t::JSON_LINES;
+  }
+  std::vector<std::shared_ptr<SanitizerResults>> all_results;
+  size_t files_with_baseline = 0;
+  for ( const auto &path: options.partial_results_paths )
+  {
+    files_with_baseline += load_results(path, all_results) ? 1 : 0;
+  }
+  if ( files_with_baseline != 0 && files_with_baseline != options.partial_results_paths.size() )
+  {
+    std::cerr << "ERROR: only some of the results include the baseline. Aborting.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  EvaluationOptions merged_options = options;
+  merged_options.compute_baseline = files_with_baseline != 0;
+  open_results_exporter(options);
+  report_results(all_results, merged_options);
 }
 
-extern void compile_all(
-  const std::string &generated_path,
-  const std::string &sanitizer_config,
-  bool verbose
-)
+extern void compile_all(const EvaluationOptions &options)
 {
-  if ( verbose )
+  if ( options.verbose )
   {
     Logger::allowed_log_level = log_level_t::VERBOSE;
   }
+  if ( options.json_log )
+  {
+    Logger::log_format = log_format_t::JSON_LINES;
+  }
 
   size_t total_counter = 0;
   size_t validation_counter = 0;
   size_t normal_counter = 0;
-  Sanitizer sanitizer{sanitizer_config};
+  Sanitizer sanitizer = load_sanitizer(options.sanitizer_configs.front());
 
-  const std::set<FileInfo> generated_files = get_sources_from_dir(generated_path);
+  const std::vector<std::shared_ptr<TestCaseInformation>> test_cases = get_test_cases(options);
 
-  if ( generated_files.empty() )
+  if ( test_cases.empty() )
   {
     std::cerr << "ERROR: No test files found. Aborting.\n";
     exit(EXIT_FAILURE);
   }
 
-  std::string dir_path = generated_path + "/" + TEST_CASE_BINARIES_DIR_NAME;
+  std::string dir_path = options.test_cases_dir_path + "/" + TEST_CASE_BINARIES_DIR_NAME;
+  const std::unique_ptr<Prelude> prelude = provide_prelude(test_cases);
+  if ( prelude ) sanitizer.add_include_dir(prelude->get_dir_path());
 
-  for ( auto &generated_file : generated_files )
+  for ( auto &test_case_information : test_cases )
   {
-    std::shared_ptr<TestCaseInformation> test_case_information = TestCaseInformation::construct_from_file_name(
-      generated_file.name, generated_file.path, /*is_binary=*/false);
-
     std::string binary_path = dir_path + "/" + test_case_information->get_file_name_without_suffix();
+    TraceSpan span("compile test case", make_test_case_id(*test_case_information), sanitizer.get_name());
 
-    Logger(log_level_t::VERBOSE) << "Compiling: " << generated_file.name << " -> " << binary_path << "\n";
-    if ( !sanitizer.compile( test_case_information->get_file_path(), binary_path ) )
+    Logger(log_level_t::VERBOSE) << "Compiling: " << test_case_information->get_file_name() << " -> " << binary_path << "\n";
+    if ( !compile_test_case( sanitizer, test_case_information, binary_path, /*is_baseline=*/false, options.in_memory ) )
     {
-      std::cerr << "Failed to compile baseline " << test_case_information->get_file_path() << '\n';
+      std::cerr << "Failed to compile baseline " << describe_source(test_case_information) << '\n';
       std::cerr << "Aborting.\n";
       exit(EXIT_FAILURE);
     }
@@ -833,13 +2223,13 @@ extern void compile_all(
     {
       total_counter++;
       normal_counter++;
-      Logger(log_level_t::VERBOSE) << "Compiling baseline for: " << generated_file.name << "\n";
+      Logger(log_level_t::VERBOSE) << "Compiling baseline for: " << test_case_information->get_file_name() << "\n";
 
       binary_path += "_baseline";
 
-      if ( !sanitizer.compile_baseline( test_case_information->get_file_path(), binary_path ) )
+      if ( !compile_test_case( sanitizer, test_case_information, binary_path, /*is_baseline=*/true, options.in_memory ) )
       {
-        std::cerr << "Failed to compile baseline " << test_case_information->get_file_path() << '\n';
+        std::cerr << "Failed to compile baseline " << describe_source(test_case_information) << '\n';
         std::cerr << "Aborting.\n";
         exit(EXIT_FAILURE);
       }
@@ -852,4 +2242,148 @@ extern void compile_all(
 
   Logger(log_level_t::NORMAL) << "Compiled " << total_counter << " files: " << normal_counter << " normal test cases, "
     << normal_counter << " baselines test cases and " << validation_counter << " validation test cases.\n";
-}
\ No newline at end of file
+}
+
+extern void run_worker(const EvaluationOptions &options)
+{
+  if ( options.verbose )
+  {
+    Logger::allowed_log_level = log_level_t::VERBOSE;
+  }
+  if ( options.json_log )
+  {
+    Logger::log_format = log_format_t::JSON_LINES;
+  }
+  std::vector<std::shared_ptr<SanitizerRun>> runs;
+  for ( const auto &sanitizer_config: options.sanitizer_configs )
+  {
+    for ( const Sanitizer &point: load_sanitizer(sanitizer_config).expand_sweep() )
+    {
+      runs.push_back(std::make_shared<SanitizerRun>(point));
+    }
+  }
+  const bool several_sanitizers = runs.size() > 1;
+
+  // jobs name test case groups, which must be found among the test cases of this worker
+  std::map<std::string, std::pair<std::string, std::vector<std::shared_ptr<TestCaseInformation>>>> groups_by_id; // key and variants
+  const std::vector<std::shared_ptr<TestCaseInformation>> test_cases = get_test_cases(options);
+  for ( const auto &test_case_information: test_cases )
+  {
+    auto &group = groups_by_id[make_test_case_group_id(*test_case_information)];
+    group.second.push_back(test_case_information);
+  }
+  for ( auto &group: groups_by_id )
+  {
+    std::sort(group.second.second.begin(), group.second.second.end(), compare_test_case_variants);
+    group.second.first = group.second.second.front()->get_test_case_key();
+  }
+
+  std::string scratch_dir;
+  const std::string binaries_dir = get_binaries_dir(options, scratch_dir);
+  std::unique_ptr<Prelude> prelude = provide_prelude(test_cases);
+  for ( const auto &run: runs )
+  {
+    if ( prelude ) run->sanitizer.add_include_dir(prelude->get_dir_path());
+    run->binaries_dir = several_sanitizers ? binaries_dir + "/" + run->sanitizer.get_name() : binaries_dir;
+    create_directory(run->binaries_dir);
+  }
+
+  if ( !options.no_dedup )
+  {
+    build_cache.reset(new BuildCache(binaries_dir + "/" + BUILD_CACHE_DIR_NAME));
+    for ( const auto &group: groups_by_id )
+    {
+      for ( const auto &test_case_info: group.second.second )
+      {
+        // before the threads start, so that they only read source_hashes in plan_builds()
+        source_hashes.emplace(test_case_info.get(), hash_test_case_source(*test_case_info));
+      }
+    }
+  }
+
+  // every thread pulls its jobs over its own connection, as a worker of its own
+  const std::string header = make_work_header(runs, options);
+  std::atomic<size_t> evaluated_jobs{0};
+  std::vector<std::thread> threads;
+  for ( size_t thread = 0; thread < options.jobs; thread++ )
+  {
+    threads.emplace_back([&]() {
+      std::unique_ptr<WorkerConnection> connection = WorkerConnection::connect(options.worker_address, header);
+      std::string job;
+      std::string group_id;
+      while ( connection && connection->next_job(job, group_id) )
+      {
+        const auto group = groups_by_id.find(group_id);
+        if ( group == groups_by_id.end() )
+        {
+          print_error("Test case " + group_id + " of the coordinator not found, the worker must evaluate the same test cases.\n");
+          return; // the coordinator requeues the job for another worker
+        }
+        const std::string &test_case_key = group->second.first;
+        const std::vector<std::shared_ptr<TestCaseInformation>> &test_case_infos = group->second.second;
+        job_results_t job_results;
+        if ( job == BASELINE_JOB )
+        {
+          plan_builds(runs[0]->sanitizer, test_case_infos, /*is_baseline=*/true);
+          evaluate_baseline(runs, binaries_dir, test_case_key, test_case_infos, options, &job_results);
+        }
+        else
+        {
+          SanitizerRun &run = *runs.at(std::stoul(job));
+          plan_builds(run.sanitizer, test_case_infos, /*is_baseline=*/false);
+          const std::string label = several_sanitizers ? " with " + run.sanitizer.get_name() : "";
+          evaluate_variants(run, job, label, test_case_key, test_case_infos, options, &job_results);
+        }
+        if ( !connection->send_results(job_results) ) return;
+        evaluated_jobs++;
+      }
+    });
+  }
+  for ( auto &thread: threads )
+  {
+    thread.join();
+  }
+  build_cache.reset();
+
+  prelude.reset();
+  if ( several_sanitizers )
+  {
+    for ( const auto &run: runs )
+    {
+      rmdir(run->binaries_dir.c_str());
+    }
+  }
+  if ( !scratch_dir.empty() )
+  {
+    rmdir(scratch_dir.c_str());
+  }
+  Logger(log_level_t::NORMAL) << "Evaluated " << evaluated_jobs << " jobs for the coordinator at " << options.worker_address << ".\n";
+}
+
+extern std::string preload(const EvaluationOptions &options)
+{
+  std::ostringstream description;
+  for ( const auto &config_path: options.sanitizer_configs )
+  {
+    Sanitizer sanitizer(config_path);
+    std::string real_path;
+    const std::string version = get_file_version(config_path, real_path);
+    resident_sanitizers.erase(real_path);
+    resident_sanitizers.emplace(real_path, ResidentSanitizer{version, sanitizer});
+    description << "Sanitizer " << sanitizer.get_name() << " from " << real_path << "\n";
+  }
+
+  std::string real_path;
+  const std::string version = get_file_version(get_suite_path(options), real_path);
+  if ( !version.empty() )
+  {
+    resident_suites.erase(real_path);
+    ResidentSuite suite;
+    suite.version = version;
+    suite.test_cases = load_test_cases(options);
+    suite.packed_suite = std::move(packed_suite);
+    description << suite.test_cases.size() << " test cases from " << real_path << "\n";
+    resident_suites.emplace(real_path, std::move(suite));
+  }
+  return description.str();
+}
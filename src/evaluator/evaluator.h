@@ -7,28 +7,91 @@
 
 #pragma once
 #include <string>
+#include <vector>
 
-extern void compile_and_evaluate(
-  const std::string &test_cases_dir_path,
-  const std::string &sanitizer_config,
-  bool print_table_summary,
-  bool run_all_variants,
-  bool verbose,
-  bool compute_baseline,
-  bool keep_binaries
-);
-
-extern void evaluate_prebuilt_binaries(
-  const std::string &test_cases_dir_path,
-  const std::string &sanitizer_config,
-  bool print_table_summary,
-  bool run_all_variants,
-  bool verbose,
-  bool compute_baseline
-);
-
-extern void compile_all(
-  const std::string &generated_path,
-  const std::string &sanitizer_config,
-  bool verbose
-);
+#include "generator/generator.h"
+
+class TestCaseSelector;
+
+struct EvaluationOptions
+{
+  std::string test_cases_dir_path;
+  std::vector<std::string> sanitizer_configs; // several only with compile_and_evaluate(), which evaluates them all at once
+  std::string packed_suite_path; // if set, the test cases are read from this packed suite instead of test_cases_dir_path
+  bool print_table_summary = false;
+  bool run_all_variants = false;
+  bool verbose = false;
+  bool json_log = false; // log records as JSON lines (see Logger)
+  bool print_stats = false; // print the time spent per phase and the compile and run latencies (see Metrics)
+  std::string metrics_path; // if set, the metrics are periodically written to this file in the Prometheus format
+  bool compute_baseline = false;
+  bool keep_binaries = false;
+  bool in_memory = false; // pipe sources to the compiler and keep the binaries in a tmpfs scratch directory
+  size_t jobs = 1;         // number of test cases compiled and executed concurrently by compile_and_evaluate()
+  size_t speculation = 1;  // number of variants of a test case evaluated concurrently, see evaluate_in_order()
+
+  // if set, these test cases (generated during this invocation) are used instead of any file
+  const std::vector<GeneratedTestCase> *generated_test_cases = nullptr;
+
+  // if set, only the selected test cases are compiled and evaluated
+  const TestCaseSelector *selector = nullptr;
+
+  // only the test cases of shard shard_index (of shard_count, see is_in_shard()) are compiled and evaluated
+  size_t shard_index = 0;
+  size_t shard_count = 1;
+
+  std::string results_path; // if set, the results are written to this file, to be combined by merge_results()
+  // if set, the result of each variant and, at the end, the aggregates are written to this file (see ResultsExporter)
+  std::string export_path;
+  std::vector<std::string> partial_results_paths; // the files combined by merge_results()
+
+  // if set, the results are appended to this journal as the variants finish (see Journal)
+  std::string journal_path;
+  bool resume = false; // continue the evaluation recorded in journal_path, skipping the test cases it finished
+
+  // if set, every variant is compiled and executed even if it builds like another one (see BuildCache)
+  bool no_dedup = false;
+
+  // if set, the sections and check sites of each binary are read and compared with its baseline binary (see read_binary_footprint())
+  bool measure_footprint = false;
+
+  // if set, the time from each test case triggering its bug until it terminated is measured for the detected variants (see Sanitizer::execute())
+  bool measure_latency = false;
+
+  // if set, the durations of the variants are recorded in this file and used to order the jobs (see DurationHistory)
+  std::string durations_path;
+
+  // if > 0, only a stratified sample of the test cases that fits in this many seconds is evaluated, see select_sample()
+  size_t budget_seconds = 0;
+
+  // if set, the build cache keeps all binaries and results for later evaluations of the same test cases (see preload())
+  bool keep_build_cache = false;
+
+  // if set, compile_and_evaluate() hands out its jobs to the workers connecting to this address (see WorkQueue)
+  std::string coordinator_address;
+  // the address of the coordinator that run_worker() evaluates jobs for
+  std::string worker_address;
+};
+
+extern void compile_and_evaluate(const EvaluationOptions &options);
+
+extern void evaluate_prebuilt_binaries(const EvaluationOptions &options);
+
+extern void compile_all(const EvaluationOptions &options);
+
+/**
+ * Evaluates the jobs of the coordinator at options.worker_address on options.jobs threads until it has none left.
+ */
+extern void run_worker(const EvaluationOptions &options);
+
+/**
+ * Combines the results written by several evaluations, e.g., of all shards, and reports them as a single evaluation.
+ */
+extern void merge_results(const EvaluationOptions &options);
+
+/**
+ * Parses the sanitizer configurations and indexes the test cases of options ahead of the evaluations, e.g., of the
+ * jobs forked by a daemon. The evaluations reuse them as long as their files are unchanged. Returns a description of
+ * what was loaded.
+ */
+extern std::string preload(const EvaluationOptions &options);
@@ -0,0 +1,205 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "journal.h"
+
+#include <cerrno>
+#include <cstdio>   // rename
+#include <cstring>  // strerror
+#include <fcntl.h>  // open
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <unistd.h> // write, fdatasync, close
+
+static const char JOURNAL_MAGIC[] = "mset_journal 1\n";
+static const size_t SYNC_RECORDS = 64;                     // records written before they are synced at the latest
+static const std::chrono::seconds SYNC_INTERVAL{1};       // time after which written records are synced at the latest, see Journal::sync_periodically()
+
+static bool write_all(int fd, const std::string &data)
+{
+  size_t written = 0;
+  while ( written < data.size() )
+  {
+    const ssize_t count = ::write(fd, data.data() + written, data.size() - written);
+    if ( count == -1 && errno == EINTR ) continue;
+    if ( count <= 0 ) return false;
+    written += static_cast<size_t>(count);
+  }
+  return true;
+}
+
+static std::string make_key(const std::string &job, const std::string &group_id)
+{
+  return job + " " + group_id;
+}
+
+static std::string make_result_record(const std::string &key, char phase, exec_result_t result)
+{
+  return "r " + key + " " + phase + " " + std::to_string(static_cast<int>(result)) + "\n";
+}
+
+/**
+ * Parses the complete records of a journal; a record cut short by the end of the file is discarded.
+ * Returns false on malformed records.
+ */
+static bool parse_records(std::istream &in, std::map<std::string, std::vector<std::pair<char, exec_result_t>>> &finished_jobs)
+{
+  std::map<std::string, std::vector<std::pair<char, exec_result_t>>> unfinished_jobs;
+  std::string line;
+  while ( std::getline(in, line) )
+  {
+    if ( in.eof() ) break; // no trailing newline, the process died while writing the record
+
+    std::istringstream record(line);
+    std::string type;
+    std::string job;
+    std::string group_id;
+    record >> type >> job >> group_id;
+    const std::string key = make_key(job, group_id);
+    if ( type == "d" && record )
+    {
+      finished_jobs[key] = std::move(unfinished_jobs[key]);
+      unfinished_jobs.erase(key);
+      continue;
+    }
+    char phase;
+    int result;
+    if ( type != "r" || !(record >> phase >> result)
+      || (phase != 'b' && phase != 'v' && phase != 'n') || result < 0 || result > RESOURCE_EXHAUSTED )
+    {
+      return false;
+    }
+    unfinished_jobs[key].emplace_back(phase, static_cast<exec_result_t>(result));
+  }
+  return true;
+}
+
+Journal::Journal(int fd, std::string path):
+  fd(fd), path(std::move(path)), sync_thread(&Journal::sync_periodically, this)
+{
+}
+
+Journal::~Journal()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    closing = true;
+  }
+  closing_changed.notify_one();
+  sync_thread.join();
+  if ( unsynced_records > 0 ) fdatasync(fd);
+  close(fd);
+}
+
+/**
+ * Syncs the written records every SYNC_INTERVAL, so that they are on disk by then even if no further record is
+ * appended, e.g., while a long variant runs.
+ */
+void Journal::sync_periodically()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while ( !closing_changed.wait_for(lock, SYNC_INTERVAL, [this]() { return closing; }) )
+  {
+    if ( unsynced_records == 0 ) continue;
+    fdatasync(fd);
+    unsynced_records = 0;
+  }
+}
+
+std::unique_ptr<Journal> Journal::open(const std::string &path, const std::string &header, bool resume)
+{
+  const std::string full_header = JOURNAL_MAGIC + header;
+  std::map<std::string, std::vector<std::pair<char, exec_result_t>>> finished_jobs;
+
+  std::ifstream existing(path);
+  if ( existing && existing.peek() != std::ifstream::traits_type::eof() )
+  {
+    if ( !resume )
+    {
+      std::cerr << "ERROR: journal " << path << " already exists. Use --resume to continue its evaluation.\n";
+      return nullptr;
+    }
+    std::string existing_header(full_header.size(), '\0');
+    if ( !existing.read(&existing_header[0], static_cast<std::streamsize>(existing_header.size())) || existing_header != full_header )
+    {
+      std::cerr << "ERROR: journal " << path << " was written by an evaluation with other options or sanitizers.\n";
+      return nullptr;
+    }
+    if ( !parse_records(existing, finished_jobs) )
+    {
+      std::cerr << "ERROR: malformed record in journal " << path << ".\n";
+      return nullptr;
+    }
+  }
+  existing.close();
+
+  // the records of unfinished jobs are dropped by rewriting the journal, they are written again when the jobs rerun
+  std::string content = full_header;
+  for ( const auto &finished_job: finished_jobs )
+  {
+    for ( const auto &result: finished_job.second )
+    {
+      content += make_result_record(finished_job.first, result.first, result.second);
+    }
+    content += "d " + finished_job.first + "\n";
+  }
+  const std::string temporary_path = path + ".tmp";
+  int fd = ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if ( fd == -1 || !write_all(fd, content) || fdatasync(fd) != 0 || close(fd) != 0 || rename(temporary_path.c_str(), path.c_str()) != 0 )
+  {
+    std::cerr << "Error writing journal " << path << ": " << std::strerror(errno) << '\n';
+    return nullptr;
+  }
+
+  fd = ::open(path.c_str(), O_WRONLY | O_APPEND);
+  if ( fd == -1 )
+  {
+    std::cerr << "Error opening journal " << path << ": " << std::strerror(errno) << '\n';
+    return nullptr;
+  }
+  std::unique_ptr<Journal> journal(new Journal(fd, path));
+  journal->finished_jobs = std::move(finished_jobs);
+  return journal;
+}
+
+void Journal::add(const std::string &job, const std::string &group_id, char phase, exec_result_t result)
+{
+  append(make_result_record(make_key(job, group_id), phase, result));
+}
+
+void Journal::finish(const std::string &job, const std::string &group_id)
+{
+  append("d " + make_key(job, group_id) + "\n");
+}
+
+void Journal::append(const std::string &record)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  if ( !write_all(fd, record) )
+  {
+    std::cerr << "Error writing journal " << path << ": " << std::strerror(errno) << '\n';
+    exit(EXIT_FAILURE);
+  }
+  unsynced_records++;
+  if ( unsynced_records >= SYNC_RECORDS )
+  {
+    fdatasync(fd);
+    unsynced_records = 0;
+  }
+}
+
+bool Journal::replay(const std::string &job, const std::string &group_id, const std::function<void(char, exec_result_t)> &replay_result) const
+{
+  const auto finished_job = finished_jobs.find(make_key(job, group_id));
+  if ( finished_job == finished_jobs.end() ) return false;
+  for ( const auto &result: finished_job->second )
+  {
+    replay_result(result.first, result.second);
+  }
+  return true;
+}
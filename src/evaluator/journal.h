@@ -0,0 +1,67 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "evaluator/sanitizer.h"
+
+/**
+ * Append-only log of the variant results of an evaluation, so that an interrupted evaluation can be resumed.
+ *
+ * Each result is appended as soon as the variant finishes, and each job (the baseline or one sanitizer evaluating a
+ * test case) is marked as done once all its variants finished:
+ *   r <job> <test case group ID> <b|v|n> <exec_result_t>
+ *   d <job> <test case group ID>
+ * where b, v and n stand for the baseline, validation and normal phases. Records are written with a single write()
+ * each, so they survive the process being killed; they are synced to disk in batches, and by a background thread
+ * at most a second after they were written.
+ */
+class Journal
+{
+public:
+  ~Journal();
+  Journal(const Journal &) = delete;
+  Journal &operator=(const Journal &) = delete;
+
+  /**
+   * Opens the journal at path, describing the evaluation by header. With resume, an existing journal must have the
+   * same header; the results of its finished jobs are kept and the others discarded. Without resume, an existing
+   * journal must be empty. Returns nullptr on errors.
+   */
+  static std::unique_ptr<Journal> open(const std::string &path, const std::string &header, bool resume);
+
+  void add(const std::string &job, const std::string &group_id, char phase, exec_result_t result);
+  void finish(const std::string &job, const std::string &group_id);
+
+  /**
+   * Calls replay_result for each result of a job finished before resuming. Returns false if the job is not finished.
+   */
+  bool replay(const std::string &job, const std::string &group_id, const std::function<void(char, exec_result_t)> &replay_result) const;
+
+private:
+  Journal(int fd, std::string path);
+  void append(const std::string &record);
+  void sync_periodically();
+
+  int fd;
+  std::string path;
+  std::mutex mutex;
+  size_t unsynced_records = 0;
+  bool closing = false;
+  std::condition_variable closing_changed;
+  std::thread sync_thread; // see sync_periodically()
+  std::map<std::string, std::vector<std::pair<char, exec_result_t>>> finished_jobs; // results per "<job> <group ID>"
+};
@@ -0,0 +1,173 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "logger.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+log_level_t Logger::allowed_log_level = log_level_t::NORMAL;
+log_format_t Logger::log_format = log_format_t::TEXT;
+
+static const std::chrono::milliseconds FLUSH_INTERVAL{100}; // time after which logged records are written at the latest
+static const size_t FLUSH_SIZE = 64 * 1024;                // pending size after which records are written right away
+
+/**
+ * The background thread writing the records, started with the first record and stopped when the process exits.
+ */
+class LogSink
+{
+public:
+  LogSink(): start(std::chrono::steady_clock::now()), thread(&LogSink::run, this) { }
+
+  ~LogSink()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    wake_up.notify_one();
+    thread.join();
+    flush();
+  }
+
+  /**
+   * Adds the records of complete lines, each ending with a newline.
+   */
+  void add(log_level_t log_level, size_t thread_id, const std::string &lines)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if ( Logger::log_format == log_format_t::JSON_LINES )
+    {
+      for ( size_t begin = 0, end; (end = lines.find('\n', begin)) != std::string::npos; begin = end + 1 )
+      {
+        if ( end == begin ) continue; // the blank lines separating sections of the text format
+        add_json_record(log_level, thread_id, lines.substr(begin, end - begin));
+      }
+    }
+    else
+    {
+      pending += lines;
+    }
+    if ( pending.size() >= FLUSH_SIZE ) wake_up.notify_one();
+  }
+
+  void flush()
+  {
+    std::lock_guard<std::mutex> write_lock(write_mutex);
+    std::string batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      batch.swap(pending);
+    }
+    write(batch);
+  }
+
+private:
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while ( !stopping )
+    {
+      wake_up.wait_for(lock, FLUSH_INTERVAL, [this]() { return stopping || pending.size() >= FLUSH_SIZE; });
+      if ( pending.empty() ) continue;
+      lock.unlock();
+      flush();
+      lock.lock();
+    }
+  }
+
+  static void write(const std::string &batch)
+  {
+    if ( batch.empty() ) return;
+    std::cout.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+    std::cout.flush();
+  }
+
+  void add_json_record(log_level_t log_level, size_t thread_id, const std::string &line)
+  {
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    char time[32];
+    std::snprintf(time, sizeof(time), "%.3f", seconds);
+    pending += "{\"time\":";
+    pending += time;
+    pending += ",\"level\":\"";
+    pending += log_level == log_level_t::VERBOSE ? "verbose" : "normal";
+    pending += "\",\"thread\":";
+    pending += std::to_string(thread_id);
+    pending += ",\"message\":\"";
+    for ( const char c: line )
+    {
+      if ( c == '"' || c == '\\' )
+      {
+        pending += '\\';
+        pending += c;
+      }
+      else if ( static_cast<unsigned char>(c) < 0x20 )
+      {
+        char escaped[8];
+        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+        pending += escaped;
+      }
+      else
+      {
+        pending += c;
+      }
+    }
+    pending += "\"}\n";
+  }
+
+  std::chrono::steady_clock::time_point start;
+  std::mutex mutex;       // guards pending and stopping
+  std::mutex write_mutex; // keeps the batches in order
+  std::condition_variable wake_up;
+  std::string pending;
+  bool stopping = false;
+  std::thread thread;
+};
+
+static LogSink &get_sink()
+{
+  static LogSink sink; // thread-safe initialization, destroyed, i.e., flushed, at exit
+  return sink;
+}
+
+static size_t get_thread_id()
+{
+  static std::atomic<size_t> thread_count{0};
+  thread_local const size_t thread_id = thread_count++;
+  return thread_id;
+}
+
+std::ostringstream &Logger::get_thread_buffer()
+{
+  thread_local std::ostringstream buffer;
+  return buffer;
+}
+
+void Logger::flush()
+{
+  get_sink().flush();
+}
+
+void Logger::commit_lines(log_level_t log_level)
+{
+  std::ostringstream &buffer = get_thread_buffer();
+  const std::string content = buffer.str();
+  const size_t end = content.rfind('\n');
+  if ( end == std::string::npos ) return; // the line is continued by the next logger of this thread
+
+  get_sink().add(log_level, get_thread_id(), content.substr(0, end + 1));
+  buffer.str(content.substr(end + 1));
+  buffer.seekp(0, std::ios::end);
+}
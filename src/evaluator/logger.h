@@ -6,8 +6,17 @@
  */
 
 #pragma once
+#include <sstream>
+#include <string>
 
-
+/**
+ * Logs to std::cout through a background thread, so that logging costs no system calls on the evaluating threads.
+ *
+ * Each thread collects the fragments it logs in its own buffer; every complete line is then handed to the background
+ * thread as one record, so lines of concurrent threads never interleave. The background thread writes the records in
+ * batches, at the latest after a short interval, and when the process exits. In the JSON lines format, each record is
+ * written as an object with the time since the start, the log level, the logging thread and the line.
+ */
 class Logger
 {
 public:
@@ -17,26 +26,53 @@ public:
     NORMAL = 1,
     VERBOSE = 2,
   };
+  enum class _log_format_t
+  {
+    TEXT,
+    JSON_LINES,
+  };
   static _log_level_t allowed_log_level;
+  static _log_format_t log_format;
 
   explicit Logger(_log_level_t log_level):
     log_level(log_level)
   {
   }
 
+  ~Logger()
+  {
+    if (log_level <= allowed_log_level) commit_lines(log_level);
+  }
+
+  Logger(const Logger &) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  /**
+   * Writes the records handed to the background thread so far, e.g., before a child process writes to the terminal,
+   * so that they precede its output.
+   */
+  static void flush();
+
   template<class T>
   Logger &operator<<(const T &message)
   {
     if (log_level <= allowed_log_level)
     {
-      std::cout << message; // always log
-      std::cout.flush();
+      get_thread_buffer() << message;
     }
     return *this;
   }
 
 private:
+  static std::ostringstream &get_thread_buffer();
+
+  /**
+   * Hands the complete lines of the buffer of the calling thread to the background thread.
+   */
+  static void commit_lines(_log_level_t log_level);
+
   _log_level_t log_level;
 };
 
 using log_level_t = Logger::_log_level_t;
+using log_format_t = Logger::_log_format_t;
@@ -0,0 +1,193 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <cstdio> // rename
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "evaluator/logger.h"
+
+const std::array<double, Histogram::BUCKET_COUNT - 1> Histogram::UPPER_BOUNDS = {
+  0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60
+};
+
+static const std::chrono::seconds METRICS_FILE_INTERVAL{5}; // time between two rewrites of the metrics file
+
+static const char *const PHASE_NAMES[] = {"scan", "parse_configs", "plan", "evaluate", "aggregate"};
+
+void Histogram::add(double seconds)
+{
+  const size_t bucket = static_cast<size_t>(std::lower_bound(UPPER_BOUNDS.begin(), UPPER_BOUNDS.end(), seconds) - UPPER_BOUNDS.begin());
+  buckets[bucket]++;
+  count++;
+  sum_us += static_cast<uint64_t>(seconds * 1e6);
+}
+
+double Histogram::estimate_quantile(double q) const
+{
+  const double rank = q * static_cast<double>(count);
+  uint64_t below = 0;
+  for ( size_t bucket = 0; bucket < BUCKET_COUNT; bucket++ )
+  {
+    const uint64_t in_bucket = buckets[bucket];
+    if ( in_bucket > 0 && static_cast<double>(below + in_bucket) >= rank )
+    {
+      if ( bucket == BUCKET_COUNT - 1 ) return UPPER_BOUNDS.back(); // unbounded, at least the last bound
+      const double lower = bucket == 0 ? 0 : UPPER_BOUNDS[bucket - 1];
+      return lower + (UPPER_BOUNDS[bucket] - lower) * (rank - static_cast<double>(below)) / static_cast<double>(in_bucket);
+    }
+    below += in_bucket;
+  }
+  return 0;
+}
+
+void Metrics::add_phase(phase_t phase, double seconds)
+{
+  phase_us[static_cast<size_t>(phase)] += static_cast<uint64_t>(seconds * 1e6);
+}
+
+void Metrics::finish_job(double seconds)
+{
+  busy_us += static_cast<uint64_t>(seconds * 1e6);
+  busy_workers--;
+  jobs_finished++;
+}
+
+double Metrics::get_elapsed() const
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+double Metrics::estimate_remaining() const
+{
+  const size_t finished = jobs_finished;
+  if ( finished == 0 ) return 0;
+  // the remaining jobs take as long as the finished ones on average, spread over all workers
+  const double seconds_per_job = static_cast<double>(busy_us) / 1e6 / static_cast<double>(finished);
+  return seconds_per_job * static_cast<double>(jobs_total - finished) / static_cast<double>(workers);
+}
+
+static void write_histogram(std::ostream &out, const std::string &name, const std::string &help, const Histogram &histogram)
+{
+  out << "# HELP " << name << " " << help << "\n";
+  out << "# TYPE " << name << " histogram\n";
+  uint64_t cumulative = 0;
+  for ( size_t bucket = 0; bucket < Histogram::BUCKET_COUNT; bucket++ )
+  {
+    cumulative += histogram.get_bucket(bucket);
+    out << name << "_bucket{le=\"";
+    if ( bucket < Histogram::UPPER_BOUNDS.size() ) out << Histogram::UPPER_BOUNDS[bucket];
+    else out << "+Inf";
+    out << "\"} " << cumulative << "\n";
+  }
+  out << name << "_sum " << histogram.get_sum() << "\n";
+  out << name << "_count " << histogram.get_count() << "\n";
+}
+
+static void write_gauge(std::ostream &out, const std::string &name, const std::string &help, double value)
+{
+  out << "# HELP " << name << " " << help << "\n";
+  out << "# TYPE " << name << " gauge\n";
+  out << name << " " << value << "\n";
+}
+
+void Metrics::write_prometheus(std::ostream &out) const
+{
+  const double elapsed = get_elapsed();
+  out << "# HELP mset_phase_seconds Wall time spent in each phase of the evaluation.\n";
+  out << "# TYPE mset_phase_seconds gauge\n";
+  for ( size_t phase = 0; phase < static_cast<size_t>(phase_t::COUNT); phase++ )
+  {
+    out << "mset_phase_seconds{phase=\"" << PHASE_NAMES[phase] << "\"} " << static_cast<double>(phase_us[phase]) / 1e6 << "\n";
+  }
+  write_histogram(out, "mset_compile_seconds", "Latency of compiling a variant.", compile_latencies);
+  write_histogram(out, "mset_run_seconds", "Latency of executing a variant, including spawning its processes.", run_latencies);
+  write_gauge(out, "mset_elapsed_seconds", "Time since the evaluation started.", elapsed);
+  write_gauge(out, "mset_jobs_total", "Jobs, i.e., test cases evaluated by one sanitizer or the baseline.", static_cast<double>(jobs_total));
+  write_gauge(out, "mset_jobs_finished", "Jobs finished.", static_cast<double>(jobs_finished));
+  write_gauge(out, "mset_jobs_queued", "Jobs not started yet.", static_cast<double>(jobs_total - jobs_started));
+  write_gauge(out, "mset_workers", "Threads evaluating jobs.", static_cast<double>(workers));
+  write_gauge(out, "mset_workers_busy", "Threads currently evaluating a job.", static_cast<double>(busy_workers));
+  const double busy = static_cast<double>(busy_us) / 1e6;
+  write_gauge(out, "mset_worker_utilization", "Fraction of the elapsed time the threads spent in finished jobs.",
+              elapsed > 0 ? busy / (elapsed * static_cast<double>(workers)) : 0);
+  write_gauge(out, "mset_variants_per_second", "Variants executed per second since the start.",
+              elapsed > 0 ? static_cast<double>(run_latencies.get_count()) / elapsed : 0);
+  write_gauge(out, "mset_eta_seconds", "Expected time until all jobs are finished.", estimate_remaining());
+}
+
+void Metrics::print_summary() const
+{
+  std::ostringstream summary;
+  summary << std::fixed << std::setprecision(3);
+  summary << "==============================\n\n";
+  summary << "Statistics:\n";
+  summary << "Wall time per phase:\n";
+  for ( size_t phase = 0; phase < static_cast<size_t>(phase_t::COUNT); phase++ )
+  {
+    summary << "- " << PHASE_NAMES[phase] << ": " << static_cast<double>(phase_us[phase]) / 1e6 << " s\n";
+  }
+  auto print_latencies = [&summary](const std::string &name, const Histogram &histogram) {
+    summary << name << " latency: " << histogram.get_count() << " in " << histogram.get_sum() << " s";
+    if ( histogram.get_count() > 0 )
+    {
+      summary << ", mean " << histogram.get_sum() / static_cast<double>(histogram.get_count()) << " s, p50 "
+        << histogram.estimate_quantile(0.5) << " s, p90 " << histogram.estimate_quantile(0.9) << " s, p99 "
+        << histogram.estimate_quantile(0.99) << " s";
+    }
+    summary << "\n";
+  };
+  print_latencies("Compile", compile_latencies);
+  print_latencies("Run", run_latencies);
+  const double evaluate_seconds = static_cast<double>(phase_us[static_cast<size_t>(phase_t::EVALUATE)]) / 1e6;
+  if ( evaluate_seconds > 0 )
+  {
+    summary << "Throughput: " << static_cast<double>(run_latencies.get_count()) / evaluate_seconds << " variants/s, "
+      << static_cast<double>(jobs_finished) / evaluate_seconds << " jobs/s\n";
+    summary << "Worker utilization: " << std::setprecision(1)
+      << static_cast<double>(busy_us) / 1e6 * 100 / (evaluate_seconds * static_cast<double>(workers)) << "% of " << workers << " thread(s)\n";
+  }
+  Logger(log_level_t::NORMAL) << summary.str();
+}
+
+MetricsFileWriter::MetricsFileWriter(const Metrics &metrics, std::string path):
+  metrics(metrics), path(std::move(path))
+{
+  thread = std::thread([this]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while ( !wake_up.wait_for(lock, METRICS_FILE_INTERVAL, [this]() { return stopping; }) )
+    {
+      write();
+    }
+  });
+}
+
+MetricsFileWriter::~MetricsFileWriter()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake_up.notify_one();
+  thread.join();
+  write();
+}
+
+void MetricsFileWriter::write() const
+{
+  const std::string tmp_path = path + ".tmp";
+  {
+    std::ofstream file(tmp_path, std::ios::trunc);
+    metrics.write_prometheus(file);
+    if ( !file.flush() ) return;
+  }
+  rename(tmp_path.c_str(), path.c_str());
+}
@@ -0,0 +1,154 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * Distribution of latencies in fixed buckets, as in the Prometheus histogram type. Safe to update concurrently.
+ */
+class Histogram
+{
+public:
+  static constexpr size_t BUCKET_COUNT = 16; // the last one is unbounded
+  static const std::array<double, BUCKET_COUNT - 1> UPPER_BOUNDS; // in seconds
+
+  void add(double seconds);
+
+  uint64_t get_count() const { return count; }
+  double get_sum() const { return static_cast<double>(sum_us) / 1e6; }
+  uint64_t get_bucket(size_t bucket) const { return buckets[bucket]; }
+
+  /**
+   * Estimates the q-quantile, interpolating linearly within its bucket.
+   */
+  double estimate_quantile(double q) const;
+
+private:
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> sum_us{0};
+};
+
+enum class phase_t
+{
+  SCAN,          // finding and reading the test cases
+  PARSE_CONFIGS, // parsing the sanitizer configurations
+  PLAN,          // hashing sources and scheduling the jobs
+  EVALUATE,      // compiling and executing the variants on all threads
+  AGGREGATE,     // computing and printing the results
+  COUNT
+};
+
+/**
+ * Instrumentation of an evaluation: the wall time of each phase, the latencies of compiling and executing a variant,
+ * and the progress of the jobs on the scheduler's threads.
+ */
+class Metrics
+{
+public:
+  Metrics(): start(std::chrono::steady_clock::now()) { }
+
+  void add_phase(phase_t phase, double seconds);
+
+  Histogram &get_compile_latencies() { return compile_latencies; }
+  Histogram &get_run_latencies() { return run_latencies; }
+
+  void set_workers(size_t worker_count) { workers = worker_count; }
+  void add_jobs(size_t job_count) { jobs_total += job_count; }
+  void start_job() { jobs_started++; busy_workers++; }
+  void finish_job(double seconds);
+
+  /**
+   * Writes all metrics in the Prometheus text exposition format.
+   */
+  void write_prometheus(std::ostream &out) const;
+
+  /**
+   * Prints a summary of the metrics, see --stats.
+   */
+  void print_summary() const;
+
+private:
+  double get_elapsed() const;
+  double estimate_remaining() const;
+
+  std::chrono::steady_clock::time_point start;
+  std::array<std::atomic<uint64_t>, static_cast<size_t>(phase_t::COUNT)> phase_us{};
+  Histogram compile_latencies;
+  Histogram run_latencies;
+  std::atomic<size_t> workers{1};
+  std::atomic<size_t> jobs_total{0};
+  std::atomic<size_t> jobs_started{0};
+  std::atomic<size_t> jobs_finished{0};
+  std::atomic<size_t> busy_workers{0};
+  std::atomic<uint64_t> busy_us{0};
+};
+
+/**
+ * Measures the wall time of a phase until it goes out of scope.
+ */
+class PhaseTimer
+{
+public:
+  PhaseTimer(Metrics &metrics, phase_t phase): metrics(metrics), phase(phase), start(std::chrono::steady_clock::now()) { }
+  ~PhaseTimer() { metrics.add_phase(phase, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()); }
+  PhaseTimer(const PhaseTimer &) = delete;
+  PhaseTimer &operator=(const PhaseTimer &) = delete;
+
+private:
+  Metrics &metrics;
+  phase_t phase;
+  std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Counts a job as running on one of the scheduler's threads until it goes out of scope.
+ */
+class JobTimer
+{
+public:
+  explicit JobTimer(Metrics &metrics): metrics(metrics), start(std::chrono::steady_clock::now()) { metrics.start_job(); }
+  ~JobTimer() { metrics.finish_job(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()); }
+  JobTimer(const JobTimer &) = delete;
+  JobTimer &operator=(const JobTimer &) = delete;
+
+private:
+  Metrics &metrics;
+  std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Rewrites a metrics file periodically from a background thread, and a last time when destroyed. The file is replaced
+ * atomically, so that a scraper never reads a partial file.
+ */
+class MetricsFileWriter
+{
+public:
+  MetricsFileWriter(const Metrics &metrics, std::string path);
+  ~MetricsFileWriter();
+  MetricsFileWriter(const MetricsFileWriter &) = delete;
+  MetricsFileWriter &operator=(const MetricsFileWriter &) = delete;
+
+private:
+  void write() const;
+
+  const Metrics &metrics;
+  std::string path;
+  std::mutex mutex;
+  std::condition_variable wake_up;
+  bool stopping = false;
+  std::thread thread;
+};
@@ -0,0 +1,74 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "prelude.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>  // remove
+#include <cstdlib> // getenv, mkdtemp
+#include <cstring> // strerror
+#include <fstream>
+#include <unistd.h> // rmdir
+#include <vector>
+
+#include "generator/code_canvas.h"
+
+static const size_t SEARCHED_BYTES = 4096; // the include follows at most the comments describing the test case
+
+static const std::string &get_include_line()
+{
+  static const std::string include_line = "#include \"" + CodeCanvas::PRELUDE_FILE_NAME + "\"";
+  return include_line;
+}
+
+Prelude::~Prelude()
+{
+  remove((dir_path + "/" + CodeCanvas::PRELUDE_FILE_NAME).c_str());
+  rmdir(dir_path.c_str());
+}
+
+bool Prelude::is_included(const char *source, size_t source_length)
+{
+  const char *end = source + std::min(source_length, SEARCHED_BYTES);
+  const std::string &include_line = get_include_line();
+  return std::search(source, end, include_line.begin(), include_line.end()) != end;
+}
+
+bool Prelude::is_included(const TestCaseInformation &test_case_info)
+{
+  if ( test_case_info.has_source_in_memory() )
+  {
+    return is_included(test_case_info.get_source(), test_case_info.get_source_length());
+  }
+  std::ifstream file(test_case_info.get_file_path());
+  std::vector<char> start(SEARCHED_BYTES);
+  file.read(start.data(), static_cast<std::streamsize>(start.size()));
+  return is_included(start.data(), static_cast<size_t>(file.gcount()));
+}
+
+std::unique_ptr<Prelude> Prelude::write(std::string &error)
+{
+  const char *tmp_dir = std::getenv("TMPDIR");
+  std::string dir_template = std::string(tmp_dir && *tmp_dir ? tmp_dir : "/tmp") + "/mset-prelude-XXXXXX";
+  if ( !mkdtemp(&dir_template[0]) )
+  {
+    error = "Error creating a directory for the prelude: " + dir_template + ": " + std::strerror(errno) + "\n";
+    return nullptr;
+  }
+  std::unique_ptr<Prelude> prelude(new Prelude(dir_template));
+  const std::string prelude_path = dir_template + "/" + CodeCanvas::PRELUDE_FILE_NAME;
+  std::ofstream file(prelude_path);
+  file << CodeCanvas::get_prelude_header();
+  file.close();
+  if ( !file )
+  {
+    error = "Error writing file: " + prelude_path + ": " + std::strerror(errno) + "\n";
+    return nullptr;
+  }
+  return prelude;
+}
@@ -0,0 +1,47 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <memory>
+#include <string>
+
+#include "evaluator/test_case_information.h"
+
+/**
+ * The shared prelude that compact test cases include instead of repeating it, see --compact. An evaluation of compact
+ * test cases writes it into a temporary directory of its own, which it adds to the include path of its sanitizers, so
+ * that concurrent evaluations of the same test cases do not share, or remove, the prelude of another. The compile
+ * commands of test cases that do not include it are left unchanged.
+ */
+class Prelude
+{
+public:
+  ~Prelude(); // removes the directory
+  Prelude(const Prelude &) = delete;
+  Prelude &operator=(const Prelude &) = delete;
+
+  /**
+   * Whether source includes the prelude. The include precedes the code, so only the start of source is searched.
+   */
+  static bool is_included(const char *source, size_t source_length);
+  /**
+   * Whether the source of a test case includes the prelude, held in memory or read from its file.
+   */
+  static bool is_included(const TestCaseInformation &test_case_info);
+
+  /**
+   * Writes the prelude into a new temporary directory. Returns nullptr and sets error on failure.
+   */
+  static std::unique_ptr<Prelude> write(std::string &error);
+
+  const std::string &get_dir_path() const { return dir_path; }
+
+private:
+  explicit Prelude(std::string dir_path): dir_path(std::move(dir_path)) { }
+
+  std::string dir_path;
+};
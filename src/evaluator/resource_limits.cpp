@@ -0,0 +1,171 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "resource_limits.h"
+
+#include <atomic>
+#include <cerrno>
+#include <fstream>
+#include <iostream>
+#include <mutex>  // call_once
+#include <sstream>
+#include <sys/resource.h> // setrlimit
+#include <sys/stat.h>     // mkdir
+#include <unistd.h>       // getpid, rmdir, access
+
+static const char EVALUATOR_LEAF[] = "mset"; // the evaluator's own leaf cgroup
+
+static bool write_file(const std::string &path, const std::string &value)
+{
+  std::ofstream file(path);
+  file << value;
+  return static_cast<bool>(file.flush());
+}
+
+static std::string read_file(const std::string &path)
+{
+  std::ifstream file(path);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+static bool has_word(const std::string &words, const std::string &word)
+{
+  std::istringstream stream(words);
+  std::string next;
+  while ( stream >> next )
+  {
+    if ( next == word ) return true;
+  }
+  return false;
+}
+
+/**
+ * Finds the cgroup v2 of the evaluator and enables the memory controller for its children, moving the evaluator
+ * into a leaf child first, since a cgroup with processes cannot enable controllers. Returns an empty path if that is
+ * not possible, e.g., on cgroup v1 or without delegation.
+ */
+static std::string set_up_parent_cgroup()
+{
+  std::string mount_point;
+  std::ifstream mounts("/proc/self/mountinfo");
+  std::string line;
+  while ( mount_point.empty() && std::getline(mounts, line) )
+  {
+    // <id> <parent id> <major:minor> <root> <mount point> <options> <optional fields...> - <type> <source> <options>
+    std::istringstream fields(line);
+    std::string field;
+    std::string point;
+    for ( int i = 0; i < 5 && fields >> field; i++ )
+    {
+      point = field;
+    }
+    while ( fields >> field && field != "-" ) { }
+    if ( fields >> field && field == "cgroup2" ) mount_point = point;
+  }
+  if ( mount_point.empty() ) return "";
+
+  std::string own_path;
+  std::ifstream cgroups("/proc/self/cgroup");
+  while ( std::getline(cgroups, line) )
+  {
+    if ( line.compare(0, 3, "0::") == 0 ) own_path = line.substr(3);
+  }
+  if ( own_path.empty() ) return "";
+  std::string parent = mount_point + (own_path == "/" ? "" : own_path);
+  const std::string leaf_suffix = std::string("/") + EVALUATOR_LEAF;
+  if ( parent.size() > leaf_suffix.size() && parent.compare(parent.size() - leaf_suffix.size(), leaf_suffix.size(), leaf_suffix) == 0 )
+  {
+    parent.erase(parent.size() - leaf_suffix.size()); // already moved, e.g., by the evaluator that started this one
+    if ( has_word(read_file(parent + "/cgroup.subtree_control"), "memory") ) return parent;
+  }
+
+  if ( has_word(read_file(parent + "/cgroup.subtree_control"), "memory") ) return parent;
+  if ( !has_word(read_file(parent + "/cgroup.controllers"), "memory") || access(parent.c_str(), W_OK) != 0 ) return "";
+  const std::string leaf = parent + "/" + EVALUATOR_LEAF;
+  if ( mkdir(leaf.c_str(), 0755) != 0 && errno != EEXIST ) return "";
+  if ( !write_file(leaf + "/cgroup.procs", "0") ) return "";
+  if ( !write_file(parent + "/cgroup.subtree_control", "+memory") )
+  {
+    write_file(parent + "/cgroup.procs", "0"); // other processes share the cgroup, undo the move
+    rmdir(leaf.c_str());
+    return "";
+  }
+  return parent;
+}
+
+static const std::string &get_parent_cgroup()
+{
+  static const std::string parent = set_up_parent_cgroup(); // thread-safe initialization
+  return parent;
+}
+
+ExecutionCgroup::ExecutionCgroup(const resource_limits_t &limits)
+{
+  if ( !limits.limits_memory() ) return;
+  if ( get_parent_cgroup().empty() )
+  {
+    static std::once_flag warned;
+    std::call_once(warned, []() {
+      std::cerr << "WARNING: memory_limit_mb is ignored, since the cgroup of MSET is not delegated with the memory controller available.\n";
+    });
+    return;
+  }
+  static std::atomic<size_t> counter{0};
+  const std::string new_path = get_parent_cgroup() + "/test_" + std::to_string(getpid()) + "_" + std::to_string(counter++);
+  if ( mkdir(new_path.c_str(), 0755) != 0 ) return;
+  if ( !write_file(new_path + "/memory.max", std::to_string(limits.memory_limit_mb * 1024 * 1024)) )
+  {
+    rmdir(new_path.c_str());
+    return;
+  }
+  write_file(new_path + "/memory.swap.max", "0"); // absent without swap accounting
+  path = new_path;
+}
+
+ExecutionCgroup::~ExecutionCgroup()
+{
+  if ( is_active() ) rmdir(path.c_str()); // all its processes are collected by now
+}
+
+void ExecutionCgroup::join() const
+{
+  if ( is_active() ) write_file(path + "/cgroup.procs", "0");
+}
+
+bool ExecutionCgroup::was_oom_killed() const
+{
+  if ( !is_active() ) return false;
+  std::istringstream events(read_file(path + "/memory.events"));
+  std::string name;
+  size_t count;
+  while ( events >> name >> count )
+  {
+    if ( name == "oom_kill" ) return count > 0;
+  }
+  return false;
+}
+
+size_t ExecutionCgroup::get_peak_memory_kb() const
+{
+  if ( !is_active() ) return 0;
+  std::istringstream peak(read_file(path + "/memory.peak")); // since Linux 5.19
+  size_t bytes = 0;
+  peak >> bytes;
+  return bytes / 1024;
+}
+
+void apply_rlimits(const resource_limits_t &limits)
+{
+  if ( limits.cpu_limit_seconds != 0 )
+  {
+    // SIGXCPU at the soft limit, SIGKILL at the hard limit should the test case handle SIGXCPU
+    const struct rlimit cpu_limit = {limits.cpu_limit_seconds, limits.cpu_limit_seconds + 1};
+    setrlimit(RLIMIT_CPU, &cpu_limit);
+  }
+}
@@ -0,0 +1,65 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * Memory and CPU time limits of a test case execution, 0 if unlimited.
+ */
+struct resource_limits_t
+{
+  size_t memory_limit_mb = 0;
+  size_t cpu_limit_seconds = 0;
+
+  bool limits_memory() const { return memory_limit_mb != 0; }
+};
+
+/**
+ * The cgroup v2 of one test case execution, which limits its memory and records its peak memory and OOM kills.
+ *
+ * Execution cgroups are created next to a leaf cgroup that the evaluator moves itself into, within its own cgroup,
+ * which must be delegated to the user (e.g., a systemd scope with Delegate=yes) with the memory controller available.
+ * Otherwise, is_active() is false and the memory is not limited, with a warning: RLIMIT_AS and RLIMIT_DATA count the
+ * address ranges that sanitizers reserve without using them, e.g., the shadow memory of ASan, which then fails to
+ * start.
+ */
+class ExecutionCgroup
+{
+public:
+  explicit ExecutionCgroup(const resource_limits_t &limits);
+  ~ExecutionCgroup();
+  ExecutionCgroup(const ExecutionCgroup &) = delete;
+  ExecutionCgroup &operator=(const ExecutionCgroup &) = delete;
+
+  bool is_active() const { return !path.empty(); }
+
+  /**
+   * Moves the calling process into the cgroup, e.g., the test case before it executes the binary.
+   */
+  void join() const;
+
+  /**
+   * Whether the kernel killed a process of the cgroup for exceeding the memory limit.
+   */
+  bool was_oom_killed() const;
+
+  /**
+   * Peak memory usage of the cgroup in KiB, 0 if the kernel does not record it.
+   */
+  size_t get_peak_memory_kb() const;
+
+private:
+  std::string path;
+};
+
+/**
+ * Applies the CPU time limit to the calling process, e.g., the test case before it executes the binary, as RLIMIT_CPU.
+ */
+void apply_rlimits(const resource_limits_t &limits);
@@ -0,0 +1,239 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "result_store.h"
+
+#include <cassert>
+#include <iomanip>
+
+#include "test_case_selector.h"
+
+// classes of variant results, the overall result of a test case depends only on which of them occurred
+enum result_class_t: uint8_t
+{
+  PRECONDITIONS_FAILED_CLASS = 1 << 0,
+  FAILED_CLASS = 1 << 1,
+  SUCCESSFUL_CLASS = 1 << 2,
+  INVALID_CLASS = 1 << 3,
+  COMPILE_FAILED_CLASS = 1 << 4,
+  RESOURCE_EXHAUSTED_CLASS = 1 << 5
+};
+
+static uint8_t to_result_class(exec_result_t result)
+{
+  switch (result)
+  {
+    case INVALID:
+      return INVALID_CLASS;
+    case PRECONDITIONS_FAILED:
+      return PRECONDITIONS_FAILED_CLASS;
+    case COMPILE_FAILED:
+      return COMPILE_FAILED_CLASS;
+    case RESOURCE_EXHAUSTED:
+      return RESOURCE_EXHAUSTED_CLASS;
+    case SUCCESSFUL:
+    case TIMEOUT:
+      return SUCCESSFUL_CLASS;
+    default:
+      return FAILED_CLASS;
+  }
+}
+
+static exec_result_t to_overall_result(uint8_t result_mask)
+{
+  if ( result_mask & INVALID_CLASS ) return INVALID;       // if any variant is invalid
+  if ( result_mask & SUCCESSFUL_CLASS ) return SUCCESSFUL; // if any variant is successful
+  if ( result_mask & FAILED_CLASS ) return FAILED;
+  if ( result_mask & PRECONDITIONS_FAILED_CLASS ) return PRECONDITIONS_FAILED; // if all executed variants have failing preconditions
+  if ( result_mask & RESOURCE_EXHAUSTED_CLASS ) return RESOURCE_EXHAUSTED;     // if all executed variants exhausted their resources
+  if ( result_mask & COMPILE_FAILED_CLASS ) return COMPILE_FAILED;             // only if no variant could be compiled
+  return PRECONDITIONS_FAILED;
+}
+
+size_t ResultStore::get_row(uint32_t group_id, const std::pair<size_t, size_t> &sizes)
+{
+  size_t sizes_index = 0;
+  while ( sizes_index < object_sizes.size() && object_sizes[sizes_index] != sizes )
+  {
+    sizes_index++;
+  }
+  if ( sizes_index == object_sizes.size() )
+  {
+    object_sizes.push_back(sizes);
+  }
+
+  const test_case_key_t key = static_cast<test_case_key_t>(sizes_index) << 32 | group_id;
+  const auto inserted = rows.emplace(key, static_cast<uint32_t>(keys.size()));
+  if ( inserted.second )
+  {
+    keys.push_back(key);
+    object_sizes_indexes.push_back(static_cast<uint32_t>(sizes_index));
+    result_masks.push_back(0);
+    baseline_result_masks.push_back(0);
+  }
+  return inserted.first->second;
+}
+
+void ResultStore::add(const TestCaseInformation &test_case_information, exec_result_t result, bool is_baseline)
+{
+  const size_t row = get_row(make_group_id(test_case_information.get_dimension_ids()),
+    {test_case_information.get_origin_size(), test_case_information.get_target_size()});
+  if ( is_baseline ) baseline_result_masks[row] |= to_result_class(result);
+  else result_masks[row] |= to_result_class(result);
+}
+
+bool ResultStore::add_variant(const TestCaseInformation &variant, exec_result_t result, bool is_baseline)
+{
+  if ( !is_baseline && variant.get_is_validation() )
+  {
+    if ( result == SUCCESSFUL ) return false;
+    add(variant, INVALID, /*is_baseline=*/false);
+    return true;
+  }
+  add(variant, result, is_baseline);
+  return result == SUCCESSFUL;
+}
+
+void ResultStore::collapse()
+{
+  overall_results.resize(keys.size());
+  overall_baseline_results.resize(keys.size());
+  for ( size_t row = 0; row < keys.size(); row++ )
+  {
+    overall_results[row] = to_overall_result(result_masks[row]);
+    overall_baseline_results[row] = to_overall_result(baseline_result_masks[row]);
+  }
+}
+
+std::vector<uint8_t> ResultStore::get_dimension_ids(size_t row) const
+{
+  const size_t dimension_count = is_temporal(row) ? TestCaseInformation::TEMPORAL_DIMENSIONS : TestCaseInformation::SPATIAL_DIMENSIONS;
+  std::vector<uint8_t> dimension_ids(dimension_count);
+  for ( size_t i = 0; i < dimension_count; i++ )
+  {
+    dimension_ids[i] = get_dimension_id(keys[row], i);
+  }
+  return dimension_ids;
+}
+
+std::vector<counters_t> ResultStore::count(test_case_kind_t kind, const std::vector<size_t> &dimensions, bool baseline) const
+{
+  assert(overall_results.size() == keys.size());
+  const bool is_temporal = kind == TEMPORAL_KIND;
+  const size_t dimension_count = is_temporal ? TestCaseInformation::TEMPORAL_DIMENSIONS : TestCaseInformation::SPATIAL_DIMENSIONS;
+
+  // strides of the flattened breakdown, the last dimension varies fastest
+  std::vector<size_t> shifts;
+  std::vector<size_t> strides(dimensions.size());
+  size_t cells = 1;
+  for ( size_t i = dimensions.size(); i-- > 0; )
+  {
+    assert(dimensions[i] < dimension_count);
+    strides[i] = cells;
+    cells *= TestCaseInformation::get_dimension_names(is_temporal, dimensions[i]).size();
+  }
+  for ( const size_t dimension: dimensions )
+  {
+    shifts.push_back(4 * (dimension_count - 1 - dimension));
+  }
+
+  const std::vector<uint8_t> &results = baseline ? overall_baseline_results : overall_results;
+  const std::vector<uint8_t> &masks = baseline ? baseline_result_masks : result_masks;
+  std::vector<counters_t> counters(cells);
+  for ( size_t row = 0; row < keys.size(); row++ )
+  {
+    if ( get_kind(keys[row]) != kind || masks[row] == 0 ) continue;
+    size_t cell = 0;
+    for ( size_t i = 0; i < shifts.size(); i++ )
+    {
+      cell += ((keys[row] >> shifts[i]) & 0xF) * strides[i];
+    }
+    counters[cell].add(static_cast<exec_result_t>(results[row]));
+  }
+  return counters;
+}
+
+counters_t ResultStore::count_all(bool baseline) const
+{
+  assert(overall_results.size() == keys.size());
+  const std::vector<uint8_t> &results = baseline ? overall_baseline_results : overall_results;
+  const std::vector<uint8_t> &masks = baseline ? baseline_result_masks : result_masks;
+  counters_t counters;
+  for ( size_t row = 0; row < keys.size(); row++ )
+  {
+    if ( masks[row] == 0 ) continue;
+    counters.add(static_cast<exec_result_t>(results[row]));
+  }
+  return counters;
+}
+
+std::vector<counters_t> ResultStore::count_by_object_sizes(bool baseline) const
+{
+  assert(overall_results.size() == keys.size());
+  const std::vector<uint8_t> &results = baseline ? overall_baseline_results : overall_results;
+  const std::vector<uint8_t> &masks = baseline ? baseline_result_masks : result_masks;
+  std::vector<counters_t> counters(object_sizes.size());
+  for ( size_t row = 0; row < keys.size(); row++ )
+  {
+    if ( get_kind(keys[row]) != SPATIAL_KIND || masks[row] == 0 ) continue;
+    counters[object_sizes_indexes[row]].add(static_cast<exec_result_t>(results[row]));
+  }
+  return counters;
+}
+
+void ResultStore::write(std::ostream &out) const
+{
+  for ( size_t row = 0; row < keys.size(); row++ )
+  {
+    out << std::hex << std::setw(8) << std::setfill('0') << static_cast<uint32_t>(keys[row]) << std::dec << " "
+      << get_origin_size(row) << " " << get_target_size(row) << " "
+      << static_cast<unsigned>(result_masks[row]) << " " << static_cast<unsigned>(baseline_result_masks[row]) << "\n";
+  }
+}
+
+static bool is_valid_group_id(uint32_t group_id)
+{
+  const test_case_kind_t kind = get_kind(group_id);
+  const size_t dimension_count = kind == TEMPORAL_KIND ? TestCaseInformation::TEMPORAL_DIMENSIONS : TestCaseInformation::SPATIAL_DIMENSIONS;
+  if ( kind > SPATIAL_KIND || (kind == TEMPORAL_KIND && (group_id >> (4 * dimension_count)) != 0) )
+  {
+    return false;
+  }
+  for ( size_t i = 0; i < dimension_count; i++ )
+  {
+    if ( get_dimension_id(group_id, i) >= TestCaseInformation::get_dimension_names(kind == TEMPORAL_KIND, i).size() )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ResultStore::read(std::istream &in, size_t row_count)
+{
+  const size_t first_new_row = keys.size();
+  for ( size_t i = 0; i < row_count; i++ )
+  {
+    uint32_t group_id;
+    std::pair<size_t, size_t> sizes;
+    unsigned result_mask;
+    unsigned baseline_result_mask;
+    if ( !(in >> std::hex >> group_id >> std::dec >> sizes.first >> sizes.second >> result_mask >> baseline_result_mask)
+      || !is_valid_group_id(group_id) || result_mask > 0x3F || baseline_result_mask > 0x3F )
+    {
+      return false;
+    }
+    const size_t row = get_row(group_id, sizes);
+    if ( row < first_new_row || result_masks[row] != 0 || baseline_result_masks[row] != 0 )
+    {
+      return false; // the test case is in another partial result as well
+    }
+    result_masks[row] = static_cast<uint8_t>(result_mask);
+    baseline_result_masks[row] = static_cast<uint8_t>(baseline_result_mask);
+  }
+  return true;
+}
@@ -0,0 +1,137 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "evaluator/sanitizer.h"
+#include "evaluator/test_case_information.h"
+
+/**
+ * Packed key of a test case (all its variants): the group ID (see make_group_id()) in the lower 32 bits, holding
+ * the kind and one 4-bit field per dimension ID, and the index of the object sizes in the upper 32 bits.
+ */
+using test_case_key_t = uint64_t;
+
+enum test_case_kind_t
+{
+  TEMPORAL_KIND = 0,
+  SPATIAL_KIND = 1
+};
+
+inline test_case_kind_t get_kind(test_case_key_t key)
+{
+  return static_cast<test_case_kind_t>((key >> 28) & 0xF);
+}
+
+inline uint8_t get_dimension_id(test_case_key_t key, size_t dimension)
+{
+  const size_t dimension_count = get_kind(key) == SPATIAL_KIND ? TestCaseInformation::SPATIAL_DIMENSIONS : TestCaseInformation::TEMPORAL_DIMENSIONS;
+  return static_cast<uint8_t>((key >> (4 * (dimension_count - 1 - dimension))) & 0xF);
+}
+
+struct counters_t
+{
+  size_t precond_failed = 0;
+  size_t failures = 0;
+  size_t successes = 0;
+  size_t invalids = 0;
+  size_t compile_failures = 0;
+  size_t resource_exhaustions = 0;
+
+  void add(exec_result_t overall_result)
+  {
+    if ( overall_result == INVALID ) invalids++;
+    else if ( overall_result == COMPILE_FAILED ) compile_failures++;
+    else if ( overall_result == RESOURCE_EXHAUSTED ) resource_exhaustions++;
+    else if ( overall_result == PRECONDITIONS_FAILED ) precond_failed++;
+    else if ( overall_result == SUCCESSFUL || overall_result == TIMEOUT ) successes++;
+    else failures++;
+  }
+  size_t total() const { return precond_failed + failures + successes + invalids + compile_failures + resource_exhaustions; }
+};
+
+/**
+ * Results of an evaluation, stored as columns with one row per test case.
+ *
+ * Results of the variants are folded into a bit mask per row as they arrive; collapse() then computes the overall
+ * result of each test case. Breakdowns by any combination of dimensions are computed by a single pass over the
+ * columns, without looking up names.
+ */
+class ResultStore
+{
+public:
+  void add(const TestCaseInformation &test_case_information, exec_result_t result, bool is_baseline);
+
+  /**
+   * Adds the result of an executed variant. A validation variant must not detect anything: it only adds INVALID, if
+   * it did. Returns whether the following variants of the test case can be skipped, i.e., whether the variant detected
+   * the bug or failed validation.
+   */
+  bool add_variant(const TestCaseInformation &variant, exec_result_t result, bool is_baseline);
+
+  /**
+   * Computes the overall result of each test case: INVALID if a variant failed validation, otherwise SUCCESSFUL if
+   * a variant was successful, FAILED if a variant failed, PRECONDITIONS_FAILED if the preconditions of all executed
+   * variants failed, RESOURCE_EXHAUSTED if all other executed variants exhausted their resources, and COMPILE_FAILED if
+   * no variant could be compiled.
+   */
+  void collapse();
+
+  size_t size() const { return keys.size(); }
+  test_case_key_t get_key(size_t row) const { return keys[row]; }
+  bool is_temporal(size_t row) const { return get_kind(keys[row]) == TEMPORAL_KIND; }
+  std::vector<uint8_t> get_dimension_ids(size_t row) const;
+  size_t get_origin_size(size_t row) const { return object_sizes[object_sizes_indexes[row]].first; }
+  size_t get_target_size(size_t row) const { return object_sizes[object_sizes_indexes[row]].second; }
+  exec_result_t get_overall_result(size_t row) const { return static_cast<exec_result_t>(overall_results[row]); }
+  exec_result_t get_overall_baseline_result(size_t row) const { return static_cast<exec_result_t>(overall_baseline_results[row]); }
+  bool has_baseline_results(size_t row) const { return baseline_result_masks[row] != 0; }
+
+  /**
+   * Counters of the overall results per combination of the IDs of the given dimensions (file name order of kind),
+   * flattened with the first dimension varying slowest. Without dimensions, a single counter covers all test cases
+   * of kind.
+   */
+  std::vector<counters_t> count(test_case_kind_t kind, const std::vector<size_t> &dimensions, bool baseline) const;
+  counters_t count_all(bool baseline) const;
+
+  /**
+   * Counters of the overall spatial results per object sizes, indexed like get_object_sizes().
+   */
+  std::vector<counters_t> count_by_object_sizes(bool baseline) const;
+  const std::vector<std::pair<size_t, size_t>> &get_object_sizes() const { return object_sizes; }
+
+  /**
+   * Writes the rows not yet collapsed, one per line: group ID, object sizes and the result masks.
+   */
+  void write(std::ostream &out) const;
+
+  /**
+   * Adds row_count rows written by write(), e.g., by another shard. Returns false if a row is malformed or already
+   * present, i.e., if partial results overlap.
+   */
+  bool read(std::istream &in, size_t row_count);
+
+private:
+  size_t get_row(uint32_t group_id, const std::pair<size_t, size_t> &sizes);
+
+  std::unordered_map<test_case_key_t, uint32_t> rows;
+  std::vector<std::pair<size_t, size_t>> object_sizes;
+
+  // columns
+  std::vector<test_case_key_t> keys;
+  std::vector<uint32_t> object_sizes_indexes;
+  std::vector<uint8_t> result_masks;
+  std::vector<uint8_t> baseline_result_masks;
+  std::vector<uint8_t> overall_results;
+  std::vector<uint8_t> overall_baseline_results;
+};
@@ -0,0 +1,243 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "results_exporter.h"
+
+#include <cstdio>
+#include <sstream>
+
+#include "test_case_selector.h"
+#include "evaluator/result_store.h"
+
+namespace
+{
+enum column_t
+{
+  RECORD, SANITIZER, BASELINE, TEST_CASE_ID, TEST_CASE, KIND,
+  BUG_TYPE, MEMORY_STATE, REGION, ORIGIN, TARGET, RELATION, FLOW, ACCESS_LOCATION, ACCESS_ACTION, OBJECT_SIZES,
+  VARIANT, VALIDATION, RESULT, COMPILE_SECONDS, RUN_SECONDS, PEAK_MEMORY_KB, REUSED_BINARY, REUSED_RESULT,
+  PRECONDITIONS_FAILED_COUNT, DETECTED_COUNT, NOT_DETECTED_COUNT, INVALID_COUNT, COMPILE_FAILED_COUNT, RESOURCE_EXHAUSTED_COUNT, TOTAL_COUNT,
+  COLUMN_COUNT
+};
+
+struct column_info_t
+{
+  const char *name;
+  bool is_text; // quoted in JSON
+};
+}
+
+static const column_info_t COLUMNS[COLUMN_COUNT] = {
+  {"record", true}, {"sanitizer", true}, {"baseline", false}, {"test_case_id", true}, {"test_case", true}, {"kind", true},
+  {"bug_type", true}, {"memory_state", true}, {"region", true}, {"origin", true}, {"target", true}, {"relation", true},
+  {"flow", true}, {"access_location", true}, {"access_action", true}, {"object_sizes", true},
+  {"variant", false}, {"validation", false}, {"result", true}, {"compile_seconds", false}, {"run_seconds", false},
+  {"peak_memory_kb", false}, {"reused_binary", false}, {"reused_result", false},
+  {"preconditions_failed", false}, {"detected", false}, {"not_detected", false}, {"invalid", false}, {"compile_failed", false},
+  {"resource_exhausted", false}, {"total", false}
+};
+
+// columns of the dimensions, in file name order (see TestCaseInformation::get_dimension_ids())
+static const column_t TEMPORAL_DIMENSION_COLUMNS[] = {BUG_TYPE, MEMORY_STATE, REGION, ACCESS_LOCATION, ACCESS_ACTION};
+static const column_t SPATIAL_DIMENSION_COLUMNS[] = {BUG_TYPE, ORIGIN, TARGET, RELATION, FLOW, ACCESS_LOCATION, ACCESS_ACTION};
+
+static const column_t *get_dimension_columns(bool is_temporal)
+{
+  return is_temporal ? TEMPORAL_DIMENSION_COLUMNS : SPATIAL_DIMENSION_COLUMNS;
+}
+
+static const char *get_result_name(exec_result_t result)
+{
+  switch ( result )
+  {
+    case PRECONDITIONS_FAILED: return "PRECONDITIONS_FAILED";
+    case FAILED: return "FAILED";
+    case FAILED_SIGSEGV: return "FAILED_SIGSEGV";
+    case TIMEOUT: return "TIMEOUT";
+    case INVALID: return "INVALID";
+    case SUCCESSFUL: return "SUCCESSFUL";
+    case COMPILE_FAILED: return "COMPILE_FAILED";
+    case RESOURCE_EXHAUSTED: return "RESOURCE_EXHAUSTED";
+  }
+  return "UNKNOWN";
+}
+
+static std::string to_string(double value)
+{
+  std::ostringstream formatted;
+  formatted << value;
+  return formatted.str();
+}
+
+static const char *to_string(bool value)
+{
+  return value ? "true" : "false";
+}
+
+static void write_quoted(std::ostream &out, const std::string &value, bool is_csv)
+{
+  out << '"';
+  for ( const char c: value )
+  {
+    if ( c == '"' ) out << (is_csv ? "\"\"" : "\\\"");
+    else if ( c == '\\' && !is_csv ) out << "\\\\";
+    else if ( static_cast<unsigned char>(c) < 0x20 && !is_csv )
+    {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+      out << escaped;
+    }
+    else out << c;
+  }
+  out << '"';
+}
+
+ResultsExporter::ResultsExporter(const std::string &path, bool is_csv): out(path, std::ios::trunc), is_csv(is_csv)
+{
+}
+
+std::unique_ptr<ResultsExporter> ResultsExporter::open(const std::string &path)
+{
+  const std::string csv_suffix = ".csv";
+  const bool is_csv = path.size() >= csv_suffix.size() && path.compare(path.size() - csv_suffix.size(), csv_suffix.size(), csv_suffix) == 0;
+  std::unique_ptr<ResultsExporter> exporter(new ResultsExporter(path, is_csv));
+  if ( !exporter->out )
+  {
+    perror(("Cannot write " + path).c_str());
+    return nullptr;
+  }
+  if ( is_csv )
+  {
+    for ( size_t column = 0; column < COLUMN_COUNT; column++ )
+    {
+      exporter->out << (column > 0 ? "," : "") << COLUMNS[column].name;
+    }
+    exporter->out << std::endl;
+  }
+  return exporter;
+}
+
+void ResultsExporter::write(const std::vector<std::string> &values)
+{
+  std::ostringstream record;
+  bool first = true;
+  if ( !is_csv ) record << "{";
+  for ( size_t column = 0; column < COLUMN_COUNT; column++ )
+  {
+    const std::string &value = values[column];
+    if ( is_csv )
+    {
+      if ( column > 0 ) record << ",";
+      if ( value.find_first_of(",\"\n") != std::string::npos ) write_quoted(record, value, /*is_csv=*/true);
+      else record << value;
+      continue;
+    }
+    if ( value.empty() ) continue;
+    record << (first ? "\"" : ",\"") << COLUMNS[column].name << "\":";
+    first = false;
+    if ( COLUMNS[column].is_text ) write_quoted(record, value, /*is_csv=*/false);
+    else record << value;
+  }
+  if ( !is_csv ) record << "}";
+  record << "\n";
+
+  std::lock_guard<std::mutex> lock(mutex);
+  out << record.str();
+  out.flush();
+}
+
+void ResultsExporter::add_variant(const std::string &sanitizer_name, const TestCaseInformation &variant, bool is_baseline,
+  exec_result_t result, const variant_stats_t *stats)
+{
+  std::vector<std::string> values(COLUMN_COUNT);
+  values[RECORD] = "variant";
+  values[SANITIZER] = sanitizer_name;
+  values[BASELINE] = to_string(is_baseline);
+  values[TEST_CASE_ID] = make_test_case_id(variant);
+  values[TEST_CASE] = variant.get_test_case_key();
+  values[KIND] = variant.is_temporal() ? "temporal" : "spatial";
+  const std::vector<uint8_t> &dimension_ids = variant.get_dimension_ids();
+  for ( size_t dimension = 0; dimension < dimension_ids.size(); dimension++ )
+  {
+    values[get_dimension_columns(variant.is_temporal())[dimension]] =
+      TestCaseInformation::get_dimension_names(variant.is_temporal(), dimension)[dimension_ids[dimension]].printable_name;
+  }
+  if ( !variant.is_temporal() ) values[OBJECT_SIZES] = variant.get_object_sizes_name();
+  values[VARIANT] = std::to_string(variant.get_variant_number());
+  values[VALIDATION] = to_string(variant.get_is_validation());
+  values[RESULT] = get_result_name(result);
+  if ( stats )
+  {
+    values[COMPILE_SECONDS] = to_string(stats->compile_seconds);
+    values[RUN_SECONDS] = to_string(stats->run_seconds);
+    values[PEAK_MEMORY_KB] = std::to_string(stats->peak_memory_kb);
+    values[REUSED_BINARY] = to_string(stats->reused_binary);
+    values[REUSED_RESULT] = to_string(stats->reused_result);
+  }
+  write(values);
+}
+
+static void set_counters(std::vector<std::string> &values, const counters_t &counters)
+{
+  values[PRECONDITIONS_FAILED_COUNT] = std::to_string(counters.precond_failed);
+  values[DETECTED_COUNT] = std::to_string(counters.failures);
+  values[NOT_DETECTED_COUNT] = std::to_string(counters.successes);
+  values[INVALID_COUNT] = std::to_string(counters.invalids);
+  values[COMPILE_FAILED_COUNT] = std::to_string(counters.compile_failures);
+  values[RESOURCE_EXHAUSTED_COUNT] = std::to_string(counters.resource_exhaustions);
+  values[TOTAL_COUNT] = std::to_string(counters.total());
+}
+
+void ResultsExporter::add_aggregates(const std::string &sanitizer_name, const ResultStore &results, bool with_baseline)
+{
+  for ( const bool baseline: {false, true} )
+  {
+    if ( baseline && !with_baseline ) break;
+    std::vector<std::string> values(COLUMN_COUNT);
+    values[RECORD] = "aggregate";
+    values[SANITIZER] = sanitizer_name;
+    values[BASELINE] = to_string(baseline);
+    set_counters(values, results.count_all(baseline));
+    write(values);
+
+    for ( const test_case_kind_t kind: {TEMPORAL_KIND, SPATIAL_KIND} )
+    {
+      const bool is_temporal = kind == TEMPORAL_KIND;
+      values[KIND] = is_temporal ? "temporal" : "spatial";
+      const counters_t kind_counters = results.count(kind, {}, baseline)[0];
+      if ( kind_counters.total() == 0 ) continue;
+      set_counters(values, kind_counters);
+      write(values);
+
+      const size_t dimension_count = is_temporal ? TestCaseInformation::TEMPORAL_DIMENSIONS : TestCaseInformation::SPATIAL_DIMENSIONS;
+      for ( size_t dimension = 0; dimension < dimension_count; dimension++ )
+      {
+        const column_t column = get_dimension_columns(is_temporal)[dimension];
+        const std::vector<counters_t> counters = results.count(kind, {dimension}, baseline);
+        const PrimitiveDimension &names = TestCaseInformation::get_dimension_names(is_temporal, dimension);
+        for ( size_t id = 0; id < names.size(); id++ )
+        {
+          if ( counters[id].total() == 0 ) continue;
+          values[column] = names[id].printable_name;
+          set_counters(values, counters[id]);
+          write(values);
+        }
+        values[column].clear();
+      }
+    }
+
+    values[KIND] = "spatial";
+    const std::vector<counters_t> size_counters = results.count_by_object_sizes(baseline);
+    for ( size_t i = 0; i < size_counters.size(); i++ )
+    {
+      if ( size_counters[i].total() == 0 ) continue;
+      values[OBJECT_SIZES] = std::to_string(results.get_object_sizes()[i].first) + "x" + std::to_string(results.get_object_sizes()[i].second);
+      set_counters(values, size_counters[i]);
+      write(values);
+    }
+  }
+}
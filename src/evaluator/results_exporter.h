@@ -0,0 +1,70 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "evaluator/sanitizer.h"
+#include "evaluator/test_case_information.h"
+
+class ResultStore;
+
+/**
+ * What evaluating a variant cost. Reused binaries and results (see BuildCache) cost nothing to compile, resp. run.
+ */
+struct variant_stats_t
+{
+  double compile_seconds = 0;
+  double run_seconds = 0;
+  size_t peak_memory_kb = 0;
+  bool reused_binary = false;
+  bool reused_result = false;
+};
+
+/**
+ * Writes the results of an evaluation in a machine-readable form, see --export: one record per evaluated variant as
+ * soon as its result is committed, and the aggregates per primitive of each dimension once the evaluation is done.
+ * A path ending in ".csv" is written as CSV with a header line, any other as JSON Lines. All records share the same
+ * columns; the "record" column tells variants from aggregates, and JSON records leave out empty columns. Each record
+ * is flushed on its own, so that the file can be followed while the evaluation runs.
+ */
+class ResultsExporter
+{
+public:
+  ResultsExporter(const ResultsExporter &) = delete;
+  ResultsExporter &operator=(const ResultsExporter &) = delete;
+
+  /**
+   * Creates or truncates the file at path. Returns nullptr on errors.
+   */
+  static std::unique_ptr<ResultsExporter> open(const std::string &path);
+
+  /**
+   * Adds the result of a variant. The costs are left empty without stats, i.e., for variants evaluated before resuming
+   * or by a worker.
+   */
+  void add_variant(const std::string &sanitizer_name, const TestCaseInformation &variant, bool is_baseline, exec_result_t result,
+    const variant_stats_t *stats);
+
+  /**
+   * Adds the aggregates of the collapsed results of a sanitizer: overall, per kind, per primitive of each dimension and
+   * per object sizes, each for the sanitizer and, with_baseline, for the baseline.
+   */
+  void add_aggregates(const std::string &sanitizer_name, const ResultStore &results, bool with_baseline);
+
+private:
+  ResultsExporter(const std::string &path, bool is_csv);
+  void write(const std::vector<std::string> &values);
+
+  std::ofstream out;
+  bool is_csv;
+  std::mutex mutex; // records are added by concurrent jobs
+};
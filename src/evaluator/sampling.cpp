@@ -0,0 +1,73 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "sampling.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+static const double Z_95 = 1.959963984540054; // standard normal quantile of a two-sided 95% interval
+
+std::vector<size_t> order_stratified_sample(const std::vector<size_t> &strata, const std::vector<uint64_t> &shuffle_keys)
+{
+  assert(strata.size() == shuffle_keys.size());
+  std::vector<std::vector<size_t>> members;
+  for ( size_t i = 0; i < strata.size(); i++ )
+  {
+    if ( strata[i] >= members.size() ) members.resize(strata[i] + 1);
+    members[strata[i]].push_back(i);
+  }
+  for ( auto &stratum: members )
+  {
+    std::stable_sort(stratum.begin(), stratum.end(), [&shuffle_keys](size_t lhs, size_t rhs) { return shuffle_keys[lhs] < shuffle_keys[rhs]; });
+  }
+
+  std::vector<size_t> taken(members.size(), 0);
+  std::vector<size_t> order;
+  order.reserve(strata.size());
+  while ( order.size() < strata.size() )
+  {
+    // least sampled stratum: smallest taken / size, compared without division
+    size_t next = members.size();
+    for ( size_t stratum = 0; stratum < members.size(); stratum++ )
+    {
+      if ( taken[stratum] == members[stratum].size() ) continue;
+      if ( next == members.size() || taken[stratum] * members[next].size() < taken[next] * members[stratum].size() ) next = stratum;
+    }
+    order.push_back(members[next][taken[next]++]);
+  }
+  return order;
+}
+
+rate_estimate_t estimate_rate(size_t hits, size_t sample_size, size_t population_size)
+{
+  rate_estimate_t estimate;
+  if ( sample_size == 0 )
+  {
+    estimate.upper = 1;
+    return estimate;
+  }
+  const double n = static_cast<double>(sample_size);
+  const double p = static_cast<double>(hits) / n;
+  estimate.rate = p;
+  if ( sample_size >= population_size )
+  {
+    estimate.lower = estimate.upper = p;
+    return estimate;
+  }
+
+  // sampling without replacement, the variance shrinks by (N - n) / (N - 1): widen the sample by its inverse
+  const double correction = (static_cast<double>(population_size) - n) / (static_cast<double>(population_size) - 1);
+  const double effective_n = n / correction;
+  const double z2 = Z_95 * Z_95;
+  const double center = (p + z2 / (2 * effective_n)) / (1 + z2 / effective_n);
+  const double half_width = Z_95 / (1 + z2 / effective_n) * std::sqrt(p * (1 - p) / effective_n + z2 / (4 * effective_n * effective_n));
+  estimate.lower = std::max(0.0, center - half_width);
+  estimate.upper = std::min(1.0, center + half_width);
+  return estimate;
+}
@@ -0,0 +1,33 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Orders the items of a population, each in one stratum, so that every prefix of the order is a stratified sample
+ * with proportional allocation: the next item is taken from the stratum sampled least so far, relative to its size,
+ * so that every stratum is sampled once before any is sampled twice. Within a stratum, items are taken by ascending
+ * shuffle key, e.g., a hash of the item. Returns the indexes of the items in sampling order.
+ */
+std::vector<size_t> order_stratified_sample(const std::vector<size_t> &strata, const std::vector<uint64_t> &shuffle_keys);
+
+struct rate_estimate_t
+{
+  double rate = 0;
+  double lower = 0;
+  double upper = 0;
+};
+
+/**
+ * Estimates the rate of hits in a population of population_size items from a random sample of sample_size of them,
+ * with a 95% Wilson score interval, narrowed by the finite population correction; a sample of the whole population
+ * gives the exact rate.
+ */
+rate_estimate_t estimate_rate(size_t hits, size_t sample_size, size_t population_size);
@@ -7,45 +7,233 @@
 
 #include "sanitizer.h"
 #include "config.h"
+#include "trace.h"
 
+#include <chrono>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <tuple>
 #include <unistd.h>
+#include <sys/mman.h>     // memfd_create
+#include <sys/resource.h> // rusage
+#include <sys/socket.h>   // socketpair
 #include <sys/wait.h>
+#include <fcntl.h>
 #include <csignal>
 
+#include "evaluator/logger.h"
 #include "evaluator/tinyxml2.h"
 
+// "-x none" ends the language override, so inputs following $SOURCE_FILE (e.g., libraries) are still detected by their suffix
+static const char SOURCE_FROM_STDIN[] = "-x c - -x none";
+
+// names the file descriptor that _trigger() of the prelude writes the trigger time to, as CLOCK_MONOTONIC nanoseconds
+static const char TRIGGER_FD_VARIABLE[] = "MSET_TRIGGER_FD";
+static const off_t TRIGGER_OFFSET = 0;
+static const off_t TERMINATION_OFFSET = sizeof(int64_t);
+
+static void write_timestamp(int fd, off_t offset)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  const int64_t nanoseconds = static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+  if ( pwrite(fd, &nanoseconds, sizeof(nanoseconds), offset) != sizeof(nanoseconds) )
+  {
+    perror("pwrite");
+  }
+}
+
+/**
+ * Reports errno to the evaluator through fd, i.e., why a child process cannot start the test case, and exits.
+ */
+static void exit_with_start_error(int fd)
+{
+  const int error_number = errno;
+  if ( write(fd, &error_number, sizeof(error_number)) != sizeof(error_number) ) { } // the test case then just failed
+  _exit(EXIT_FAILURE);
+}
+
+/**
+ * Runs command through the shell, as system() does, with input on its standard input. The input is written through a
+ * socket instead of a pipe, so that a command exiting without consuming it raises no SIGPIPE in the evaluator; written
+ * is set to whether the command consumed all of it.
+ */
+static int run_with_input(const std::string &command, const char *input, size_t input_length, bool &written)
+{
+  int sockets[2];
+  if ( socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sockets) != 0 ) return -1;
+  const pid_t pid = fork();
+  if ( pid == -1 )
+  {
+    close(sockets[0]);
+    close(sockets[1]);
+    return -1;
+  }
+  if ( pid == 0 )
+  {
+    dup2(sockets[1], STDIN_FILENO); // without FD_CLOEXEC
+    execl("/bin/sh", "sh", "-c", command.c_str(), static_cast<char *>(nullptr));
+    _exit(127);
+  }
+  close(sockets[1]);
+  size_t sent = 0;
+  while ( sent < input_length )
+  {
+    const ssize_t res = send(sockets[0], input + sent, input_length - sent, MSG_NOSIGNAL);
+    if ( res < 0 && errno == EINTR ) continue;
+    if ( res <= 0 ) break;
+    sent += static_cast<size_t>(res);
+  }
+  written = sent == input_length;
+  close(sockets[0]);
+  int status;
+  while ( waitpid(pid, &status, 0) == -1 )
+  {
+    if ( errno != EINTR ) return -1;
+  }
+  return status;
+}
+
+static std::string shell_quote(const std::string &value)
+{
+  std::string quoted = "'";
+  for ( const char c: value )
+  {
+    if ( c == '\'' ) quoted += "'\\''";
+    else quoted += c;
+  }
+  return quoted + "'";
+}
+
+static bool parse_integer(const std::string &text, long &value)
+{
+  char *end;
+  errno = 0;
+  value = std::strtol(text.c_str(), &end, 10);
+  return !text.empty() && *end == '\0' && errno == 0;
+}
+
+/**
+ * The value of an <env_var> split at its alternatives: parts[0] alternatives[0][i] parts[1] alternatives[1][j] ...
+ */
+struct swept_value_t
+{
+  std::vector<std::string> parts;
+  std::vector<std::vector<std::string>> alternatives;
+  std::vector<std::string> labels; // prefix of each chosen alternative in the names of the sweep points, e.g., "redzone="
+};
+
+/**
+ * Parses the alternatives of a value: lists "{a,b,c}" and integer ranges "{first..last}" or "{first..last..step}".
+ * Braces holding neither are kept as they are.
+ */
+static bool parse_swept_value(const std::string &name, const std::string &value, swept_value_t &swept_value, std::string &error)
+{
+  swept_value = swept_value_t();
+  std::string part;
+  size_t position = 0;
+  size_t open;
+  size_t close;
+  while ( (open = value.find('{', position)) != std::string::npos && (close = value.find('}', open)) != std::string::npos )
+  {
+    const std::string inner = value.substr(open + 1, close - open - 1);
+    const size_t range_separator = inner.find("..");
+    std::vector<std::string> alternatives;
+    if ( inner.find(',') != std::string::npos )
+    {
+      std::istringstream list(inner);
+      std::string alternative;
+      while ( std::getline(list, alternative, ',') )
+      {
+        alternatives.push_back(alternative);
+      }
+      if ( inner.back() == ',' ) alternatives.emplace_back();
+    }
+    else if ( range_separator != std::string::npos )
+    {
+      const size_t step_separator = inner.find("..", range_separator + 2);
+      long first;
+      long last;
+      long step = 1;
+      if ( !parse_integer(inner.substr(0, range_separator), first)
+        || !parse_integer(inner.substr(range_separator + 2, step_separator - range_separator - 2), last)
+        || (step_separator != std::string::npos && !parse_integer(inner.substr(step_separator + 2), step))
+        || step <= 0 || first > last )
+      {
+        error = "Invalid range {" + inner + "} in the value of the env_var " + name + ", expected {first..last} or {first..last..step}.\n";
+        return false;
+      }
+      for ( long alternative = first; alternative <= last; alternative += step )
+      {
+        alternatives.push_back(std::to_string(alternative));
+      }
+    }
+    else
+    {
+      part += value.substr(position, close + 1 - position);
+      position = close + 1;
+      continue;
+    }
+
+    part += value.substr(position, open - position);
+    const size_t label_start = part.find_last_of(":;, ");
+    std::string label = label_start == std::string::npos ? part : part.substr(label_start + 1);
+    swept_value.labels.push_back(label.empty() ? name + "=" : label);
+    swept_value.parts.push_back(part);
+    swept_value.alternatives.push_back(alternatives);
+    part.clear();
+    position = close + 1;
+  }
+  swept_value.parts.push_back(part + value.substr(position));
+  return true;
+}
+
 Sanitizer::Sanitizer(const std::string &config_path)
+{
+  std::string error;
+  if ( !parse(config_path, error) )
+  {
+    std::cerr << error;
+    exit(EXIT_FAILURE);
+  }
+}
+
+std::unique_ptr<Sanitizer> Sanitizer::load(const std::string &config_path, std::string &error)
+{
+  std::unique_ptr<Sanitizer> sanitizer(new Sanitizer());
+  if ( !sanitizer->parse(config_path, error) ) return nullptr;
+  return sanitizer;
+}
+
+bool Sanitizer::parse(const std::string &config_path, std::string &error)
 {
   tinyxml2::XMLDocument doc;
   if (tinyxml2::XML_SUCCESS != doc.LoadFile( config_path.c_str() ))
   {
-    std::cerr << "Failed to parse the configuration file at " << config_path << ": " << doc.ErrorStr() << '\n';
-    exit(EXIT_FAILURE);
+    error = "Failed to parse the configuration file at " + config_path + ": " + doc.ErrorStr() + "\n";
+    return false;
   }
   tinyxml2::XMLElement *root = doc.FirstChildElement("sanitizer");
   if (!root)
   {
-    std::cerr << "Mandatory root element 'sanitizer' is missing! Cannot continue.\n";
-    std::cerr << doc.ErrorStr() << '\n';
-    exit(EXIT_FAILURE);
+    error = std::string("Mandatory root element 'sanitizer' is missing! Cannot continue.\n") + doc.ErrorStr() + "\n";
+    return false;
   }
 
   tinyxml2::XMLElement *setup_element = root->FirstChildElement("setup");
   if (!setup_element)
   {
-    std::cerr << "Mandatory 'setup' element not found. Cannot continue.\n";
-    exit(EXIT_FAILURE);
+    error = "Mandatory 'setup' element not found. Cannot continue.\n";
+    return false;
   }
 
   // at least the compile command is expected
   tinyxml2::XMLElement *compile_cmd_elem = setup_element->FirstChildElement("compile_cmd");
   if (!compile_cmd_elem)
   {
-    std::cerr << "The setup 'compile_cmd' is mandatory. Cannot continue.\n";
-    exit(EXIT_FAILURE);
+    error = "The setup 'compile_cmd' is mandatory. Cannot continue.\n";
+    return false;
   }
   compile_command = compile_cmd_elem->GetText();
 
@@ -60,16 +248,16 @@ Sanitizer::Sanitizer(const std::string &config_path)
   tinyxml2::XMLElement *baseline_setup_element = root->FirstChildElement("setup_baseline");
   if (!baseline_setup_element)
   {
-    std::cerr << "The baseline setup 'compile_cmd' is mandatory. Cannot continue.\n";
-    exit(EXIT_FAILURE);
+    error = "The baseline setup 'compile_cmd' is mandatory. Cannot continue.\n";
+    return false;
   }
 
   // at least the compile_cmd is expected
   compile_cmd_elem = baseline_setup_element->FirstChildElement("compile_cmd");
   if (!compile_cmd_elem)
   {
-    std::cerr << "At least one 'cmd' is expected. Cannot continue.\n";
-    exit(EXIT_FAILURE);
+    error = "At least one 'cmd' is expected. Cannot continue.\n";
+    return false;
   }
   baseline_compile_command = compile_cmd_elem->GetText();
 
@@ -83,9 +271,8 @@ Sanitizer::Sanitizer(const std::string &config_path)
   tinyxml2::XMLElement *run = root->FirstChildElement("run");
   if (!run)
   {
-    std::cerr << "model 'run' element is missing! Cannot continue.\n";
-    std::cerr << doc.ErrorStr() << '\n';
-    exit(EXIT_FAILURE);
+    error = std::string("model 'run' element is missing! Cannot continue.\n") + doc.ErrorStr() + "\n";
+    return false;
   }
   tinyxml2::XMLElement *run_env_args = root->FirstChildElement("run_env_args");
   if (run_env_args) // optional
@@ -97,22 +284,25 @@ Sanitizer::Sanitizer(const std::string &config_path)
       const char *value = env_var->GetText();
       env_var = env_var->NextSiblingElement("env_var");
       exec_env_vars.push_back( std::make_tuple<std::string, std::string>(name, value) );
+      swept_value_t swept_value;
+      if ( !parse_swept_value(std::get<0>(exec_env_vars.back()), std::get<1>(exec_env_vars.back()), swept_value, error) )
+      {
+        return false;
+      }
     }
   }
 
   tinyxml2::XMLElement *run_baseline = root->FirstChildElement("run_baseline");
   if (!run_baseline)
   {
-    std::cerr << "model 'run_baseline' element is missing! Cannot continue.\n";
-    std::cerr << doc.ErrorStr() << '\n';
-    exit(EXIT_FAILURE);
+    error = std::string("model 'run_baseline' element is missing! Cannot continue.\n") + doc.ErrorStr() + "\n";
+    return false;
   }
   tinyxml2::XMLElement *name_elem = root->FirstChildElement("name");
   if (!name_elem)
   {
-    std::cerr << "model 'name' element is missing! Cannot continue.\n";
-    std::cerr << doc.ErrorStr() << '\n';
-    exit(EXIT_FAILURE);
+    error = std::string("model 'name' element is missing! Cannot continue.\n") + doc.ErrorStr() + "\n";
+    return false;
   }
 
   char *endptr;
@@ -127,16 +317,16 @@ Sanitizer::Sanitizer(const std::string &config_path)
       long value = std::strtol( elem->GetText(), &endptr, 10 );
       if (errno)
       {
-        std::perror("Value of bug_detected_exit_values must be an integer");
-        exit(EXIT_FAILURE);
+        error = std::string("Value of bug_detected_exit_values must be an integer: ") + std::strerror(errno) + "\n";
+        return false;
       }
       test_case_failed_exit_values.insert( static_cast<int>(value) );
       elem = elem->NextSiblingElement("value");
     }
     if ( test_case_failed_exit_values.empty() )
     {
-      std::cerr << "Values of 'bug_detected_exit_values' are missing.\n";
-      exit(EXIT_FAILURE);
+      error = "Values of 'bug_detected_exit_values' are missing.\n";
+      return false;
     }
   }
   else
@@ -153,8 +343,8 @@ Sanitizer::Sanitizer(const std::string &config_path)
     long value = std::strtol( elem->GetText(), &endptr, 10 );
     if (errno)
     {
-      std::perror("Value of 'bug_not_detected_exit_value' must be an integer");
-      exit(EXIT_FAILURE);
+      error = std::string("Value of 'bug_not_detected_exit_value' must be an integer: ") + std::strerror(errno) + "\n";
+      return false;
     }
     test_case_successful_exit_value = static_cast<int>(value);
   }
@@ -171,8 +361,8 @@ Sanitizer::Sanitizer(const std::string &config_path)
     long value = std::strtol( elem->GetText(), &endptr, 10 );
     if (errno)
     {
-      std::perror("Value of 'precondition_not_met_exit_value' must be an integer");
-      exit(EXIT_FAILURE);
+      error = std::string("Value of 'precondition_not_met_exit_value' must be an integer: ") + std::strerror(errno) + "\n";
+      return false;
     }
     preconditions_not_met_exit_value = static_cast<int>(value);
   }
@@ -189,8 +379,8 @@ Sanitizer::Sanitizer(const std::string &config_path)
     long value = std::strtol( elem->GetText(), &endptr, 10 );
     if (errno)
     {
-      std::perror("Value of 'timeout_exit_value' must be an integer");
-      exit(EXIT_FAILURE);
+      error = std::string("Value of 'timeout_exit_value' must be an integer: ") + std::strerror(errno) + "\n";
+      return false;
     }
     timeout_exit_value = static_cast<int>(value);
   }
@@ -207,8 +397,8 @@ Sanitizer::Sanitizer(const std::string &config_path)
     long value = std::strtol( elem->GetText(), &endptr, 10 );
     if (errno)
     {
-      std::perror("Value of 'timeout_seconds' must be an integer");
-      exit(EXIT_FAILURE);
+      error = std::string("Value of 'timeout_seconds' must be an integer: ") + std::strerror(errno) + "\n";
+      return false;
     }
     timeout_in_secs = static_cast<int>(value);
   }
@@ -218,6 +408,56 @@ Sanitizer::Sanitizer(const std::string &config_path)
     timeout_in_secs = DEFAULT_TIMEOUT_IN_SECS;
   }
 
+  elem = root->FirstChildElement("resource_exhausted_exit_value");
+  if (elem) // optional
+  {
+    errno = 0;
+    long value = std::strtol( elem->GetText(), &endptr, 10 );
+    if (errno)
+    {
+      error = std::string("Value of 'resource_exhausted_exit_value' must be an integer: ") + std::strerror(errno) + "\n";
+      return false;
+    }
+    resource_exhausted_exit_value = static_cast<int>(value);
+  }
+  else
+  {
+    // not configured
+    resource_exhausted_exit_value = DEFAULT_RESOURCE_EXHAUSTED_EXIT_VALUE;
+  }
+
+  elem = root->FirstChildElement("memory_limit_mb");
+  if (elem) // optional
+  {
+    errno = 0;
+    long value = std::strtol( elem->GetText(), &endptr, 10 );
+    if (errno || value < 0)
+    {
+      error = std::string("Value of 'memory_limit_mb' must be a non-negative integer: ") + std::strerror(errno) + "\n";
+      return false;
+    }
+    resource_limits.memory_limit_mb = static_cast<size_t>(value);
+  }
+
+  elem = root->FirstChildElement("cpu_limit_seconds");
+  if (elem) // optional
+  {
+    errno = 0;
+    long value = std::strtol( elem->GetText(), &endptr, 10 );
+    if (errno || value < 0)
+    {
+      error = std::string("Value of 'cpu_limit_seconds' must be a non-negative integer: ") + std::strerror(errno) + "\n";
+      return false;
+    }
+    resource_limits.cpu_limit_seconds = static_cast<size_t>(value);
+  }
+
+  elem = root->FirstChildElement("deterministic");
+  if (elem && elem->GetText()) // optional
+  {
+    deterministic = std::string(elem->GetText()) == "true";
+  }
+
   execute_command = run->GetText();
   baseline_execute_command = run_baseline->GetText();
   sanitizer_name = name_elem->GetText();
@@ -245,48 +485,152 @@ Sanitizer::Sanitizer(const std::string &config_path)
     (void)std::strtol( elem->GetText(), &endptr, 16 );
     if (errno)
     {
-      std::perror("Value of 'address_mask' must be an hexadecimal integer");
-      exit(EXIT_FAILURE);
+      error = std::string("Value of 'address_mask' must be an hexadecimal integer: ") + std::strerror(errno) + "\n";
+      return false;
     }
     defines += " -DADDR_MASK=" + std::string(elem->GetText());
   }
+  return true;
 }
 
-bool Sanitizer::compile(const std::string &src_file_path, const std::string &resulted_binary_path) const
+bool Sanitizer::is_sweep() const
 {
-  return _compile(src_file_path, resulted_binary_path, compile_command, setup_commands);
+  for ( const auto &env_var: exec_env_vars )
+  {
+    swept_value_t swept_value;
+    std::string error;
+    if ( parse_swept_value(std::get<0>(env_var), std::get<1>(env_var), swept_value, error) && !swept_value.alternatives.empty() )
+    {
+      return true;
+    }
+  }
+  return false;
 }
 
-bool Sanitizer::compile_baseline(const std::string &src_file_path, const std::string &resulted_binary_path) const
+std::vector<Sanitizer> Sanitizer::expand_sweep() const
 {
-  return _compile(src_file_path, resulted_binary_path, baseline_compile_command, baseline_setup_commands);
+  std::vector<Sanitizer> points{*this};
+  for ( size_t i = 0; i < exec_env_vars.size(); i++ )
+  {
+    swept_value_t swept_value;
+    std::string error;
+    parse_swept_value(std::get<0>(exec_env_vars[i]), std::get<1>(exec_env_vars[i]), swept_value, error); // checked by parse()
+
+    // every combination of the alternatives of this value, with the suffix it adds to the name
+    std::vector<std::pair<std::string, std::string>> values{{swept_value.parts[0], ""}};
+    for ( size_t group = 0; group < swept_value.alternatives.size(); group++ )
+    {
+      std::vector<std::pair<std::string, std::string>> combined_values;
+      for ( const auto &value: values )
+      {
+        for ( const std::string &alternative: swept_value.alternatives[group] )
+        {
+          combined_values.emplace_back(value.first + alternative + swept_value.parts[group + 1],
+            value.second + "+" + swept_value.labels[group] + alternative);
+        }
+      }
+      values.swap(combined_values);
+    }
+
+    std::vector<Sanitizer> combined_points;
+    for ( const Sanitizer &point: points )
+    {
+      for ( const auto &value: values )
+      {
+        combined_points.push_back(point);
+        std::get<1>(combined_points.back().exec_env_vars[i]) = value.first;
+        combined_points.back().sanitizer_name += value.second;
+      }
+    }
+    points.swap(combined_points);
+  }
+  return points;
 }
 
-bool Sanitizer::_compile(const std::string &src_file_path, const std::string &resulted_binary_path,
-  const std::string &compile_cmd, const std::vector<std::string> &cmds) const
+std::string Sanitizer::get_compile_signature(bool is_baseline) const
 {
-  if ( setenv( "SOURCE_FILE", src_file_path.c_str(), 1 ) != 0 )
+  std::string signature = (is_baseline ? baseline_compile_command : compile_command) + " " + defines;
+  for (const std::string &cmd: is_baseline ? baseline_setup_commands : setup_commands)
   {
-    std::cerr << "Failed to set env SOURCE_FILE!\n";
-    exit(EXIT_FAILURE);
+    signature += "\n" + cmd;
   }
+  return signature;
+}
 
-  if ( setenv( "GENERATED_BINARY", resulted_binary_path.c_str(), 1 ) != 0 )
+std::string Sanitizer::get_run_signature(bool is_baseline) const
+{
+  std::ostringstream signature;
+  signature << (is_baseline ? baseline_execute_command : execute_command) << "\n";
+  if ( !is_baseline )
   {
-    std::cerr << "Failed to set env GENERATED_BINARY!\n";
-    exit(EXIT_FAILURE);
+    for (const auto &env_var: exec_env_vars)
+    {
+      signature << std::get<0>(env_var) << "=" << std::get<1>(env_var) << "\n";
+    }
+  }
+  // the exit values determine the result as well
+  signature << test_case_successful_exit_value << " " << preconditions_not_met_exit_value << " " << timeout_exit_value << " " << timeout_in_secs
+    << " " << resource_exhausted_exit_value << " " << resource_limits.memory_limit_mb << " " << resource_limits.cpu_limit_seconds;
+  for (const int value: test_case_failed_exit_values)
+  {
+    signature << " " << value;
   }
+  return signature.str();
+}
+
+bool Sanitizer::compile(const std::string &src_file_path, const std::string &resulted_binary_path) const
+{
+  return _compile(src_file_path, resulted_binary_path, compile_command, setup_commands);
+}
+
+bool Sanitizer::compile_baseline(const std::string &src_file_path, const std::string &resulted_binary_path) const
+{
+  return _compile(src_file_path, resulted_binary_path, baseline_compile_command, baseline_setup_commands);
+}
+
+bool Sanitizer::compile_from_memory(const char *source, size_t source_length, const std::string &resulted_binary_path) const
+{
+  return _compile(SOURCE_FROM_STDIN, resulted_binary_path, compile_command, setup_commands, source, source_length);
+}
+
+bool Sanitizer::compile_baseline_from_memory(const char *source, size_t source_length, const std::string &resulted_binary_path) const
+{
+  return _compile(SOURCE_FROM_STDIN, resulted_binary_path, baseline_compile_command, baseline_setup_commands, source, source_length);
+}
 
+bool Sanitizer::_compile(const std::string &src_file_path, const std::string &resulted_binary_path,
+  const std::string &compile_cmd, const std::vector<std::string> &cmds, const char *source, size_t source_length) const
+{
+  // passed through the shell instead of setenv, so that several test cases can be compiled concurrently
+  const std::string environment = "SOURCE_FILE=" + shell_quote(src_file_path) + " GENERATED_BINARY=" + shell_quote(resulted_binary_path) +
+    "; export SOURCE_FILE GENERATED_BINARY; ";
+
+  const std::string flags = defines + include_flags;
+  Logger::flush(); // the messages of the evaluator precede those of the compiler
   int res;
-  if ( (res = system( (compile_cmd + " " + defines).c_str() ) ) != 0)
   {
-    std::cerr << "Command " << compile_cmd << " " << defines << " failed: " << res << "\n";
-    return false;
+    TraceSpan compile_span("compile");
+    if ( source )
+    {
+      // the compiler may exit without consuming its input; that is reported as failed compilation
+      bool written = false;
+      if ( (res = run_with_input(environment + compile_cmd + " " + flags, source, source_length, written)) != 0 || !written )
+      {
+        std::cerr << "Command " << compile_cmd << " " << flags << " failed: " << res << "\n";
+        return false;
+      }
+    }
+    else if ( (res = system( (environment + compile_cmd + " " + flags).c_str() ) ) != 0)
+    {
+      std::cerr << "Command " << compile_cmd << " " << flags << " failed: " << res << "\n";
+      return false;
+    }
   }
 
   for (const std::string &cmd: cmds)
   {
-    if ( (res = system( cmd.c_str() ) ) != 0)
+    TraceSpan setup_span("setup", "", cmd);
+    if ( (res = system( (environment + cmd).c_str() ) ) != 0)
     {
       std::cerr << "Command " << cmd << " " << defines << " failed: " << res << "\n";
       return false;
@@ -297,68 +641,55 @@ bool Sanitizer::_compile(const std::string &src_file_path, const std::string &re
 }
 
 
-exec_result_t Sanitizer::execute(const std::string &binary_path) const
+exec_result_t Sanitizer::execute(const std::string &binary_path, CancellationToken *cancellation, size_t *peak_memory_kb,
+  double *detection_latency_seconds) const
 {
-  if ( access(binary_path.c_str(), X_OK) != 0 )
+  exec_result_t result;
+  std::string error;
+  if ( !_execute_command(execute_command, binary_path, exec_env_vars, cancellation, peak_memory_kb, detection_latency_seconds, result, error) )
   {
-    std::cerr << "File is not executable: " << binary_path << "\n";
+    std::cerr << error;
     exit(EXIT_FAILURE);
   }
-  std::vector<std::string> binary_args;
-  std::istringstream command_stream(execute_command);
+  return result;
+}
 
-  std::string token;
-  std::string executable;
-  if (command_stream >> token)
-  {
-    size_t index = token.find("$GENERATED_BINARY", 0);
-    if (index != std::string::npos)
-    {
-      // reserved name, to be replaced
-      token.replace(index, std::string("$GENERATED_BINARY").size(), binary_path);
-    }
-    executable = token;
-  }
-  if (executable.empty())
-  {
-    std::cerr << "Execute command not given!\n";
-    exit(EXIT_FAILURE);
-  }
-  if ( access(executable.c_str(), X_OK) != 0 )
+exec_result_t Sanitizer::execute_baseline(const std::string &binary_path, CancellationToken *cancellation, size_t *peak_memory_kb) const
+{
+  exec_result_t result;
+  std::string error;
+  if ( !_execute_command(baseline_execute_command, binary_path, {}, cancellation, peak_memory_kb, nullptr, result, error) )
   {
-    std::cerr << "File is not executable: " << executable << "\n";
+    std::cerr << error;
     exit(EXIT_FAILURE);
   }
-  while (command_stream >> token)
-  {
-    size_t index = token.find("$GENERATED_BINARY", 0);
-    if (index != std::string::npos)
-    {
-      // reserved name, to be replaced
-      token.replace(index, std::string("$GENERATED_BINARY").size(), binary_path);
-    }
-    binary_args.push_back(token);
-  }
-
-
-  return _execute(
-    executable,
-    binary_args,
-    exec_env_vars,
-    timeout_in_secs
-  );
+  return result;
 }
 
+bool Sanitizer::try_execute(const std::string &binary_path, bool is_baseline, exec_result_t &result, std::string &error) const
+{
+  return is_baseline ? _execute_command(baseline_execute_command, binary_path, {}, nullptr, nullptr, nullptr, result, error)
+    : _execute_command(execute_command, binary_path, exec_env_vars, nullptr, nullptr, nullptr, result, error);
+}
 
-exec_result_t Sanitizer::execute_baseline(const std::string &binary_path) const
+bool Sanitizer::_execute_command(
+  const std::string &command,
+  const std::string &binary_path,
+  const std::vector< std::tuple<std::string, std::string> > &env_vars,
+  CancellationToken *cancellation,
+  size_t *peak_memory_kb,
+  double *detection_latency_seconds,
+  exec_result_t &result,
+  std::string &error
+) const
 {
   if ( access(binary_path.c_str(), X_OK) != 0 )
   {
-    std::cerr << "File is not executable: " << binary_path << "\n";
-    exit(EXIT_FAILURE);
+    error = "File is not executable: " + binary_path + "\n";
+    return false;
   }
   std::vector<std::string> binary_args;
-  std::istringstream command_stream(baseline_execute_command);
+  std::istringstream command_stream(command);
 
   std::string token;
   std::string executable;
@@ -374,13 +705,13 @@ exec_result_t Sanitizer::execute_baseline(const std::string &binary_path) const
   }
   if (executable.empty())
   {
-    std::cerr << "Execute command not given!\n";
-    exit(EXIT_FAILURE);
+    error = "Execute command not given!\n";
+    return false;
   }
   if ( access(executable.c_str(), X_OK) != 0 )
   {
-    std::cerr << "File is not executable: " << executable << "\n";
-    exit(EXIT_FAILURE);
+    error = "File is not executable: " + executable + "\n";
+    return false;
   }
   while (command_stream >> token)
   {
@@ -396,40 +727,78 @@ exec_result_t Sanitizer::execute_baseline(const std::string &binary_path) const
   return _execute(
     executable,
     binary_args,
-    {},
-    timeout_in_secs
+    env_vars,
+    timeout_in_secs,
+    cancellation,
+    peak_memory_kb,
+    detection_latency_seconds,
+    result,
+    error
   );
 }
 
-exec_result_t Sanitizer::_execute(
+bool Sanitizer::_execute(
   const std::string &binary_path,
   const std::vector<std::string> &binary_args,
   const std::vector< std::tuple<std::string, std::string> > &env_vars,
-  const int timeout_s
+  const int timeout_s,
+  CancellationToken *cancellation,
+  size_t *peak_memory_kb,
+  double *detection_latency_seconds,
+  exec_result_t &result,
+  std::string &error
 ) const
 {
+  const ExecutionCgroup cgroup(resource_limits); // before forking, so that the test case can join it
+  // the test case writes the time it triggers its bug at TRIGGER_OFFSET, and the intermediate process the time the
+  // test case terminated at TERMINATION_OFFSET
+  const int trigger_fd = detection_latency_seconds ? memfd_create("mset_trigger", MFD_CLOEXEC) : -1;
+  TraceSpan execute_span("execute");
+  const Trace::time_point_t execute_start = std::chrono::steady_clock::now();
+  // receives the errno of a child process that cannot start the test case; closed on executing it
+  int start_error_pipe[2];
+  if ( pipe2(start_error_pipe, O_CLOEXEC) != 0 )
+  {
+    error = std::string("pipe: ") + strerror(errno) + "\n";
+    if ( trigger_fd != -1 ) close(trigger_fd);
+    return false;
+  }
+  Logger::flush(); // the messages of the evaluator precede those of the test case
   pid_t pid = fork();
   if (pid == -1)
   {
-    perror("fork");
-    exit(EXIT_FAILURE);
+    error = std::string("fork: ") + strerror(errno) + "\n";
+    close(start_error_pipe[0]);
+    close(start_error_pipe[1]);
+    if ( trigger_fd != -1 ) close(trigger_fd);
+    return false;
   }
-  
+
   if (pid == 0)
   {
+    if (cancellation)
+    {
+      setpgid(0, 0); // the test case and the timeout process join the group, so that all are killed on cancellation
+    }
+    close(start_error_pipe[0]);
     pid_t test_case_pid = fork();
     if (test_case_pid == -1)
     {
-      perror("fork");
-      exit(EXIT_FAILURE);
+      exit_with_start_error(start_error_pipe[1]);
     }
     if (test_case_pid == 0)
     {
+      cgroup.join();
+      apply_rlimits(resource_limits);
       // set sanitizer specific environment variables for this test case
       for (auto env_var: env_vars)
       {
         setenv(std::get<0>(env_var).c_str(), std::get<1>(env_var).c_str(), /*overwrite=*/1);
       }
+      if ( trigger_fd != -1 && fcntl(trigger_fd, F_SETFD, 0) == 0 ) // inherited by the test case only
+      {
+        setenv(TRIGGER_FD_VARIABLE, std::to_string(trigger_fd).c_str(), /*overwrite=*/1);
+      }
       // cast given args to C array of buffers
       const char **C_args = new const char *[binary_args.size() + 2]; // needs binary_path and NULL
       C_args[0] = binary_path.c_str();
@@ -441,6 +810,7 @@ exec_result_t Sanitizer::_execute(
       // run test case
       extern char **environ;
       execve(binary_path.c_str(), (char **)C_args, environ);
+      exit_with_start_error(start_error_pipe[1]);
     }
 
     pid_t timeout_pid = fork();
@@ -452,11 +822,19 @@ exec_result_t Sanitizer::_execute(
 
     int return_value = 0;
     int wstatus;
-    int exit_pid = wait(&wstatus);
+    struct rusage test_case_usage;
+    int exit_pid = wait4(-1, &wstatus, 0, &test_case_usage);
     if (exit_pid == test_case_pid)
     {
+      if ( trigger_fd != -1 ) write_timestamp(trigger_fd, TERMINATION_OFFSET);
       // exit without timeout
-      if ( WIFSIGNALED(wstatus) )
+      const size_t cpu_seconds = static_cast<size_t>(test_case_usage.ru_utime.tv_sec + test_case_usage.ru_stime.tv_sec);
+      if ( resource_limits.cpu_limit_seconds != 0 && WIFSIGNALED(wstatus)
+        && (WTERMSIG(wstatus) == SIGXCPU || (WTERMSIG(wstatus) == SIGKILL && cpu_seconds >= resource_limits.cpu_limit_seconds)) )
+      {
+        return_value = resource_exhausted_exit_value; // killed at the soft or, if it handled SIGXCPU, the hard CPU limit
+      }
+      else if ( WIFSIGNALED(wstatus) )
       {
         return_value = WTERMSIG(wstatus);
       }
@@ -474,12 +852,56 @@ exec_result_t Sanitizer::_execute(
       wait(nullptr); // collect test case process
       return_value = timeout_exit_value; // notify timeout
     }
-    exit(return_value); // notify parent of return value
+    _exit(return_value); // notify parent of return value, without running the destructors of the evaluator
+  }
+
+  if (cancellation)
+  {
+    setpgid(pid, pid); // also here, the group must exist before cancel() may kill it
+    if ( !cancellation->start(pid) ) kill(-pid, SIGKILL);
   }
 
+  close(start_error_pipe[1]);
   int wstatus;
   int return_value = 0;
-  waitpid(pid, &wstatus, 0);
+  struct rusage usage;
+  wait4(pid, &wstatus, 0, &usage); // the peak memory of a waited child covers the test case it waited for
+  int start_error = 0;
+  const bool has_start_error = read(start_error_pipe[0], &start_error, sizeof(start_error)) == sizeof(start_error);
+  close(start_error_pipe[0]);
+  if ( detection_latency_seconds )
+  {
+    *detection_latency_seconds = -1;
+    int64_t trigger_time = 0;
+    int64_t termination_time = 0;
+    if ( trigger_fd != -1
+      && pread(trigger_fd, &trigger_time, sizeof(trigger_time), TRIGGER_OFFSET) == sizeof(trigger_time) && trigger_time != 0
+      && pread(trigger_fd, &termination_time, sizeof(termination_time), TERMINATION_OFFSET) == sizeof(termination_time) && termination_time != 0 )
+    {
+      *detection_latency_seconds = static_cast<double>(termination_time - trigger_time) / 1e9;
+    }
+  }
+  if ( trigger_fd != -1 )
+  {
+    close(trigger_fd);
+  }
+  if (cancellation)
+  {
+    cancellation->finish();
+    if ( cancellation->is_cancelled() )
+    {
+      result = SUCCESSFUL; // discarded by the caller
+      return true;
+    }
+  }
+  if ( has_start_error )
+  {
+    error = "Cannot execute " + binary_path + ": " + strerror(start_error) + "\n";
+    return false;
+  }
+  size_t peak_kb = cgroup.is_active() ? cgroup.get_peak_memory_kb() : 0;
+  if ( peak_kb == 0 ) peak_kb = static_cast<size_t>(usage.ru_maxrss);
+  if ( peak_memory_kb ) *peak_memory_kb = peak_kb;
   if ( WIFSIGNALED(wstatus) )
   {
     return_value = WTERMSIG(wstatus);
@@ -489,11 +911,28 @@ exec_result_t Sanitizer::_execute(
     return_value = WEXITSTATUS(wstatus);
   }
 
-  if ( return_value == preconditions_not_met_exit_value) return PRECONDITIONS_FAILED;
-  if ( return_value == SIGSEGV) return FAILED_SIGSEGV;
-  if ( test_case_failed_exit_values.find(return_value) != test_case_failed_exit_values.end() ) return FAILED;
-  if ( return_value == test_case_successful_exit_value) return SUCCESSFUL;
-  if ( return_value == timeout_exit_value) return TIMEOUT;
-  std::cerr << "WARNING: Execution return value " << return_value << " not configured. Assume bug detected\n";
-  return FAILED;
+  // only a limit that is set and was hit exhausts the resources; OOM kills are only recorded by the cgroup
+  if ( (resource_limits.cpu_limit_seconds != 0 && return_value == resource_exhausted_exit_value) || cgroup.was_oom_killed() )
+  {
+    // not a detection, whatever the test case returned
+    std::cerr << "Test case exhausted its resources, peak memory: " << peak_kb / 1024 << " MiB\n";
+    result = RESOURCE_EXHAUSTED;
+    return true;
+  }
+  if ( return_value == timeout_exit_value && Trace::is_enabled() )
+  {
+    // the test case is killed by the intermediate process once the timeout expires
+    Trace::add_span("timeout kill", execute_start + std::chrono::seconds(timeout_s), std::chrono::steady_clock::now());
+  }
+  if ( return_value == preconditions_not_met_exit_value) result = PRECONDITIONS_FAILED;
+  else if ( return_value == SIGSEGV) result = FAILED_SIGSEGV;
+  else if ( test_case_failed_exit_values.find(return_value) != test_case_failed_exit_values.end() ) result = FAILED;
+  else if ( return_value == test_case_successful_exit_value) result = SUCCESSFUL;
+  else if ( return_value == timeout_exit_value) result = TIMEOUT;
+  else
+  {
+    std::cerr << "WARNING: Execution return value " << return_value << " not configured. Assume bug detected\n";
+    result = FAILED;
+  }
+  return true;
 }
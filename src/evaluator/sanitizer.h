@@ -7,11 +7,15 @@
 
 #pragma once
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 #include <tuple>
 
+#include "evaluator/cancellation_token.h"
+#include "evaluator/resource_limits.h"
+
 enum exec_result_t
 {
   PRECONDITIONS_FAILED,
@@ -19,7 +23,9 @@ enum exec_result_t
   FAILED_SIGSEGV,
   TIMEOUT,
   INVALID,
-  SUCCESSFUL
+  SUCCESSFUL,
+  COMPILE_FAILED, // the sanitizer failed to compile the variant
+  RESOURCE_EXHAUSTED // the test case exceeded its memory or CPU limit, or was killed by the OOM killer
 };
 
 inline std::string exec_result_to_string(const exec_result_t result)
@@ -34,6 +40,10 @@ inline std::string exec_result_to_string(const exec_result_t result)
       return "INVALID";
     case SUCCESSFUL:
       return "SUCCESSFUL";
+    case COMPILE_FAILED:
+      return "COMPILE FAILED";
+    case RESOURCE_EXHAUSTED:
+      return "RESOURCE EXHAUSTED";
     case FAILED_SIGSEGV:
     case TIMEOUT:
     default:
@@ -45,14 +55,74 @@ inline std::string exec_result_to_string(const exec_result_t result)
 class Sanitizer
 {
 public:
+  /**
+   * Parses the configuration at config_path, exiting on errors.
+   */
   explicit Sanitizer(const std::string &config_path);
 
+  /**
+   * Parses the configuration at config_path. Returns nullptr and sets error if it is invalid.
+   */
+  static std::unique_ptr<Sanitizer> load(const std::string &config_path, std::string &error);
+
   bool compile(const std::string &src_file_path, const std::string &binary_path) const;
-  exec_result_t execute(const std::string &binary_path) const;
+  /**
+   * Executes a binary. If given, cancellation can stop the execution from another thread; the result is then meaningless.
+   * If given, peak_memory_kb is set to the peak memory usage of the execution, and detection_latency_seconds to the
+   * time from the test case triggering its bug (see _trigger() in the prelude) until it terminated, or to -1 if it did
+   * not trigger it.
+   */
+  exec_result_t execute(const std::string &binary_path, CancellationToken *cancellation = nullptr, size_t *peak_memory_kb = nullptr,
+    double *detection_latency_seconds = nullptr) const;
 
   bool compile_baseline(const std::string &src_file_path, const std::string &binary_path) const;
-  exec_result_t execute_baseline(const std::string &binary_path) const;
+  exec_result_t execute_baseline(const std::string &binary_path, CancellationToken *cancellation = nullptr, size_t *peak_memory_kb = nullptr) const;
+
+  /**
+   * Executes a binary like execute(), resp. execute_baseline(). Returns false and sets error instead of exiting if the
+   * binary cannot be executed.
+   */
+  bool try_execute(const std::string &binary_path, bool is_baseline, exec_result_t &result, std::string &error) const;
+
+  /**
+   * Compile a source held in memory. The source is piped to the compiler, i.e., $SOURCE_FILE is replaced by "-x c -".
+   */
+  bool compile_from_memory(const char *source, size_t source_length, const std::string &binary_path) const;
+  bool compile_baseline_from_memory(const char *source, size_t source_length, const std::string &binary_path) const;
+
+  /**
+   * Adds an include directory to all following compilations, e.g., the one holding the shared test case prelude. It
+   * is not part of the compile signature, since it only tells where the included files are.
+   */
+  void add_include_dir(const std::string &dir_path) { include_flags += " -I\"" + dir_path + "\""; }
+
+  const std::string &get_name() const { return sanitizer_name; }
+
+  /**
+   * Whether the value of an <env_var> holds alternatives, i.e., value lists like "redzone={16,32,64}" or ranges like
+   * "quarantine_size_mb={0..256..64}", so that the configuration describes a sweep.
+   */
+  bool is_sweep() const;
+
+  /**
+   * The points of a sweep, one sanitizer per combination of the alternatives, with the chosen values in its name, e.g.,
+   * "ASan+redzone=32". Returns just this sanitizer if it is not a sweep. A sweep must be expanded before executing.
+   */
+  std::vector<Sanitizer> expand_sweep() const;
+
+  /**
+   * Everything besides the source that determines a binary, resp. the result of executing a binary.
+   */
+  std::string get_compile_signature(bool is_baseline) const;
+  std::string get_run_signature(bool is_baseline) const;
+
+  /**
+   * Whether executing the same binary always gives the same result, so that results can be reused (see BuildCache).
+   */
+  bool is_deterministic() const { return deterministic; }
 private:
+  Sanitizer() = default;
+
   std::vector<std::string> setup_commands;
   std::string compile_command;
   std::vector<std::string> baseline_setup_commands;
@@ -66,15 +136,40 @@ private:
   std::set<int> test_case_failed_exit_values;
   int preconditions_not_met_exit_value;
   int timeout_exit_value;
+  int resource_exhausted_exit_value;
   int timeout_in_secs;
+  resource_limits_t resource_limits;
+  bool deterministic = false;
 
   std::string defines;
+  std::string include_flags; // see add_include_dir()
+
+  bool parse(const std::string &config_path, std::string &error);
 
-  bool _compile(const std::string &src_file_path, const std::string &resulted_binary_path, const std::string &compile_command, const std::vector<std::string> &commands) const;
+  bool _compile(const std::string &src_file_path, const std::string &resulted_binary_path, const std::string &compile_command, const std::vector<std::string> &commands,
+    const char *source = nullptr, size_t source_length = 0) const;
+
+  /**
+   * Executes command with $GENERATED_BINARY replaced by binary_path. Returns false and sets error if it cannot.
+   */
+  bool _execute_command(
+    const std::string &command,
+    const std::string &binary_path,
+    const std::vector< std::tuple<std::string, std::string> > &env_vars,
+    CancellationToken *cancellation,
+    size_t *peak_memory_kb,
+    double *detection_latency_seconds,
+    exec_result_t &result,
+    std::string &error) const;
 
-  exec_result_t _execute(
+  bool _execute(
     const std::string &binary_path,
     const std::vector<std::string> &binary_args,
     const std::vector< std::tuple<std::string, std::string> > &env_vars,
-    int timeout_s) const;
+    int timeout_s,
+    CancellationToken *cancellation,
+    size_t *peak_memory_kb,
+    double *detection_latency_seconds,
+    exec_result_t &result,
+    std::string &error) const;
 };
@@ -0,0 +1,122 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <queue>
+#include <thread>
+
+Scheduler::Scheduler(size_t thread_count):
+  thread_count(thread_count == 0 ? 1 : thread_count)
+{
+}
+
+void Scheduler::add(std::function<void()> job, double expected_duration)
+{
+  jobs.push_back(std::move(job));
+  expected_durations.push_back(expected_duration);
+}
+
+std::vector<double> Scheduler::get_expected_durations() const
+{
+  double known_total = 0;
+  size_t known_count = 0;
+  for ( const double expected_duration: expected_durations )
+  {
+    if ( expected_duration < 0 ) continue;
+    known_total += expected_duration;
+    known_count++;
+  }
+  const double average = known_count == 0 ? 0 : known_total / static_cast<double>(known_count);
+  std::vector<double> durations = expected_durations;
+  for ( double &duration: durations )
+  {
+    if ( duration < 0 ) duration = average;
+  }
+  return durations;
+}
+
+// longest expected duration first, stable for equal durations
+static std::vector<size_t> get_start_order(const std::vector<double> &durations)
+{
+  std::vector<size_t> order(durations.size());
+  for ( size_t i = 0; i < order.size(); i++ )
+  {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&durations](size_t lhs, size_t rhs) { return durations[lhs] > durations[rhs]; });
+  return order;
+}
+
+double Scheduler::estimate_makespan() const
+{
+  // each job starts on the thread that becomes free first
+  const std::vector<double> durations = get_expected_durations();
+  std::priority_queue<double, std::vector<double>, std::greater<double>> thread_ends;
+  for ( size_t i = 0; i < thread_count; i++ )
+  {
+    thread_ends.push(0);
+  }
+  double makespan = 0;
+  for ( const size_t job: get_start_order(durations) )
+  {
+    const double end = thread_ends.top() + durations[job];
+    thread_ends.pop();
+    thread_ends.push(end);
+    makespan = std::max(makespan, end);
+  }
+  return makespan;
+}
+
+double Scheduler::get_expected_total() const
+{
+  const std::vector<double> durations = get_expected_durations();
+  return std::accumulate(durations.begin(), durations.end(), 0.0);
+}
+
+void Scheduler::run(const std::function<void(double)> &on_finished)
+{
+  const std::vector<double> durations = get_expected_durations();
+  const std::vector<size_t> order = get_start_order(durations);
+  std::atomic<size_t> next_job{0};
+  auto worker = [this, &next_job, &order, &durations, &on_finished]()
+  {
+    for ( size_t i = next_job++; i < order.size(); i = next_job++ )
+    {
+      jobs[order[i]]();
+      if ( on_finished ) on_finished(durations[order[i]]);
+    }
+  };
+
+  if ( thread_count == 1 || jobs.size() <= 1 )
+  {
+    worker();
+  }
+  else
+  {
+    std::vector<std::thread> threads;
+    for ( size_t i = 0; i < thread_count && i < jobs.size(); i++ )
+    {
+      threads.emplace_back(worker);
+    }
+    for ( auto &thread: threads )
+    {
+      thread.join();
+    }
+  }
+  jobs.clear();
+  expected_durations.clear();
+}
+
+size_t Scheduler::get_default_thread_count()
+{
+  const unsigned int cpus = std::thread::hardware_concurrency();
+  return cpus == 0 ? 1 : cpus;
+}
@@ -0,0 +1,57 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * Runs independent jobs, e.g., compiling and executing the variants of a test case with one sanitizer, on a fixed
+ * number of threads. Jobs are started longest expected duration first (LPT), so that no long job is left to run
+ * alone at the end; jobs with the same expected duration are started in the order they were added. With a single
+ * thread, jobs run on the calling thread. Jobs synchronize the state they share themselves.
+ */
+class Scheduler
+{
+public:
+  explicit Scheduler(size_t thread_count);
+
+  /**
+   * Adds a job expected to take expected_duration seconds. A job with a negative expected duration, i.e., without
+   * any history, is assumed to take as long as the average job with history.
+   */
+  void add(std::function<void()> job, double expected_duration = 0);
+
+  /**
+   * Expected time until all added jobs are done, given the order in which run() starts them.
+   */
+  double estimate_makespan() const;
+
+  /**
+   * Sum of the expected durations of all added jobs.
+   */
+  double get_expected_total() const;
+
+  /**
+   * Runs all added jobs and returns once they are done. If given, on_finished is called with the expected duration
+   * of each job once it is done, on the thread that ran it.
+   */
+  void run(const std::function<void(double)> &on_finished = nullptr);
+
+  /**
+   * Number of threads to use by default, i.e., the number of online CPUs.
+   */
+  static size_t get_default_thread_count();
+
+private:
+  std::vector<double> get_expected_durations() const;
+
+  size_t thread_count;
+  std::vector<std::function<void()>> jobs;
+  std::vector<double> expected_durations;
+};
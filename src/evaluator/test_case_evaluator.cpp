@@ -0,0 +1,91 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "test_case_evaluator.h"
+
+#include <algorithm>
+#include <cstdio>  // remove
+#include <iterator>
+#include <map>
+
+#include "evaluator/prelude.h"
+#include "evaluator/result_store.h"
+
+TestCaseEvaluator::TestCaseEvaluator(const Sanitizer &sanitizer, const std::string &binaries_dir, bool compute_baseline, bool run_all_variants):
+  sanitizer(sanitizer), binaries_dir(binaries_dir), compute_baseline(compute_baseline), run_all_variants(run_all_variants)
+{
+}
+
+bool TestCaseEvaluator::evaluate(const std::vector<GeneratedTestCase> &test_cases, const evaluation_callbacks_t &callbacks, std::string &error) const
+{
+  std::map<std::string, std::vector<std::shared_ptr<TestCaseInformation>>> variants_by_key;
+  for ( const GeneratedTestCase &test_case: test_cases )
+  {
+    std::shared_ptr<TestCaseInformation> variant = TestCaseInformation::parse_file_name(test_case.name, "", /*is_binary=*/true, error);
+    if ( !variant ) return false;
+    variant->set_source(test_case.source.data(), test_case.source.size());
+    variants_by_key[variant->get_test_case_key()].push_back(variant);
+  }
+
+  // compact test cases include the prelude, provided for this evaluation alone
+  Sanitizer run_sanitizer = sanitizer;
+  std::unique_ptr<Prelude> prelude;
+  if ( std::any_of(test_cases.begin(), test_cases.end(), [](const GeneratedTestCase &test_case) {
+    return Prelude::is_included(test_case.source.data(), test_case.source.size());
+  }) )
+  {
+    prelude = Prelude::write(error);
+    if ( !prelude ) return false;
+    run_sanitizer.add_include_dir(prelude->get_dir_path());
+  }
+
+  for ( auto &test_case: variants_by_key )
+  {
+    std::vector<std::shared_ptr<TestCaseInformation>> &variants = test_case.second;
+    std::sort(variants.begin(), variants.end(), compare_test_case_variants);
+    ResultStore results;
+    if ( compute_baseline )
+    {
+      std::vector<std::shared_ptr<TestCaseInformation>> normal_variants; // only normal phase for the baseline
+      std::copy_if(variants.begin(), variants.end(), std::back_inserter(normal_variants), [](const std::shared_ptr<TestCaseInformation> &variant) {
+        return !variant->get_is_validation();
+      });
+      if ( !evaluate_variants(run_sanitizer, normal_variants, /*is_baseline=*/true, results, callbacks, error) ) return false;
+    }
+    if ( !evaluate_variants(run_sanitizer, variants, /*is_baseline=*/false, results, callbacks, error) ) return false;
+
+    results.collapse();
+    if ( callbacks.on_test_case && results.size() > 0 )
+    {
+      callbacks.on_test_case(test_case.first, results.get_overall_result(0), results.get_overall_baseline_result(0));
+    }
+  }
+  return true;
+}
+
+bool TestCaseEvaluator::evaluate_variants(const Sanitizer &sanitizer, const std::vector<std::shared_ptr<TestCaseInformation>> &variants,
+  bool is_baseline, ResultStore &results, const evaluation_callbacks_t &callbacks, std::string &error) const
+{
+  for ( const auto &variant: variants )
+  {
+    const std::string binary_path = binaries_dir + "/" + variant->get_file_name_without_suffix() + (is_baseline ? "_baseline" : "");
+    const bool compiled = is_baseline
+      ? sanitizer.compile_baseline_from_memory(variant->get_source(), variant->get_source_length(), binary_path)
+      : sanitizer.compile_from_memory(variant->get_source(), variant->get_source_length(), binary_path);
+    exec_result_t result = COMPILE_FAILED;
+    if ( compiled )
+    {
+      const bool executed = sanitizer.try_execute(binary_path, is_baseline, result, error);
+      remove(binary_path.c_str());
+      if ( !executed ) return false;
+    }
+    if ( callbacks.on_variant ) callbacks.on_variant(*variant, is_baseline, result);
+
+    if ( results.add_variant(*variant, result, is_baseline) && !run_all_variants ) break;
+  }
+  return true;
+}
@@ -0,0 +1,64 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "evaluator/sanitizer.h"
+#include "evaluator/test_case_information.h"
+#include "generator/generator.h"
+
+class ResultStore;
+
+/**
+ * Receives the results of TestCaseEvaluator::evaluate(); either callback may be empty.
+ */
+struct evaluation_callbacks_t
+{
+  // called with the result of each evaluated variant, in evaluation order
+  std::function<void(const TestCaseInformation &variant, bool is_baseline, exec_result_t result)> on_variant;
+  // called once all variants of a test case are evaluated, with its overall results (see ResultStore::collapse());
+  // the baseline result is only meaningful with compute_baseline
+  std::function<void(const std::string &test_case_key, exec_result_t overall_result, exec_result_t overall_baseline_result)> on_test_case;
+};
+
+/**
+ * Evaluates test cases held in memory, e.g., from generate_in_memory(), with a sanitizer, for programs linking the
+ * mset_evaluator library. Unlike compile_and_evaluate(), it reports the results through callbacks instead of printing
+ * them, keeps no global state and returns its errors instead of exiting, so that several evaluators can run
+ * concurrently in the same process, each with its own binaries directory. The variants of a test case are evaluated
+ * in the same order and skipped on the same results as by compile_and_evaluate().
+ */
+class TestCaseEvaluator
+{
+public:
+  /**
+   * binaries_dir must exist; it receives the binaries while they are executed.
+   */
+  TestCaseEvaluator(const Sanitizer &sanitizer, const std::string &binaries_dir, bool compute_baseline = false, bool run_all_variants = false);
+
+  /**
+   * Evaluates test_cases, whose names must be the file names of generated test cases without ".c". Returns false and
+   * sets error if a test case cannot be evaluated; the results reported until then stay valid.
+   */
+  bool evaluate(const std::vector<GeneratedTestCase> &test_cases, const evaluation_callbacks_t &callbacks, std::string &error) const;
+
+private:
+  Sanitizer sanitizer;
+  std::string binaries_dir;
+  bool compute_baseline;
+  bool run_all_variants;
+
+  /**
+   * Evaluates the variants of a test case in order with sanitizer, until one decides it (see evaluate_variants() of the
+   * evaluator).
+   */
+  bool evaluate_variants(const Sanitizer &sanitizer, const std::vector<std::shared_ptr<TestCaseInformation>> &variants, bool is_baseline,
+    ResultStore &results, const evaluation_callbacks_t &callbacks, std::string &error) const;
+};
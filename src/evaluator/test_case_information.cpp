@@ -13,19 +13,34 @@
 #include <ostream>
 #include <utility>
 
-static void unsupported_file_name( const std::string &file_name, const std::string &reason )
+static std::shared_ptr<TestCaseInformation> unsupported_file_name( const std::string &file_name, const std::string &reason, std::string &error )
 {
-  std::cerr << "Unsupported file name \'" << file_name << "\'. " << reason << std::endl;
+  error = "Unsupported file name \'" + file_name + "\'. " + reason + "\n";
+  return nullptr;
 }
 
-static ssize_t find_prefix( std::string &in, const std::vector<std::string> &prefixes )
+// e.g., "4096x4096"; consumes the sizes from in
+static bool consume_object_sizes( std::string &in, size_t &origin_size, size_t &target_size )
+{
+  size_t index;
+  if ( in.empty() || !std::isdigit(in[0]) ) return false;
+  origin_size = std::stoull(in, &index);
+  if ( index >= in.size() || in[index] != 'x' ) return false;
+  in = in.substr(index + 1);
+  if ( in.empty() || !std::isdigit(in[0]) ) return false;
+  target_size = std::stoull(in, &index);
+  in = in.substr(index);
+  return origin_size > 0 && target_size > 0;
+}
+
+static ssize_t find_prefix( std::string &in, const PrimitiveDimension &dimension )
 {
   size_t i = 0;
-  for ( const auto& prefix: prefixes )
+  for ( const auto& names: dimension )
   {
-    if ( in.find(prefix) == 0 )
+    if ( in.find(names.name) == 0 )
     {
-      in = in.substr(prefix.length());
+      in = in.substr(strlen(names.name));
       return i;
     }
     i++;
@@ -33,103 +48,95 @@ static ssize_t find_prefix( std::string &in, const std::vector<std::string> &pre
   return -1;
 }
 
-std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_name(const std::string &file_name, const std::string &file_path, bool is_binary)
+std::shared_ptr<TestCaseInformation> TestCaseInformation::parse(const std::string &file_name, const std::string &file_path, bool is_binary, std::string &error)
 {
   std::string remaining_string = file_name;
   bool is_validation = false;
+  std::vector<uint8_t> dimension_ids;
 
   // e.g., misuse_of_free_freed_memory_global_direct_read_0
-  ssize_t found_at = find_prefix(remaining_string, temporal_bug_types);
+  ssize_t found_at = find_prefix(remaining_string, TEMPORAL_BUG_TYPES);
   bool is_temporal = found_at != -1;
   if ( is_temporal )
   {
-    std::string temporal_bug = temporal_bugs_info[found_at];
+    std::string temporal_bug = TEMPORAL_BUG_TYPES[found_at].printable_name;
+    dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
     if ( remaining_string.empty() )
     {
-      unsupported_file_name( file_name, "Expected temporal memory state.");
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected temporal memory state.", error );
     }
     if ( remaining_string[0] != '_' )
     {
-      unsupported_file_name( file_name, "Expected '_' before " + remaining_string);
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
     }
     remaining_string = remaining_string.substr(1); // consume the _
-    found_at = find_prefix(remaining_string, temporal_memory_states);
+    found_at = find_prefix(remaining_string, MEMORY_STATES);
     if (found_at == -1)
     {
-      unsupported_file_name( file_name, "Expected temporal memory state before " + remaining_string);
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected temporal memory state before " + remaining_string, error );
     }
-    std::string temporal_memory_state = temporal_memory_states_info[found_at];
+    std::string temporal_memory_state = MEMORY_STATES[found_at].printable_name;
+    dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
     if ( remaining_string.empty() )
     {
-      unsupported_file_name( file_name, "Expected region.");
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected region.", error );
     }
     if ( remaining_string[0] != '_' )
     {
-      unsupported_file_name( file_name, "Expected '_' before " + remaining_string);
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
     }
     remaining_string = remaining_string.substr(1); // consume the _
-    found_at = find_prefix(remaining_string, regions);
+    found_at = find_prefix(remaining_string, REGIONS);
     if (found_at == -1)
     {
-      unsupported_file_name( file_name, "Expected region before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected region before " + remaining_string, error );
     }
-    std::string region = regions_info[found_at];
+    std::string region = REGIONS[found_at].printable_name;
+    dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
     if ( remaining_string.empty() )
     {
-      unsupported_file_name( file_name, "Expected access location." );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected access location.", error );
     }
     if ( remaining_string[0] != '_' )
     {
-      unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
     }
     remaining_string = remaining_string.substr(1); // consume the _
-    found_at = find_prefix(remaining_string, access_locations);
+    found_at = find_prefix(remaining_string, ACCESS_LOCATIONS);
     if (found_at == -1)
     {
-      unsupported_file_name( file_name, "Expected access location before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected access location before " + remaining_string, error );
     }
-    std::string access_location = access_locations_info[found_at];
+    std::string access_location = ACCESS_LOCATIONS[found_at].printable_name;
+    dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
     if ( remaining_string.empty() )
     {
-      unsupported_file_name( file_name, "Expected access action." );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected access action.", error );
     }
     if ( remaining_string[0] != '_' )
     {
-      unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
     }
     remaining_string = remaining_string.substr(1); // consume the _
-    found_at = find_prefix(remaining_string, access_actions);
+    found_at = find_prefix(remaining_string, ACCESS_ACTIONS);
     if (found_at == -1)
     {
-      unsupported_file_name( file_name, "Expected an access action before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected an access action before " + remaining_string, error );
     }
-    std::string access_action = access_actions_info[found_at];
+    std::string access_action = ACCESS_ACTIONS[found_at].printable_name;
+    dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
     if ( remaining_string.empty() )
     {
-      unsupported_file_name( file_name, "Expected the variant number." );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected the variant number.", error );
     }
     if ( remaining_string[0] != '_' )
     {
-      unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
     }
     remaining_string = remaining_string.substr(1); // consume the _
     if ( !std::isdigit(remaining_string[0]) )
@@ -140,28 +147,24 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
         remaining_string = remaining_string.substr(strlen("validation"));
         if ( remaining_string.empty() )
         {
-          unsupported_file_name( file_name, "Expected the variant number." );
-          exit(EXIT_FAILURE);
+          return unsupported_file_name( file_name, "Expected the variant number.", error );
         }
         if ( remaining_string[0] != '_' )
         {
-          unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-          exit(EXIT_FAILURE);
+          return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
         }
         remaining_string = remaining_string.substr(1); // consume the _
       }
       else
       {
-        unsupported_file_name( file_name, "Expected a variant number or \"validation\" before " + remaining_string );
-        exit(EXIT_FAILURE);
+        return unsupported_file_name( file_name, "Expected a variant number or \"validation\" before " + remaining_string, error );
       }
     }
 
     size_t index;
     if ( !std::isdigit(remaining_string[0]) )
     {
-      unsupported_file_name( file_name, "Expected a variant number before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected a variant number before " + remaining_string, error );
     }
     int variant_number = std::stoi(remaining_string, &index);
 
@@ -171,8 +174,7 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
     {
       if (remaining_string != ".c")
       {
-        unsupported_file_name( file_name, "Must end with \".c\". Got " + remaining_string );
-        exit(EXIT_FAILURE);
+        return unsupported_file_name( file_name, "Must end with \".c\". Got " + remaining_string, error );
       }
       assert(file_name.length() >= 2);
       file_name_without_suffix = file_name.substr(0, file_name.length() - 2); // remove .c
@@ -181,14 +183,13 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
     {
       if ( !remaining_string.empty() && remaining_string != "_baseline" )
       {
-        unsupported_file_name( file_name, "\"" + remaining_string + "\" not expected." );
-        exit(EXIT_FAILURE);
+        return unsupported_file_name( file_name, "\"" + remaining_string + "\" not expected.", error );
       }
       file_name_without_suffix = file_name;
     }
 
 
-    return std::make_shared<TemporalTestCaseInformation>(
+    std::shared_ptr<TestCaseInformation> test_case_information = std::make_shared<TemporalTestCaseInformation>(
       region,
       temporal_bug,
       temporal_memory_state,
@@ -200,140 +201,141 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
       is_validation,
       variant_number
     );
+    test_case_information->dimension_ids = dimension_ids;
+    return test_case_information;
   }
 
-  found_at = find_prefix(remaining_string, spatial_bug_types);
+  found_at = find_prefix(remaining_string, SPATIAL_BUG_TYPES);
   bool is_spatial = found_at != -1;
   if (!is_spatial) return {};
 
-  std::string spatial_bug = spatial_bugs_info[found_at];
+  std::string spatial_bug = SPATIAL_BUG_TYPES[found_at].printable_name;
+
+  dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
   if ( remaining_string.empty() )
   {
-    unsupported_file_name( file_name, "Expected spatial origin." );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected spatial origin.", error );
   }
   if ( remaining_string[0] != '_' )
   {
-    unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
   }
   remaining_string = remaining_string.substr(1); // consume the _
-  found_at = find_prefix(remaining_string, regions);
+  found_at = find_prefix(remaining_string, REGIONS);
   if (found_at == -1)
   {
-    unsupported_file_name( file_name, "Expected spatial origin memory state before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected spatial origin memory state before " + remaining_string, error );
   }
-  std::string origin = regions_info[found_at];
+  std::string origin = REGIONS[found_at].printable_name;
+  dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
 
   if ( remaining_string.empty() )
   {
-    unsupported_file_name( file_name, "Expected spatial target." );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected spatial target.", error );
   }
   if ( remaining_string[0] != '_' )
   {
-    unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
   }
   remaining_string = remaining_string.substr(1); // consume the _
-  found_at = find_prefix(remaining_string, regions);
+  found_at = find_prefix(remaining_string, REGIONS);
   if (found_at == -1)
   {
-    unsupported_file_name( file_name, "Expected spatial target memory " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected spatial target memory " + remaining_string, error );
   }
-  std::string target = regions_info[found_at];
+  std::string target = REGIONS[found_at].printable_name;
+  dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
 
   if ( remaining_string.empty() )
   {
-    unsupported_file_name( file_name, "Expected origin-target relation." );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected origin-target relation.", error );
   }
   if ( remaining_string[0] != '_' )
   {
-    unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
   }
   remaining_string = remaining_string.substr(1); // consume the _
-  found_at = find_prefix(remaining_string, origin_target_relations);
+  found_at = find_prefix(remaining_string, ORIGIN_TARGET_RELATIONS);
   if (found_at == -1)
   {
-    unsupported_file_name( file_name, "Expected origin-target relation before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected origin-target relation before " + remaining_string, error );
   }
-  std::string origin_target_relation = origin_target_relations_info[found_at];
+  std::string origin_target_relation = ORIGIN_TARGET_RELATIONS[found_at].printable_name;
+  dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
 
   if ( remaining_string.empty() )
   {
-    unsupported_file_name( file_name, "Expected flow name." );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected flow name.", error );
   }
   if ( remaining_string[0] != '_' )
   {
-    unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
   }
   remaining_string = remaining_string.substr(1); // consume the _
-  found_at = find_prefix(remaining_string, flows);
+  found_at = find_prefix(remaining_string, FLOWS);
   if (found_at == -1)
   {
-    unsupported_file_name( file_name, "Expected flow name before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected flow name before " + remaining_string, error );
   }
-  std::string flow = flows_info[found_at];
+  std::string flow = FLOWS[found_at].printable_name;
+  dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
   if ( remaining_string.empty() )
   {
-    unsupported_file_name( file_name, "Expected access location." );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected access location.", error );
   }
   if ( remaining_string[0] != '_' )
   {
-    unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
   }
   remaining_string = remaining_string.substr(1); // consume the _
-  found_at = find_prefix(remaining_string, access_locations);
+  found_at = find_prefix(remaining_string, ACCESS_LOCATIONS);
   if (found_at == -1)
   {
-    unsupported_file_name( file_name, "Expected access location before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected access location before " + remaining_string, error );
   }
-  std::string access_location = access_locations_info[found_at];
+  std::string access_location = ACCESS_LOCATIONS[found_at].printable_name;
+  dimension_ids.push_back(static_cast<uint8_t>(found_at));
 
   if ( remaining_string.empty() )
   {
-    unsupported_file_name( file_name, "Expected access action." );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected access action.", error );
   }
   if ( remaining_string[0] != '_' )
   {
-    unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
   }
   remaining_string = remaining_string.substr(1); // consume the _
-  found_at = find_prefix(remaining_string, access_actions);
+  found_at = find_prefix(remaining_string, ACCESS_ACTIONS);
   if (found_at == -1)
   {
-    unsupported_file_name( file_name, "Expected an access action before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected an access action before " + remaining_string, error );
+  }
+  std::string access_action = ACCESS_ACTIONS[found_at].printable_name;
+  dimension_ids.push_back(static_cast<uint8_t>(found_at));
+
+  size_t origin_size = DEFAULT_OBJECT_SIZE;
+  size_t target_size = DEFAULT_OBJECT_SIZE;
+  if ( remaining_string.find("_size_") == 0 )
+  {
+    remaining_string = remaining_string.substr(strlen("_size_"));
+    if ( !consume_object_sizes(remaining_string, origin_size, target_size) )
+    {
+      return unsupported_file_name( file_name, "Expected object sizes such as 4096x4096 after \"_size_\".", error );
+    }
   }
-  std::string access_action = access_actions_info[found_at];
 
   if ( remaining_string.empty() )
   {
-    unsupported_file_name( file_name, "Expected the variant number." );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected the variant number.", error );
   }
   if ( remaining_string[0] != '_' )
   {
-    unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
   }
   remaining_string = remaining_string.substr(1); // consume the _
   if ( !std::isdigit(remaining_string[0]) )
@@ -344,27 +346,23 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
       remaining_string = remaining_string.substr(strlen("validation"));
       if ( remaining_string.empty() )
       {
-        unsupported_file_name( file_name, "Expected the variant number." );
-        exit(EXIT_FAILURE);
+        return unsupported_file_name( file_name, "Expected the variant number.", error );
       }
       if ( remaining_string[0] != '_' )
       {
-        unsupported_file_name( file_name, "Expected '_' before " + remaining_string );
-        exit(EXIT_FAILURE);
+        return unsupported_file_name( file_name, "Expected '_' before " + remaining_string, error );
       }
       remaining_string = remaining_string.substr(1); // consume the _
     }
     else
     {
-      unsupported_file_name( file_name, "Expected a variant number or \"validation\" before " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Expected a variant number or \"validation\" before " + remaining_string, error );
     }
   }
 
   if ( !std::isdigit(remaining_string[0]) )
   {
-    unsupported_file_name( file_name, "Expected a variant number before " + remaining_string );
-    exit(EXIT_FAILURE);
+    return unsupported_file_name( file_name, "Expected a variant number before " + remaining_string, error );
   }
   size_t index;
   int variant_number = std::stoi(remaining_string, &index);
@@ -375,8 +373,7 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
   {
     if (remaining_string != ".c")
     {
-      unsupported_file_name( file_name, "Must end with \".c\". Got " + remaining_string );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "Must end with \".c\". Got " + remaining_string, error );
     }
     assert(file_name.length() >= 2);
     file_name_without_suffix = file_name.substr(0, file_name.length() - 2); // remove .c
@@ -385,13 +382,12 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
   {
     if ( !remaining_string.empty() && remaining_string != "_baseline" )
     {
-      unsupported_file_name( file_name, "\"" + remaining_string + "\" not expected." );
-      exit(EXIT_FAILURE);
+      return unsupported_file_name( file_name, "\"" + remaining_string + "\" not expected.", error );
     }
     file_name_without_suffix = file_name;
   }
 
-  return std::make_shared<SpatialTestCaseInformation>(
+  std::shared_ptr<TestCaseInformation> test_case_information = std::make_shared<SpatialTestCaseInformation>(
     origin,
     target,
     origin_target_relation,
@@ -403,8 +399,117 @@ std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_na
     file_name_without_suffix,
     file_path,
     is_validation,
-    variant_number
+    variant_number,
+    origin_size,
+    target_size
   );
+  test_case_information->dimension_ids = dimension_ids;
+  return test_case_information;
+}
+
+std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_file_name(const std::string &file_name, const std::string &file_path, bool is_binary)
+{
+  std::string error;
+  std::shared_ptr<TestCaseInformation> test_case_information = parse(file_name, file_path, is_binary, error);
+  if ( !error.empty() )
+  {
+    std::cerr << error;
+    exit(EXIT_FAILURE);
+  }
+  return test_case_information;
+}
+
+std::shared_ptr<TestCaseInformation> TestCaseInformation::parse_file_name(const std::string &file_name, const std::string &file_path, bool is_binary, std::string &error)
+{
+  std::shared_ptr<TestCaseInformation> test_case_information = parse(file_name, file_path, is_binary, error);
+  if ( !test_case_information && error.empty() ) unsupported_file_name( file_name, "Expected a bug type.", error );
+  return test_case_information;
+}
+
+// dimensions in file name order
+static const PrimitiveDimension TEMPORAL_DIMENSIONS_ORDER[] = {
+  TEMPORAL_BUG_TYPES, MEMORY_STATES, REGIONS, ACCESS_LOCATIONS, ACCESS_ACTIONS
+};
+static const PrimitiveDimension SPATIAL_DIMENSIONS_ORDER[] = {
+  SPATIAL_BUG_TYPES, REGIONS, REGIONS, ORIGIN_TARGET_RELATIONS, FLOWS, ACCESS_LOCATIONS, ACCESS_ACTIONS
+};
+
+const PrimitiveDimension &TestCaseInformation::get_dimension_names(bool is_temporal, size_t dimension)
+{
+  return is_temporal ? TEMPORAL_DIMENSIONS_ORDER[dimension] : SPATIAL_DIMENSIONS_ORDER[dimension];
+}
+
+static bool are_valid_dimension_ids(const std::vector<uint8_t> &dimension_ids, const PrimitiveDimension *dimensions)
+{
+  for ( size_t i = 0; i < dimension_ids.size(); i++ )
+  {
+    if ( dimension_ids[i] >= dimensions[i].size() )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::shared_ptr<TestCaseInformation> TestCaseInformation::construct_from_dimension_ids(
+  const std::vector<uint8_t> &dimension_ids,
+  bool is_validation,
+  int variant_number,
+  const std::string &file_name_without_suffix,
+  size_t origin_size,
+  size_t target_size
+)
+{
+  std::shared_ptr<TestCaseInformation> test_case_information;
+  const std::string file_name = file_name_without_suffix + ".c";
+  if ( dimension_ids.size() == TEMPORAL_DIMENSIONS )
+  {
+    if ( !are_valid_dimension_ids(dimension_ids, TEMPORAL_DIMENSIONS_ORDER) )
+    {
+      return {};
+    }
+    test_case_information = std::make_shared<TemporalTestCaseInformation>(
+      REGIONS[dimension_ids[2]].printable_name,
+      TEMPORAL_BUG_TYPES[dimension_ids[0]].printable_name,
+      MEMORY_STATES[dimension_ids[1]].printable_name,
+      ACCESS_LOCATIONS[dimension_ids[3]].printable_name,
+      ACCESS_ACTIONS[dimension_ids[4]].printable_name,
+      file_name,
+      file_name_without_suffix,
+      "",
+      is_validation,
+      variant_number
+    );
+  }
+  else if ( dimension_ids.size() == SPATIAL_DIMENSIONS )
+  {
+    if ( !are_valid_dimension_ids(dimension_ids, SPATIAL_DIMENSIONS_ORDER) )
+    {
+      return {};
+    }
+    test_case_information = std::make_shared<SpatialTestCaseInformation>(
+      REGIONS[dimension_ids[1]].printable_name,
+      REGIONS[dimension_ids[2]].printable_name,
+      ORIGIN_TARGET_RELATIONS[dimension_ids[3]].printable_name,
+      SPATIAL_BUG_TYPES[dimension_ids[0]].printable_name,
+      FLOWS[dimension_ids[4]].printable_name,
+      ACCESS_LOCATIONS[dimension_ids[5]].printable_name,
+      ACCESS_ACTIONS[dimension_ids[6]].printable_name,
+      file_name,
+      file_name_without_suffix,
+      "",
+      is_validation,
+      variant_number,
+      origin_size,
+      target_size
+    );
+  }
+  else
+  {
+    return {};
+  }
+  test_case_information->dimension_ids = dimension_ids;
+  return test_case_information;
 }
 
 
@@ -458,7 +563,9 @@ SpatialTestCaseInformation::SpatialTestCaseInformation(
   const std::string &file_name_without_suffix,
   const std::string& file_path,
   const bool is_validation,
-  const int variant_number
+  const int variant_number,
+  const size_t origin_size,
+  const size_t target_size
   ):
   TestCaseInformation(is_validation, variant_number, file_name, file_name_without_suffix, file_path),
   origin_name(origin_name),
@@ -469,13 +576,24 @@ SpatialTestCaseInformation::SpatialTestCaseInformation(
   access_location_name(access_location_name),
   access_action_name(access_action_name)
 {
+  this->origin_size = origin_size;
+  this->target_size = target_size;
+  std::string sizes;
+  if ( !has_default_object_sizes() )
+  {
+    sizes = ", " + get_object_sizes_name() + " bytes";
+  }
 
   as_string = origin_target_relation_name + " " + spatial_bug_name + " " + flow_name + " " +
       access_location_name + " " + access_action_name + " on (" +
-      origin_name + ", " + target_name + "), variant " + std::to_string(variant_number);
+      origin_name + ", " + target_name + sizes + "), variant " + std::to_string(variant_number);
   key = origin_target_relation_name + " " + spatial_bug_name + " " + flow_name + " " +
       access_location_name + " " + access_action_name + " " +
       origin_name + " " + target_name;
+  if ( !has_default_object_sizes() )
+  {
+    key += " " + get_object_sizes_name();
+  }
 }
 
 bool compare_test_case_variants(const std::shared_ptr<TestCaseInformation>& lhs, const std::shared_ptr<TestCaseInformation>& rhs)
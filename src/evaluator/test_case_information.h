@@ -6,96 +6,12 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
-const std::vector<std::string> regions ={
-  "heap",
-  "stack",
-  "global"
-};
-const std::vector<std::string> regions_info ={
-  {"Heap"},
-  {"Stack"},
-  {"Global"}
-};
-
-
-const std::vector<std::string> temporal_bug_types ={
-  "misuse_of_free",
-  "double_free",
-  "use_after_star"
-};
-const std::vector<std::string> temporal_bugs_info ={
-  {"Misuse-of-free"},
-  {"Double-free"},
-  {"Use-after-*"}
-};
-
-
-const std::vector<std::string> temporal_memory_states ={
-  "used_memory",
-  "freed_memory",
-};
-const std::vector<std::string> temporal_memory_states_info ={
-  {"(Re)used Memory"},
-  {"Freed Memory"}
-};
-
-
-const std::vector<std::string> spatial_bug_types ={
-  "linear_ooba",
-  "non_linear_ooba",
-  "type_confusion_ooba"
-};
-const std::vector<std::string> spatial_bugs_info ={
-  {"Linear OOBA"},
-  {"Non-Linear OOBA"},
-  {"Type Confusion OOBA"}
-};
-
-
-const std::vector<std::string> origin_target_relations ={
-  "non_object",
-  "intra_object",
-  "inter_object",
-};
-const std::vector<std::string> origin_target_relations_info ={
-  {"Non-Object"},
-  {"Intra-Object"},
-  {"Inter-Object"},
-};
-
-
-const std::vector<std::string> flows ={
-  "overflow",
-  "underflow",
-};
-const std::vector<std::string> flows_info ={
-  {"Overflow"},
-  {"Underflow"}
-};
-
-
-const std::vector<std::string> access_locations ={
-  "stdlib",
-  "direct",
-};
-const std::vector<std::string> access_locations_info ={
-  {"Stdlib"},
-  {"Direct"}
-};
-
-
-const std::vector<std::string> access_actions ={
-  "read",
-  "write",
-};
-const std::vector<std::string> access_actions_info ={
-  {"Read"},
-  {"Write"}
-};
+#include "primitive_registry.h"
 
 class TestCaseInformation
 {
@@ -108,12 +24,66 @@ public:
   std::string get_file_path() const { return file_path; }
   bool get_is_validation() const { return is_validation; }
   int get_variant_number() const { return variant_number; }
-
+  bool is_temporal() const { return dimension_ids.size() == TEMPORAL_DIMENSIONS; }
+
+  /**
+   * Sizes of the origin and target objects of spatial test cases. Test cases generated with other sizes than the
+   * default carry them in their file name, e.g., "..._direct_read_size_4096x4096_0.c".
+   */
+  size_t get_origin_size() const { return origin_size; }
+  size_t get_target_size() const { return target_size; }
+  bool has_default_object_sizes() const { return origin_size == DEFAULT_OBJECT_SIZE && target_size == DEFAULT_OBJECT_SIZE; }
+  std::string get_object_sizes_name() const { return std::to_string(origin_size) + "x" + std::to_string(target_size); }
+
+  /**
+   * Primitive IDs (see primitive_registry.h), in file name order:
+   * temporal: bug type, memory state, region, access location, access action
+   * spatial: bug type, origin, target, origin-target relation, flow, access location, access action
+   */
+  const std::vector<uint8_t> &get_dimension_ids() const { return dimension_ids; }
+
+  /**
+   * Test cases loaded from a packed suite carry their source in memory instead of in file_path.
+   */
+  bool has_source_in_memory() const { return source != nullptr; }
+  const char *get_source() const { return source; }
+  size_t get_source_length() const { return source_length; }
+  void set_source(const char *source, size_t source_length) { this->source = source; this->source_length = source_length; }
+
+  static constexpr size_t TEMPORAL_DIMENSIONS = 5;
+  static constexpr size_t SPATIAL_DIMENSIONS = 7;
+  static constexpr size_t DEFAULT_OBJECT_SIZE = 8;
+
+  /**
+   * Names of the primitives of a dimension, with dimensions in file name order.
+   */
+  static const PrimitiveDimension &get_dimension_names(bool is_temporal, size_t dimension);
+
+  /**
+   * Exits on a malformed file_name; returns nullptr if it starts with no bug type.
+   */
   static std::shared_ptr<TestCaseInformation> construct_from_file_name(const std::string &file_name, const std::string &file_path, bool is_binary);
+  /**
+   * Returns nullptr and sets error if file_name is not the name of a test case, instead of exiting.
+   */
+  static std::shared_ptr<TestCaseInformation> parse_file_name(const std::string &file_name, const std::string &file_path, bool is_binary, std::string &error);
+  static std::shared_ptr<TestCaseInformation> construct_from_dimension_ids(
+    const std::vector<uint8_t> &dimension_ids,
+    bool is_validation,
+    int variant_number,
+    const std::string &file_name_without_suffix,
+    size_t origin_size = DEFAULT_OBJECT_SIZE,
+    size_t target_size = DEFAULT_OBJECT_SIZE
+  );
 
 protected:
   TestCaseInformation(bool is_validation, int variant_number, const std::string &file_name, const std::string &file_name_without_suffix, const std::string &file_path);
 
+  /**
+   * Returns nullptr and sets error if file_name is malformed, or leaves error empty if it starts with no bug type.
+   */
+  static std::shared_ptr<TestCaseInformation> parse(const std::string &file_name, const std::string &file_path, bool is_binary, std::string &error);
+
   std::string file_name;
   std::string file_name_without_suffix;
   std::string file_path;
@@ -124,6 +94,11 @@ protected:
   int variant_number;
   std::string as_string;
   std::string key; /* same for all variants */
+  std::vector<uint8_t> dimension_ids;
+  const char *source = nullptr;
+  size_t source_length = 0;
+  size_t origin_size = DEFAULT_OBJECT_SIZE;
+  size_t target_size = DEFAULT_OBJECT_SIZE;
 };
 
 
@@ -175,7 +150,9 @@ public:
     const std::string& file_name_without_suffix,
     const std::string& file_path,
     bool is_validation,
-    int variant_number
+    int variant_number,
+    size_t origin_size = DEFAULT_OBJECT_SIZE,
+    size_t target_size = DEFAULT_OBJECT_SIZE
   );
 
   std::string origin_name;
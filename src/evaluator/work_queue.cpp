@@ -0,0 +1,386 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "work_queue.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <netdb.h>
+#include <poll.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+#include "evaluator/logger.h"
+#include "misc.h"
+
+static const int CONNECT_ATTEMPTS = 30; // a worker may be started before its coordinator
+static const std::chrono::seconds CONNECT_RETRY_INTERVAL{1};
+static const std::chrono::seconds LEASE_RENEWAL_INTERVAL{10}; // of the lease of a worker on its job
+static const std::chrono::seconds LEASE_DURATION{60};         // after which a job whose lease is not renewed is requeued
+
+static bool is_unix_address(const std::string &address)
+{
+  return address.find('/') != std::string::npos || address.find(':') == std::string::npos;
+}
+
+/**
+ * Creates a socket bound to (listening) or connected to (!listening) address. Returns -1 on failure.
+ */
+static int open_socket(const std::string &address, bool listening)
+{
+  if ( is_unix_address(address) )
+  {
+    struct sockaddr_un unix_address{};
+    unix_address.sun_family = AF_UNIX;
+    if ( address.size() >= sizeof(unix_address.sun_path) ) return -1;
+    std::strcpy(unix_address.sun_path, address.c_str());
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if ( fd == -1 ) return -1;
+    if ( listening ) unlink(address.c_str());
+    const int res = listening ? bind(fd, reinterpret_cast<struct sockaddr *>(&unix_address), sizeof(unix_address))
+      : ::connect(fd, reinterpret_cast<struct sockaddr *>(&unix_address), sizeof(unix_address));
+    if ( res != 0 || (listening && listen(fd, SOMAXCONN) != 0) )
+    {
+      close(fd);
+      return -1;
+    }
+    return fd;
+  }
+
+  const size_t separator = address.rfind(':');
+  const std::string host = address.substr(0, separator);
+  const std::string port = address.substr(separator + 1);
+  struct addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  struct addrinfo *addresses;
+  // an empty host is the loopback interface rather than all interfaces, since workers are not authenticated
+  if ( getaddrinfo(host.empty() ? "localhost" : host.c_str(), port.c_str(), &hints, &addresses) != 0 ) return -1;
+  int fd = -1;
+  for ( struct addrinfo *candidate = addresses; candidate && fd == -1; candidate = candidate->ai_next )
+  {
+    fd = socket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+    if ( fd == -1 ) continue;
+    const int reuse = 1;
+    if ( listening ) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    const int res = listening ? bind(fd, candidate->ai_addr, candidate->ai_addrlen) : ::connect(fd, candidate->ai_addr, candidate->ai_addrlen);
+    if ( res != 0 || (listening && listen(fd, SOMAXCONN) != 0) )
+    {
+      close(fd);
+      fd = -1;
+    }
+  }
+  freeaddrinfo(addresses);
+  return fd;
+}
+
+static bool send_line(int fd, const std::string &line)
+{
+  const std::string data = line + "\n";
+  size_t sent = 0;
+  while ( sent < data.size() )
+  {
+    const ssize_t res = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if ( res < 0 && errno == EINTR ) continue;
+    if ( res <= 0 ) return false;
+    sent += static_cast<size_t>(res);
+  }
+  return true;
+}
+
+/**
+ * Reads what is available into buffer. Returns false once the connection is closed.
+ */
+static bool receive(int fd, std::string &buffer)
+{
+  char data[4096];
+  ssize_t length;
+  while ( (length = recv(fd, data, sizeof(data), 0)) < 0 && errno == EINTR ) { }
+  if ( length <= 0 ) return false;
+  buffer.append(data, static_cast<size_t>(length));
+  return true;
+}
+
+static bool take_line(std::string &buffer, std::string &line)
+{
+  const size_t end = buffer.find('\n');
+  if ( end == std::string::npos ) return false;
+  line = buffer.substr(0, end);
+  buffer.erase(0, end + 1);
+  return true;
+}
+
+static std::string hash_header(const std::string &header)
+{
+  std::ostringstream hash;
+  hash << std::hex << fnv1a_64(header.data(), header.size());
+  return hash.str();
+}
+
+WorkQueue::WorkQueue(const std::string &header): header_hash(hash_header(header))
+{
+}
+
+void WorkQueue::add(const std::string &job, const std::string &group_id)
+{
+  jobs.emplace_back(job, group_id);
+}
+
+namespace
+{
+struct worker_t
+{
+  std::string buffer;
+  bool greeted = false;
+  bool waiting = false; // for a job, while none is queued
+  bool has_job = false;
+  std::chrono::steady_clock::time_point lease_end; // of the job, renewed with every line the worker sends
+  std::pair<std::string, std::string> job;
+  job_results_t results;
+};
+}
+
+bool WorkQueue::run(const std::string &address, const on_done_t &on_done)
+{
+  const int listen_fd = open_socket(address, /*listening=*/true);
+  if ( listen_fd == -1 )
+  {
+    std::cerr << "ERROR: Cannot listen on " << address << ": " << strerror(errno) << ".\n";
+    return false;
+  }
+  Logger(log_level_t::NORMAL) << "Waiting for workers on " << address << " to evaluate " << jobs.size() << " jobs.\n";
+
+  size_t remaining_jobs = jobs.size();
+  std::map<int, worker_t> workers; // per socket
+  auto hand_out = [this](int fd, worker_t &worker) {
+    if ( jobs.empty() )
+    {
+      worker.waiting = true;
+      return;
+    }
+    worker.job = jobs.front();
+    if ( !send_line(fd, "j " + worker.job.first + " " + worker.job.second) ) return; // the worker is dropped when polled
+    jobs.pop_front();
+    worker.waiting = false;
+    worker.has_job = true;
+    worker.lease_end = std::chrono::steady_clock::now() + LEASE_DURATION;
+    worker.results.clear();
+  };
+  auto drop = [this, &workers](int fd) {
+    worker_t &worker = workers.at(fd);
+    if ( worker.has_job )
+    {
+      Logger(log_level_t::NORMAL) << "Lost a worker, requeued job " << worker.job.first << " of test case " << worker.job.second << ".\n";
+      jobs.push_front(worker.job);
+    }
+    close(fd);
+    workers.erase(fd);
+  };
+
+  while ( remaining_jobs > 0 )
+  {
+    std::vector<struct pollfd> fds{{listen_fd, POLLIN, 0}};
+    bool has_leases = false;
+    for ( const auto &worker: workers )
+    {
+      fds.push_back({worker.first, POLLIN, 0});
+      has_leases |= worker.second.has_job;
+    }
+    const int timeout_ms = has_leases ? static_cast<int>(std::chrono::milliseconds(LEASE_RENEWAL_INTERVAL).count()) : -1;
+    if ( poll(fds.data(), fds.size(), timeout_ms) < 0 )
+    {
+      if ( errno == EINTR ) continue;
+      perror("poll");
+      break;
+    }
+    if ( fds[0].revents & POLLIN )
+    {
+      const int fd = accept(listen_fd, nullptr, nullptr);
+      if ( fd != -1 ) workers[fd];
+    }
+    for ( size_t i = 1; i < fds.size(); i++ )
+    {
+      if ( fds[i].revents == 0 ) continue;
+      const int fd = fds[i].fd;
+      worker_t &worker = workers.at(fd);
+      if ( !receive(fd, worker.buffer) )
+      {
+        drop(fd);
+        continue;
+      }
+      worker.lease_end = std::chrono::steady_clock::now() + LEASE_DURATION;
+      std::string line;
+      bool dropped = false;
+      while ( !dropped && take_line(worker.buffer, line) )
+      {
+        std::istringstream fields(line);
+        char type = 0;
+        fields >> type;
+        if ( type == 'h' )
+        {
+          std::string hash;
+          fields >> hash;
+          worker.greeted = hash == header_hash;
+          if ( !worker.greeted )
+          {
+            Logger(log_level_t::NORMAL) << "Rejected a worker evaluating with other sanitizers or options.\n";
+            send_line(fd, "x");
+          }
+        }
+        else if ( type == 'a' && worker.greeted )
+        {
+          continue; // the lease is renewed by any line
+        }
+        else if ( type == 'n' && worker.greeted && !worker.has_job )
+        {
+          hand_out(fd, worker);
+          continue;
+        }
+        else if ( type == 'r' && worker.has_job )
+        {
+          char phase = 0;
+          int result = -1;
+          fields >> phase >> result;
+          if ( (phase == 'b' || phase == 'v' || phase == 'n') && result >= PRECONDITIONS_FAILED && result <= RESOURCE_EXHAUSTED )
+          {
+            worker.results.emplace_back(phase, static_cast<exec_result_t>(result));
+            continue;
+          }
+        }
+        else if ( type == 'd' && worker.has_job )
+        {
+          worker.has_job = false;
+          remaining_jobs--;
+          on_done(worker.job.first, worker.job.second, worker.results);
+          continue;
+        }
+        if ( !worker.greeted || type != 'h' )
+        {
+          drop(fd); // rejected, or not following the protocol
+          dropped = true;
+        }
+      }
+    }
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<int> expired;
+    for ( const auto &worker: workers )
+    {
+      if ( worker.second.has_job && now > worker.second.lease_end ) expired.push_back(worker.first);
+    }
+    for ( const int fd: expired )
+    {
+      Logger(log_level_t::NORMAL) << "A worker did not renew its lease within " << LEASE_DURATION.count() << " s.\n";
+      drop(fd);
+    }
+    for ( auto &worker: workers )
+    {
+      if ( worker.second.waiting ) hand_out(worker.first, worker.second);
+    }
+  }
+
+  for ( const auto &worker: workers )
+  {
+    send_line(worker.first, "q");
+    close(worker.first);
+  }
+  close(listen_fd);
+  if ( is_unix_address(address) ) unlink(address.c_str());
+  return remaining_jobs == 0;
+}
+
+WorkerConnection::WorkerConnection(int fd): fd(fd), lease_thread(&WorkerConnection::renew_lease, this)
+{
+}
+
+WorkerConnection::~WorkerConnection()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    closing = true;
+  }
+  closing_changed.notify_one();
+  lease_thread.join();
+  close(fd);
+}
+
+bool WorkerConnection::send(const std::string &line)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return send_line(fd, line);
+}
+
+/**
+ * Renews the lease on the job every LEASE_RENEWAL_INTERVAL while one is evaluated, so that the coordinator only
+ * requeues the jobs of workers that hang or are unreachable, however long their jobs take.
+ */
+void WorkerConnection::renew_lease()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  while ( !closing_changed.wait_for(lock, LEASE_RENEWAL_INTERVAL, [this]() { return closing; }) )
+  {
+    if ( has_job ) send_line(fd, "a");
+  }
+}
+
+std::unique_ptr<WorkerConnection> WorkerConnection::connect(const std::string &address, const std::string &header)
+{
+  int fd = -1;
+  for ( int attempt = 0; attempt < CONNECT_ATTEMPTS && fd == -1; attempt++ )
+  {
+    if ( attempt > 0 ) std::this_thread::sleep_for(CONNECT_RETRY_INTERVAL);
+    fd = open_socket(address, /*listening=*/false);
+  }
+  if ( fd == -1 )
+  {
+    std::cerr << "ERROR: Cannot connect to the coordinator at " << address << ": " << strerror(errno) << ".\n";
+    return nullptr;
+  }
+  std::unique_ptr<WorkerConnection> connection(new WorkerConnection(fd));
+  if ( !connection->send("h " + hash_header(header)) ) return nullptr;
+  return connection;
+}
+
+bool WorkerConnection::next_job(std::string &job, std::string &group_id)
+{
+  if ( !send("n") ) return false;
+  std::string line;
+  while ( !take_line(buffer, line) )
+  {
+    if ( !receive(fd, buffer) ) return false;
+  }
+  std::istringstream fields(line);
+  char type = 0;
+  fields >> type;
+  if ( type == 'x' )
+  {
+    std::cerr << "ERROR: The coordinator evaluates with other sanitizers or options than this worker.\n";
+    return false;
+  }
+  if ( type != 'j' || !(fields >> job >> group_id) ) return false;
+  std::lock_guard<std::mutex> lock(mutex);
+  has_job = true;
+  return true;
+}
+
+bool WorkerConnection::send_results(const job_results_t &results)
+{
+  std::string records;
+  for ( const auto &result: results )
+  {
+    records += std::string("r ") + result.first + " " + std::to_string(static_cast<int>(result.second)) + "\n";
+  }
+  records += "d";
+  std::lock_guard<std::mutex> lock(mutex);
+  has_job = false;
+  return send_line(fd, records);
+}
@@ -0,0 +1,100 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "evaluator/sanitizer.h"
+
+typedef std::vector<std::pair<char, exec_result_t>> job_results_t; // phase and result of each evaluated variant, see Journal
+
+/**
+ * Hands out the jobs of an evaluation (the baseline or one sanitizer evaluating a test case group, as in the Journal)
+ * to workers connected over a TCP or Unix socket, see --coordinate and --worker. An address containing a '/' or no
+ * ':' is the path of a Unix socket, any other is <host>:<port>; an empty host listens on the loopback interface only,
+ * since workers are not authenticated.
+ *
+ * Workers pull one job at a time, so that fast workers take more jobs. A job is done once its worker sent all its
+ * results. The worker holds a lease on the job, which it renews while evaluating it; if the worker disconnects or its
+ * lease expires, e.g., since its machine hangs or is unreachable, the job is put back at the front of the queue for
+ * another worker. The protocol is line based:
+ *   worker: h <hash of the evaluation header>   once, rejected with x if the header differs from the coordinator's
+ *   worker: n                                   requests the next job
+ *   coordinator: j <job> <test case group ID>   or q once all jobs are done
+ *   worker: a                                   renews the lease on the job, every LEASE_RENEWAL_INTERVAL
+ *   worker: r <b|v|n> <exec_result_t>           per evaluated variant of the job
+ *   worker: d                                   the job is done
+ */
+class WorkQueue
+{
+public:
+  typedef std::function<void(const std::string &job, const std::string &group_id, const job_results_t &results)> on_done_t;
+
+  explicit WorkQueue(const std::string &header);
+
+  void add(const std::string &job, const std::string &group_id);
+  size_t size() const { return jobs.size(); }
+
+  /**
+   * Listens on address and hands out the jobs until all are done, calling on_done with the results of each. Returns
+   * false if it cannot listen on address.
+   */
+  bool run(const std::string &address, const on_done_t &on_done);
+
+private:
+  std::string header_hash;
+  std::deque<std::pair<std::string, std::string>> jobs;
+};
+
+/**
+ * The connection of a worker to the coordinator's WorkQueue.
+ */
+class WorkerConnection
+{
+public:
+  ~WorkerConnection();
+  WorkerConnection(const WorkerConnection &) = delete;
+  WorkerConnection &operator=(const WorkerConnection &) = delete;
+
+  /**
+   * Connects to the coordinator at address, retrying for a while until it listens. Returns nullptr on failure.
+   */
+  static std::unique_ptr<WorkerConnection> connect(const std::string &address, const std::string &header);
+
+  /**
+   * Requests the next job. Returns false once all jobs are done or if the connection is lost.
+   */
+  bool next_job(std::string &job, std::string &group_id);
+
+  bool send_results(const job_results_t &results);
+
+private:
+  explicit WorkerConnection(int fd);
+
+  /**
+   * Sends a line on the connection. Returns false if the connection is lost.
+   */
+  bool send(const std::string &line);
+
+  void renew_lease();
+
+  int fd;
+  std::string buffer; // received but not yet read
+  std::mutex mutex;   // guards sending, has_job and closing
+  bool has_job = false;
+  bool closing = false;
+  std::condition_variable closing_changed;
+  std::thread lease_thread; // see renew_lease()
+};
@@ -19,57 +19,98 @@ const std::string LICENSE =
   " */\n"
   "\n";
 
+const std::string CodeCanvas::PRELUDE_FILE_NAME = "mset_prelude.h";
+bool CodeCanvas::compact_emission = false;
+
+static const std::vector<std::string> PRELUDE = {
+  "#include <unistd.h> // _exit", // 0
+  "#include <stdint.h>", // 1
+  "#include <stdlib.h>", // 2
+  "#include <string.h>", // 3
+  "#include <time.h> // clock_gettime", // 4
+  "",                    // 5
+  "#ifdef ADDR_MASK",    // 6
+  "#define GET_ADDR_BITS(p) ((size_t)(p) & ADDR_MASK)",   // 7
+  "#else",                                                // 8
+  "#define GET_ADDR_BITS(p) ((size_t)(p) & (size_t)0xffffffffffffull)",             // 9
+  "#endif",                                               // 10
+  "#ifndef MAX_OBJECT_SIZE",                              // 11
+  "#define MAX_OBJECT_SIZE ((size_t)1 << 29)",            // 12
+  "#endif",                                               // 13
+  "",             // 14
+  "volatile void *_use(volatile void *p) { return p; }",  // 15
+  "const char content[8] = \"ZZZZZZZ\";",                 // 16
+  "// called right before the bug; writes the time to the file descriptor given by the evaluator, see --latency", // 17
+  "void _trigger()",                                      // 18
+  "{",                                                    // 19
+  "  const char *fd = getenv(\"MSET_TRIGGER_FD\");",       // 20
+  "  struct timespec now;",                               // 21
+  "  if ( !fd || clock_gettime(CLOCK_MONOTONIC, &now) != 0 ) return;", // 22
+  "  int64_t nanoseconds = (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;", // 23
+  "  ssize_t written = pwrite(atoi(fd), &nanoseconds, sizeof(nanoseconds), 0);", // 24
+  "  (void)written;",                                     // 25
+  "}",                                                    // 26
+};
+
+std::string CodeCanvas::get_prelude_header()
+{
+  std::ostringstream result;
+  result << LICENSE;
+  result << "#ifndef MSET_PRELUDE_H\n";
+  result << "#define MSET_PRELUDE_H\n\n";
+  for (const auto& str : PRELUDE)
+  {
+    result << str << "\n";
+  }
+  result << "void _fill(volatile char *p, int value, size_t size) { for (size_t i = 0; i < size; i++) p[i] = (char)value; }\n";
+  result << "\n#endif\n";
+  return result.str();
+}
+
 CodeCanvas::CodeCanvas():
   number_of_globals(0),
   number_of_locals(0)
 {
-  code_lines = {
-    "#include <unistd.h> // _exit", // 0
-    "#include <stdint.h>", // 1
-    "#include <stdlib.h>", // 2
-    "#include <string.h>", // 3
-    "",                    // 4
-    "#ifdef ADDR_MASK",    // 5
-    "#define GET_ADDR_BITS(p) ((size_t)(p) & ADDR_MASK)",   // 6
-    "#else",                                                // 7
-    "#define GET_ADDR_BITS(p) ((size_t)(p) & (size_t)0xffffffffffffull)",             // 8
-    "#endif",                                               // 9
-    "#ifndef MAX_OBJECT_SIZE",                              // 10
-    "#define MAX_OBJECT_SIZE ((size_t)1 << 29)",            // 11
-    "#endif",                                               // 12
-    "",             // 13
-    "volatile void *_use(volatile void *p) { return p; }",  // 14
-    "const char content[8] = \"ZZZZZZZ\";",                 // 15
-    "",             // 16
-    "// types",     // 17
+  if ( compact_emission )
+  {
+    code_lines = { "#include \"" + PRELUDE_FILE_NAME + "\"" };
+  }
+  else
+  {
+    code_lines = PRELUDE;
+  }
+  const code_pos_t offset = code_lines.size(); // positions below are relative to the end of the prelude
+  code_lines.insert(code_lines.end(), {
+    "",             // 0
+    "// types",     // 1
+    "",             // 2
+    "// globals",   // 3
+    "",             // 4
+    "",             // 5
+    "int f()",      // 6
+    "{",            // 7
+    "  // locals",  // 8
+    "",             // 9
+    "",             // 10
+    "",             // 11
+    "  return 0;",  // 12
+    "}",            // 13
+    "",             // 14
+    "int main()",   // 15
+    "{",            // 16
+    "  f();",       // 17
     "",             // 18
-    "// globals",   // 19
-    "",             // 20
-    "",             // 21
-    "int f()",      // 22
-    "{",            // 23
-    "  // locals",  // 24
-    "",             // 25
-    "",             // 26
-    "",             // 27
-    "  return 0;",  // 28
-    "}",            // 29
-    "",             // 30
-    "int main()",   // 31
-    "{",            // 32
-    "  f();",       // 33
-    "",             // 34
-    "  return 0;",  // 35
-    "}"             // 36
-  };
-
-  types_pos         = 18;
-  global_start_pos  = 20;
-  global_pos        = 21;
-  locals_start_pos  = 25;
-  locals_end_pos    = 26;
-  start_of_f_pos    = 24;
-  f_call_pos        = 33;
+    "  return 0;",  // 19
+    "}"             // 20
+  });
+
+  types_pos         = offset + 2;
+  global_start_pos  = offset + 4;
+  global_pos        = offset + 5;
+  locals_start_pos  = offset + 9;
+  locals_end_pos    = offset + 10;
+  start_of_f_pos    = offset + 8;
+  f_call_pos        = offset + 17;
   current_pos_in_f  = locals_end_pos + 1;
   end_of_f_pos      = current_pos_in_f + 1;
   current_pos_in_main = f_call_pos + 1;
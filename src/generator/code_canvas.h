@@ -90,6 +90,16 @@ public:
   using code_pos_t = size_t;
   static constexpr size_t INVALID_CODE_POS = SIZE_MAX;
 
+  /**
+   * In compact mode, canvases include PRELUDE_FILE_NAME instead of repeating the prelude, and regions
+   * initialize objects with one _fill() call instead of one statement per byte.
+   * Applies to canvases created after the call.
+   */
+  static void set_compact_emission(bool compact) { compact_emission = compact; }
+  static bool is_compact_emission() { return compact_emission; }
+  static std::string get_prelude_header();
+  static const std::string PRELUDE_FILE_NAME;
+
   CodeCanvas();
   virtual ~CodeCanvas() = default;
 
@@ -138,6 +148,8 @@ public:
   void add_variant_description_line( const std::string &description_line ) { variant_description_lines.push_back(description_line); }
 
 protected:
+  static bool compact_emission;
+
   void _generate_other_f_and_call();
   virtual void _update_indexes(code_pos_t from, size_t amount);
   std::vector<std::string> code_lines;
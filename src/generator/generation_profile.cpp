@@ -0,0 +1,147 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "generator/generation_profile.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+
+#include "evaluator/test_case_information.h"
+#include "evaluator/tinyxml2.h"
+
+static size_t parse_size(const tinyxml2::XMLElement *elem, const char *name)
+{
+  const char *text = elem ? elem->GetText() : nullptr;
+  if ( !text )
+  {
+    std::cerr << "Mandatory '" << name << "' element is missing or empty. Cannot continue.\n";
+    exit(EXIT_FAILURE);
+  }
+  char *endptr;
+  errno = 0;
+  unsigned long long value = std::strtoull(text, &endptr, 10);
+  if ( errno || *endptr != '\0' )
+  {
+    std::cerr << "Value of '" << name << "' must be a non-negative integer, got " << text << ".\n";
+    exit(EXIT_FAILURE);
+  }
+  return static_cast<size_t>(value);
+}
+
+bool ObjectSizes::is_default() const
+{
+  return origin_size == TestCaseInformation::DEFAULT_OBJECT_SIZE && target_size == TestCaseInformation::DEFAULT_OBJECT_SIZE;
+}
+
+GenerationProfile::GenerationProfile()
+{
+  add_object_sizes(TestCaseInformation::DEFAULT_OBJECT_SIZE, TestCaseInformation::DEFAULT_OBJECT_SIZE);
+}
+
+GenerationProfile::GenerationProfile(const std::string &profile_path)
+{
+  tinyxml2::XMLDocument doc;
+  if (tinyxml2::XML_SUCCESS != doc.LoadFile( profile_path.c_str() ))
+  {
+    std::cerr << "Failed to parse the generation profile at " << profile_path << ": " << doc.ErrorStr() << '\n';
+    exit(EXIT_FAILURE);
+  }
+  tinyxml2::XMLElement *root = doc.FirstChildElement("generation_profile");
+  if (!root)
+  {
+    std::cerr << "Mandatory root element 'generation_profile' is missing! Cannot continue.\n";
+    exit(EXIT_FAILURE);
+  }
+
+  tinyxml2::XMLElement *elem = root->FirstChildElement("object_sizes");
+  while (elem)
+  {
+    const std::string text = elem->GetText() ? elem->GetText() : "";
+    const size_t separator = text.find('x');
+    char *origin_end;
+    char *target_end = nullptr;
+    const size_t origin_size = std::strtoull(text.c_str(), &origin_end, 10);
+    const size_t target_size = separator == std::string::npos ? 0 : std::strtoull(text.c_str() + separator + 1, &target_end, 10);
+    if ( separator == std::string::npos || *origin_end != 'x' || *target_end != '\0' )
+    {
+      std::cerr << "Value of 'object_sizes' must be origin and target size, e.g., 16x16, got " << text << ".\n";
+      exit(EXIT_FAILURE);
+    }
+    add_object_sizes(origin_size, target_size);
+    elem = elem->NextSiblingElement("object_sizes");
+  }
+
+  elem = root->FirstChildElement("object_size_sweep");
+  while (elem)
+  {
+    const size_t from = parse_size(elem->FirstChildElement("from"), "from");
+    const size_t to = parse_size(elem->FirstChildElement("to"), "to");
+    const size_t factor = parse_size(elem->FirstChildElement("factor"), "factor");
+    tinyxml2::XMLElement *misalignment_elem = elem->FirstChildElement("misalignment");
+    const size_t misalignment = misalignment_elem ? parse_size(misalignment_elem, "misalignment") : 0; // optional
+    if ( factor < 2 )
+    {
+      std::cerr << "Value of 'factor' must be at least 2.\n";
+      exit(EXIT_FAILURE);
+    }
+    if ( to > MAX_OBJECT_SIZE || misalignment > MAX_OBJECT_SIZE )
+    {
+      std::cerr << "Values of 'to' and 'misalignment' must be at most " << MAX_OBJECT_SIZE << ".\n";
+      exit(EXIT_FAILURE);
+    }
+    for ( size_t size = from; size <= to; size *= factor )
+    {
+      add_object_sizes(size, size);
+      if ( misalignment )
+      {
+        add_object_sizes(size + misalignment, size);
+      }
+      if ( size > to / factor ) break; // the next size exceeds to, and might overflow
+    }
+    elem = elem->NextSiblingElement("object_size_sweep");
+  }
+
+  if ( object_sizes.empty() )
+  {
+    std::cerr << "The generation profile at " << profile_path << " does not define any object sizes.\n";
+    exit(EXIT_FAILURE);
+  }
+}
+
+void GenerationProfile::add_object_sizes(size_t origin_size, size_t target_size)
+{
+  if ( origin_size == 0 || target_size == 0 )
+  {
+    std::cerr << "Object sizes must be positive.\n";
+    exit(EXIT_FAILURE);
+  }
+  if ( origin_size > MAX_OBJECT_SIZE || target_size > MAX_OBJECT_SIZE )
+  {
+    std::cerr << "Object sizes must be at most " << MAX_OBJECT_SIZE << ", got " << origin_size << "x" << target_size << ".\n";
+    exit(EXIT_FAILURE);
+  }
+  for ( const auto &sizes: object_sizes )
+  {
+    if ( sizes.origin_size == origin_size && sizes.target_size == target_size )
+    {
+      return;
+    }
+  }
+  object_sizes.push_back({origin_size, target_size});
+}
+
+size_t GenerationProfile::get_max_object_size() const
+{
+  size_t max_size = 0;
+  for ( const auto &sizes: object_sizes )
+  {
+    max_size = std::max(max_size, std::max(sizes.origin_size, sizes.target_size));
+  }
+  return max_size;
+}
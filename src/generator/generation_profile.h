@@ -0,0 +1,51 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ObjectSizes
+{
+  size_t origin_size;
+  size_t target_size;
+
+  bool is_default() const;
+};
+
+/**
+ * Parameters of the generated spatial test cases, read from an XML file:
+ *
+ * <generation_profile>
+ *   <object_sizes>16x16</object_sizes>          <!-- origin and target size, repeatable -->
+ *   <object_size_sweep>                         <!-- from, from * factor, ... up to to, repeatable -->
+ *     <from>1</from>
+ *     <to>1048576</to>
+ *     <factor>4</factor>
+ *     <misalignment>1</misalignment>            <!-- optional, also adds (size + misalignment)x(size) -->
+ *   </object_size_sweep>
+ * </generation_profile>
+ *
+ * Without a profile, only the default object sizes (8x8) are generated. Sizes above MAX_OBJECT_SIZE are rejected.
+ */
+class GenerationProfile
+{
+public:
+  static constexpr size_t MAX_OBJECT_SIZE = UINT32_MAX; // the largest size that a packed suite records
+
+  GenerationProfile();
+  explicit GenerationProfile(const std::string &profile_path);
+
+  const std::vector<ObjectSizes> &get_object_sizes() const { return object_sizes; }
+  size_t get_max_object_size() const;
+
+private:
+  void add_object_sizes(size_t origin_size, size_t target_size);
+
+  std::vector<ObjectSizes> object_sizes;
+};
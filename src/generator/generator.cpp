@@ -8,13 +8,19 @@
 #include "generator/generator.h"
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <cstring>
 #include <unistd.h>
 
 #include "misc.h"
+#include "packed_suite.h"
+#include "test_case_selector.h"
+#include "generator/generation_profile.h"
 #include "generator/primitives/primitive_pool.h"
 
+using emit_t = std::function<void(const std::string& file_name, const std::shared_ptr<CodeCanvas>& code)>;
+
 static void generate_file(const std::string& dir_path, const std::string& file_name, const std::shared_ptr<CodeCanvas>& code)
 {
   std::string full_path = dir_path + file_name + ".c";
@@ -54,7 +60,12 @@ std::string build_file_name(
     + "_" + access_location->get_name() + "_" + access_action->get_name();
 }
 
-void generate(const std::string& dir_path)
+/**
+ * Walks the product space of primitives, spatial test cases once per object sizes of the profile. If a selector is
+ * given, only the canvases of the selected test cases are generated; all other tuples are skipped before calling
+ * generate().
+ */
+static void generate_all(const emit_t& emit, const TestCaseSelector *selector, const GenerationProfile &profile)
 {
   size_t temporal_generated_counter = 0;
   for ( auto temporal_bug_type: temporal_bug_types )
@@ -81,22 +92,31 @@ void generate(const std::string& dir_path)
         {
           for ( auto access_location: access_type_locations )
           {
-            std::vector< std::shared_ptr<RegionCodeCanvas> > code_canvas_variants = temporal_bug_type->generate(memory_state, memory_region, access_action, access_location);
             std::string file_name = build_file_name(temporal_bug_type, memory_state, memory_region, access_action, access_location);
+            if ( selector && !selector->matches_group(file_name) )
+            {
+              continue;
+            }
+            std::vector< std::shared_ptr<RegionCodeCanvas> > code_canvas_variants = temporal_bug_type->generate(memory_state, memory_region, access_action, access_location);
             size_t variant_index = 0;
             for ( const auto &code_canvas: code_canvas_variants )
             {
-              temporal_generated_counter++;
-              generate_file(dir_path, file_name + "_" + std::to_string(variant_index), code_canvas);
+              if ( !selector || selector->matches_variant(false, variant_index) )
+              {
+                temporal_generated_counter++;
+                emit(file_name + "_" + std::to_string(variant_index), code_canvas);
+              }
               variant_index++;
             }
 
             std::vector< std::shared_ptr<RegionCodeCanvas> > code_canvas_validation_variants = temporal_bug_type->generate_validation(memory_state, memory_region, access_action, access_location);
-            file_name = build_file_name(temporal_bug_type, memory_state, memory_region, access_action, access_location);
             variant_index = 0;
             for ( const auto &code_canvas: code_canvas_validation_variants )
             {
-              generate_file(dir_path, file_name + "_validation_" + std::to_string(variant_index), code_canvas);
+              if ( !selector || selector->matches_variant(true, variant_index) )
+              {
+                emit(file_name + "_validation_" + std::to_string(variant_index), code_canvas);
+              }
               variant_index++;
             }
           }
@@ -143,35 +163,54 @@ void generate(const std::string& dir_path)
                 {
                   continue;
                 }
-                std::vector< std::shared_ptr<OriginTargetCodeCanvas> > code_canvas_variants = spatial_bug_type->generate(
-                  origin, target, origin_target_relation,
-                  flow,
-                  access_action, access_location
-                );
-                std::string file_name = build_file_name(
-                  spatial_bug_type,
-                  origin, target, origin_target_relation,
-                  flow,
-                  access_action, access_location
-                );
-                size_t variant_index = 0;
-                for ( const auto &code_canvas: code_canvas_variants )
+                for ( const auto &sizes: profile.get_object_sizes() )
                 {
-                  spatial_generated_counter++;
-                  generate_file(dir_path, file_name + "_" + std::to_string(variant_index), code_canvas);
-                  variant_index++;
-                }
-
-                std::vector< std::shared_ptr<OriginTargetCodeCanvas> > code_canvas_validation_variants = spatial_bug_type->generate_validation(
-                  origin, target, origin_target_relation,
-                  flow,
-                  access_action, access_location
+                  std::string file_name = build_file_name(
+                    spatial_bug_type,
+                    origin, target, origin_target_relation,
+                    flow,
+                    access_action, access_location
                   );
-                variant_index = 0;
-                for ( const auto &code_canvas: code_canvas_validation_variants )
-                {
-                  generate_file(dir_path, file_name + "_validation_" + std::to_string(variant_index), code_canvas);
-                  variant_index++;
+                  if ( !sizes.is_default() )
+                  {
+                    file_name += "_size_" + std::to_string(sizes.origin_size) + "x" + std::to_string(sizes.target_size);
+                  }
+                  if ( selector && !selector->matches_group(file_name) )
+                  {
+                    continue;
+                  }
+                  std::vector< std::shared_ptr<OriginTargetCodeCanvas> > code_canvas_variants = spatial_bug_type->generate(
+                    origin, target, origin_target_relation,
+                    flow,
+                    access_action, access_location,
+                    sizes.origin_size, sizes.target_size
+                  );
+                  size_t variant_index = 0;
+                  for ( const auto &code_canvas: code_canvas_variants )
+                  {
+                    if ( !selector || selector->matches_variant(false, variant_index) )
+                    {
+                      spatial_generated_counter++;
+                      emit(file_name + "_" + std::to_string(variant_index), code_canvas);
+                    }
+                    variant_index++;
+                  }
+
+                  std::vector< std::shared_ptr<OriginTargetCodeCanvas> > code_canvas_validation_variants = spatial_bug_type->generate_validation(
+                    origin, target, origin_target_relation,
+                    flow,
+                    access_action, access_location,
+                    sizes.origin_size, sizes.target_size
+                    );
+                  variant_index = 0;
+                  for ( const auto &code_canvas: code_canvas_validation_variants )
+                  {
+                    if ( !selector || selector->matches_variant(true, variant_index) )
+                    {
+                      emit(file_name + "_validation_" + std::to_string(variant_index), code_canvas);
+                    }
+                    variant_index++;
+                  }
                 }
               }
             }
@@ -184,3 +223,48 @@ void generate(const std::string& dir_path)
   std::cout << "Generated " << spatial_generated_counter << " spatial variants\n";
   std::cout << "Generated " << spatial_generated_counter + temporal_generated_counter << " variants\n";
 }
+
+void generate(const std::string& dir_path, const std::string& packed_suite_path, const TestCaseSelector *selector,
+  const GenerationProfile *profile)
+{
+  if ( packed_suite_path.empty() )
+  {
+    if ( CodeCanvas::is_compact_emission() )
+    {
+      std::ofstream prelude(dir_path + CodeCanvas::PRELUDE_FILE_NAME);
+      prelude << CodeCanvas::get_prelude_header();
+      if ( !prelude )
+      {
+        std::cerr << "Error writing file: " << dir_path + CodeCanvas::PRELUDE_FILE_NAME << ": " << std::strerror(errno) << std::endl;
+        exit(EXIT_FAILURE);
+      }
+    }
+    generate_all([&dir_path](const std::string& file_name, const std::shared_ptr<CodeCanvas>& code) {
+      generate_file(dir_path, file_name, code);
+    }, selector, profile ? *profile : GenerationProfile());
+    return;
+  }
+
+  PackedSuiteWriter packed_suite_writer;
+  generate_all([&packed_suite_writer](const std::string& file_name, const std::shared_ptr<CodeCanvas>& code) {
+    if ( !packed_suite_writer.add(file_name, code->to_string()) )
+    {
+      std::cerr << "Error adding " << file_name << " to the packed suite." << std::endl;
+      exit(EXIT_FAILURE);
+    }
+  }, selector, profile ? *profile : GenerationProfile());
+  if ( !packed_suite_writer.write(packed_suite_path) )
+  {
+    exit(EXIT_FAILURE);
+  }
+  std::cout << "Packed " << packed_suite_writer.size() << " test case files into '" << packed_suite_path << "'\n";
+}
+
+std::vector<GeneratedTestCase> generate_in_memory(const TestCaseSelector *selector, const GenerationProfile *profile)
+{
+  std::vector<GeneratedTestCase> test_cases;
+  generate_all([&test_cases](const std::string& file_name, const std::shared_ptr<CodeCanvas>& code) {
+    test_cases.push_back({file_name, code->to_string()});
+  }, selector, profile ? *profile : GenerationProfile());
+  return test_cases;
+}
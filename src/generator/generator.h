@@ -7,5 +7,26 @@
 
 #pragma once
 #include <string>
+#include <vector>
 
-extern void generate(const std::string& dir_path);
+class TestCaseSelector;
+class GenerationProfile;
+
+struct GeneratedTestCase
+{
+  std::string name; // file name without ".c"
+  std::string source;
+};
+
+/**
+ * Generates all test cases into dir_path, or, if packed_suite_path is not empty, into a single packed suite file.
+ * If selector is set, only the selected test cases are generated. If profile is set, spatial test cases are generated
+ * for each of its object sizes instead of the default ones.
+ */
+extern void generate(const std::string& dir_path, const std::string& packed_suite_path = "", const TestCaseSelector *selector = nullptr,
+  const GenerationProfile *profile = nullptr);
+
+/**
+ * Generates all (or only the selected) test cases without writing any file.
+ */
+extern std::vector<GeneratedTestCase> generate_in_memory(const TestCaseSelector *selector = nullptr, const GenerationProfile *profile = nullptr);
@@ -11,9 +11,9 @@
 #include "generator/property.h"
 
 
-class AccessAction: public Property
+class AccessAction: public Property<access_action_id_t>
 {
 public:
   virtual ~AccessAction() = default;
-  explicit AccessAction(std::string name): Property(name) {}
+  explicit AccessAction(access_action_id_t id): Property(id) {}
 };
@@ -9,8 +9,8 @@
 
 #include <utility>
 
-AccessLocation::AccessLocation(std::string name):
-  Property(std::move(name))
+AccessLocation::AccessLocation(access_location_id_t id):
+  Property(id)
 {
 }
 
@@ -16,7 +16,7 @@
 #include "generator/property.h"
 #include "generator/primitives/access_types/access_action.h"
 
-class AccessLocation: public Property
+class AccessLocation: public Property<access_location_id_t>
 {
 public:
   struct AuxiliaryVariable
@@ -153,7 +153,7 @@ public:
   };
   virtual ~AccessLocation() = default;
 
-  explicit AccessLocation(std::string name);
+  explicit AccessLocation(access_location_id_t id);
 
   // size known at compile-time
   // simple generate
@@ -10,10 +10,6 @@
 #include <iostream>
 #include <ostream>
 
-#include "misc.h"
-#include "generator/primitives/access_types/read_action.h"
-#include "generator/primitives/bug_types/spatial/flow/flow.h"
-
 // simple generate
 std::vector<std::string> DirectLocation::generate(std::shared_ptr<AccessAction> action, const std::string &access_var_name, size_t size) const
 {
@@ -28,7 +24,7 @@ AccessLocation::SplitAccess DirectLocation::generate_split_aux_vars(
 ) const
 {
   SplitAccess split_access;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -52,7 +48,8 @@ AccessLocation::SplitAccess DirectLocation::generate_split_aux_vars(
     };
     split_access.access_lines.emplace_back("for (i = 0; i < size; i++)");
     split_access.access_lines.emplace_back("{");
-    split_access.access_lines.push_back("  " + access_var_name + "[i] = content[i];");
+    // content holds 8 bytes, wrap around for larger objects
+    split_access.access_lines.push_back("  " + access_var_name + (size > 8 ? "[i] = content[i % sizeof(content)];" : "[i] = content[i];"));
     split_access.access_lines.emplace_back("}");
 
     split_access.access_lines.emplace_back("_use(" + access_var_name + ");" );
@@ -69,7 +66,7 @@ AccessLocation::SplitAccess DirectLocation::generate_split_const_vars(
 ) const
 {
   SplitAccess split_access;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -111,7 +108,7 @@ std::vector<std::string> DirectLocation::generate_at_index(
 ) const
 {
   std::vector<std::string> lines;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     lines = {
@@ -162,7 +159,7 @@ std::vector<std::string> DirectLocation::generate_using_runtime_index(
 ) const
 {
   std::vector<std::string> lines;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     lines = {
@@ -206,7 +203,7 @@ AccessLocation::SplitAccess DirectLocation::generate_bulk_split_using_index(
 ) const
 {
   SplitAccess split_access;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -270,7 +267,7 @@ AccessLocation::SplitAccess DirectLocation::generate_bulk_split_using_aux_ptr(
 ) const
 {
   SplitAccess split_access;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -333,7 +330,7 @@ std::vector<std::string> DirectLocation::generate_uint32(
 ) const
 {
   std::vector<std::string> lines;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     lines = {
@@ -374,7 +371,7 @@ std::vector<std::string> DirectLocation::generate_uint8(
 ) const
 {
   std::vector<std::string> lines;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     lines = {
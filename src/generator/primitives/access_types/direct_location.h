@@ -14,7 +14,7 @@ class DirectLocation: public AccessLocation
 public:
 
   DirectLocation():
-    AccessLocation("direct")
+    AccessLocation(access_location_id_t::DIRECT)
   {
   }
 
@@ -12,5 +12,5 @@
 class ReadAction: public AccessAction
 {
 public:
-  ReadAction(): AccessAction("read") {}
+  ReadAction(): AccessAction(access_action_id_t::READ) {}
 };
@@ -9,9 +9,6 @@
 
 #include <cassert>
 
-#include "misc.h"
-#include "generator/primitives/access_types/read_action.h"
-
 std::vector<std::string> StdlibLocation::generate(
   std::shared_ptr<AccessAction> action, const std::string &access_var_name, size_t size) const
 {
@@ -23,7 +20,7 @@ AccessLocation::SplitAccess StdlibLocation::generate_split_aux_vars(
 {
   SplitAccess split_access;
   std::vector<std::string> code;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -53,7 +50,7 @@ AccessLocation::SplitAccess StdlibLocation::generate_split_const_vars(
 {
   SplitAccess split_access;
   std::vector<std::string> code;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -69,7 +66,7 @@ AccessLocation::SplitAccess StdlibLocation::generate_split_const_vars(
     // WRITE
     split_access.access_lines.push_back( "memset( (void *)" + access_var_name + ", 0xFF, " + std::to_string(size) + ");" );
     split_access.access_lines.emplace_back("_use(" + access_var_name + ");" );
-    split_access.result = "&" + access_var_name + "[8]";
+    split_access.result = "&" + access_var_name + "[" + std::to_string(size) + "]";
   }
   split_access.description = "constants";
   return split_access;
@@ -90,7 +87,7 @@ AccessLocation::SplitAccess StdlibLocation::generate_bulk_split_using_index(
   {
     distance = "(" + to + " - " + from + ")"; // can never underflow
   }
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -158,7 +155,7 @@ AccessLocation::SplitAccess StdlibLocation::generate_bulk_split_using_aux_ptr(
 {
   SplitAccess split_access;
 
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     split_access.aux_variables = {
@@ -231,7 +228,7 @@ std::vector<std::string> StdlibLocation::generate_at_index(
 ) const
 {
   std::vector<std::string> lines;
-  if (is_a<ReadAction>(action))
+  if (action->get_id() == access_action_id_t::READ)
   {
     // READ
     lines = {
@@ -16,7 +16,7 @@ class StdlibLocation: public AccessLocation
 {
 public:
   StdlibLocation():
-    AccessLocation("stdlib")
+    AccessLocation(access_location_id_t::STDLIB)
   {
   }
 
@@ -12,5 +12,5 @@
 class WriteAction: public AccessAction
 {
 public:
-  WriteAction(): AccessAction("write") {}
+  WriteAction(): AccessAction(access_action_id_t::WRITE) {}
 };
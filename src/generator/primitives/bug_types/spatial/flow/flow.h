@@ -12,11 +12,11 @@
 
 class AccessLocation;
 
-class Flow: public Property
+class Flow: public Property<flow_id_t>
 {
 public:
-  explicit Flow(const std::string &name):
-    Property(name)
+  explicit Flow(flow_id_t id):
+    Property(id)
   {
   }
   virtual ~Flow() = default;
@@ -13,7 +13,7 @@ class Overflow: public Flow
 {
 public:
   Overflow():
-    Flow("overflow")
+    Flow(flow_id_t::OVERFLOW_FLOW)
   {
   }
 
@@ -7,12 +7,9 @@
 
 #include "underflow.h"
 
-#include "misc.h"
-#include "generator/primitives/access_types/direct_location.h"
-
 bool Underflow::accepts(std::shared_ptr<AccessLocation> access_location) const
 {
-  return is_a<DirectLocation>(access_location);
+  return access_location->get_id() == access_location_id_t::DIRECT;
 }
 
 bool Underflow::accepts_static_distance(ssize_t distance) const
@@ -13,7 +13,7 @@ class Underflow: public Flow
 {
 public:
   Underflow():
-    Flow("underflow")
+    Flow(flow_id_t::UNDERFLOW_FLOW)
   {
   }
 
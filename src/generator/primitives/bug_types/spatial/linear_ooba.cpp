@@ -10,9 +10,6 @@
 #include <cassert>
 
 #include "misc.h"
-#include "generator/primitives/access_types/read_action.h"
-#include "generator/primitives/bug_types/spatial/flow/underflow.h"
-#include "generator/primitives/bug_types/spatial/origin_target_relation/intra_object.h"
 
 bool LinearOOBA::accepts(std::shared_ptr<Flow> flow) const
 {
@@ -35,7 +32,9 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> LinearOOBA::generate(
   std::shared_ptr<OriginTargetRelation> origin_target_relation,
   std::shared_ptr<Flow> flow,
   std::shared_ptr<AccessAction> access_action,
-  std::shared_ptr<AccessLocation> access_location
+  std::shared_ptr<AccessLocation> access_location,
+  size_t origin_size,
+  size_t target_size
 ) const
 {
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> >full_variants;
@@ -57,11 +56,11 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> LinearOOBA::generate(
   auto generate_counter_update = std::bind(&Flow::generate_counter_update, flow.get(), std::placeholders::_1);
 
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> > origin_target_canvases = origin_target_relation->generate(
-    variant, origin, 8, target, 8);
+    variant, origin, origin_size, target, target_size);
 
   for ( auto &origin_target_canvas : origin_target_canvases )
   {
-    if ( origin_target_canvas->get_forces_underflow() && !is_a<Underflow>(flow) ) continue; // the origin-target requires an underflow, but the flow is not an underflow -> skip
+    if ( origin_target_canvas->get_forces_underflow() && flow->get_id() != flow_id_t::UNDERFLOW_FLOW ) continue; // the origin-target requires an underflow, but the flow is not an underflow -> skip
 
     std::vector< std::tuple< std::string, std::string > > distance_variants = {
       std::tuple< std::string, std::string >{ origin_target_canvas->get_distance(), "distance is checked as is" },
@@ -105,6 +104,7 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> LinearOOBA::generate(
           for ( auto &access_target_code : access_target_codes )
           {
             auto origin_target_canvas_with_access = std::make_shared<OriginTargetCodeCanvas>(*origin_target_canvas_copy);
+            origin_target_canvas_with_access->add_during_lifetime("_trigger();");
             origin_target_canvas_with_access->add_during_lifetime(access_target_code.to_lines());
             origin_target_canvas_with_access->add_during_lifetime("_use(" + origin_target_canvas_copy->get_origin_name() + ");");
             origin_target_canvas_with_access->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
@@ -133,6 +133,7 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> LinearOOBA::generate(
           auto origin_target_canvas_with_access = std::make_shared<OriginTargetCodeCanvas>(*origin_target_canvas_copy);
           origin_target_canvas_with_access->add_during_lifetime("_use(" + origin_target_canvas_copy->get_target_name() + ");");
           origin_target_canvas_with_access->add_during_lifetime("_use(" + origin_target_canvas_copy->get_origin_name() + ");");
+          origin_target_canvas_with_access->add_during_lifetime("_trigger();");
           origin_target_canvas_with_access->add_during_lifetime(reach_target_code.access_lines);
           origin_target_canvas_with_access->add_during_lifetime(access_target_code.to_lines());
           origin_target_canvas_with_access->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
@@ -158,7 +159,9 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> LinearOOBA::generate_valida
   std::shared_ptr<OriginTargetRelation> origin_target_relation,
   std::shared_ptr<Flow> flow,
   std::shared_ptr<AccessAction> access_action,
-  std::shared_ptr<AccessLocation> access_location
+  std::shared_ptr<AccessLocation> access_location,
+  size_t origin_size,
+  size_t target_size
 ) const
 {
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> >full_variants;
@@ -176,11 +179,11 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> LinearOOBA::generate_valida
   variant.add_test_case_description_line("Access type: " + access_location->get_name() + ", " + access_action->get_name());
 
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> > origin_target_canvases = origin_target_relation->generate(
-    variant, origin, 8, target, 8);
+    variant, origin, origin_size, target, target_size);
 
   for ( auto &origin_target_canvas : origin_target_canvases )
   {
-    if ( origin_target_canvas->get_forces_underflow() && !is_a<Underflow>(flow) ) continue; // the origin-target requires an underflow, but the flow is not an underflow -> skip
+    if ( origin_target_canvas->get_forces_underflow() && flow->get_id() != flow_id_t::UNDERFLOW_FLOW ) continue; // the origin-target requires an underflow, but the flow is not an underflow -> skip
 
     std::string var_name_to_access;
     if ( origin_target_canvas->is_target_allocated() )
@@ -7,11 +7,6 @@
 
 #include "non_linear_ooba.h"
 
-#include "misc.h"
-#include "generator/primitives/bug_types/spatial/flow/underflow.h"
-#include "generator/primitives/bug_types/spatial/origin_target_relation/inter_object.h"
-#include "generator/primitives/bug_types/spatial/origin_target_relation/intra_object.h"
-
 bool NonLinearOOBA::accepts(std::shared_ptr<Flow> flow) const
 {
   return true;
@@ -19,8 +14,8 @@ bool NonLinearOOBA::accepts(std::shared_ptr<Flow> flow) const
 
 bool NonLinearOOBA::accepts(std::shared_ptr<OriginTargetRelation> origin_target_relation) const
 {
-  return is_a<InterObject>(origin_target_relation)
-    || is_a<IntraObject>(origin_target_relation);
+  return origin_target_relation->get_id() == origin_target_relation_id_t::INTER_OBJECT
+    || origin_target_relation->get_id() == origin_target_relation_id_t::INTRA_OBJECT;
 }
 
 bool NonLinearOOBA::accepts(std::shared_ptr<AccessLocation> access_location) const
@@ -34,7 +29,9 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> NonLinearOOBA::generate(
   std::shared_ptr<OriginTargetRelation> origin_target_relation,
   std::shared_ptr<Flow> flow,
   std::shared_ptr<AccessAction> access_action,
-  std::shared_ptr<AccessLocation> access_location
+  std::shared_ptr<AccessLocation> access_location,
+  size_t origin_size,
+  size_t target_size
 ) const
 {
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> >full_variants;
@@ -53,11 +50,11 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> NonLinearOOBA::generate(
   auto generate_preconditions_check_distance = std::bind(&Flow::generate_preconditions_check_distance, flow.get(), std::placeholders::_1);
 
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> > origin_target_canvases = origin_target_relation->generate(
-    variant, origin, 8, target, 8);
+    variant, origin, origin_size, target, target_size);
 
   for ( auto &origin_target_canvas : origin_target_canvases )
   {
-    if ( origin_target_canvas->get_forces_underflow() && !is_a<Underflow>(flow) ) continue; // the origin-target requires an underflow, but this is not an underflow -> skip
+    if ( origin_target_canvas->get_forces_underflow() && flow->get_id() != flow_id_t::UNDERFLOW_FLOW ) continue; // the origin-target requires an underflow, but this is not an underflow -> skip
     std::string distance = origin_target_canvas->get_distance();
 
     if ( distance == "N/A" ) continue;
@@ -69,6 +66,7 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> NonLinearOOBA::generate(
       origin_target_canvas_copy->get_target_size(),
       generate_preconditions_check_distance
     );
+    origin_target_canvas_copy->add_during_lifetime("_trigger();");
     origin_target_canvas_copy->add_during_lifetime(access_target_code);
     origin_target_canvas_copy->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
     full_variants.push_back( origin_target_canvas_copy );
@@ -85,7 +83,9 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> NonLinearOOBA::generate_val
   std::shared_ptr<OriginTargetRelation> origin_target_relation,
   std::shared_ptr<Flow> flow,
   std::shared_ptr<AccessAction> access_action,
-  std::shared_ptr<AccessLocation> access_location
+  std::shared_ptr<AccessLocation> access_location,
+  size_t origin_size,
+  size_t target_size
 ) const
 {
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> >full_variants;
@@ -102,11 +102,11 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> NonLinearOOBA::generate_val
 
 
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> > origin_target_canvases = origin_target_relation->generate(
-    variant, origin, 8, target, 8);
+    variant, origin, origin_size, target, target_size);
 
   for ( auto &origin_target_canvas : origin_target_canvases )
   {
-    if ( origin_target_canvas->get_forces_underflow() && !is_a<Underflow>(flow) ) continue; // the origin-target requires an underflow, but the for is not an underflow -> skip
+    if ( origin_target_canvas->get_forces_underflow() && flow->get_id() != flow_id_t::UNDERFLOW_FLOW ) continue; // the origin-target requires an underflow, but the for is not an underflow -> skip
     std::string distance = { "0" };
 
     if ( distance == "N/A" ) continue;
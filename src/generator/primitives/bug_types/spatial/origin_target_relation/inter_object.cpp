@@ -7,8 +7,6 @@
 
 #include "inter_object.h"
 
-#include "misc.h"
-
 
 bool InterObject::accepts(std::shared_ptr<Region> origin, std::shared_ptr<Region> target) const
 {
@@ -39,7 +37,7 @@ std::vector< std::shared_ptr<OriginTargetCodeCanvas> > InterObject::generate(
   variant->add_variant_description_line("target declared after origin");
   variants.push_back(variant);
 
-  if ( are_the_same_type(origin, target) )
+  if ( origin->get_id() == target->get_id() )
   {
     target_canvas = target->generate(canvas_ptr, "target", target_size, true);
     origin_canvas = origin->generate(target_canvas->get_lifetime_pos(), target_canvas, "origin", origin_size, true);
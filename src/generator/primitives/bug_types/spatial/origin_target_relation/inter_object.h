@@ -13,7 +13,7 @@ class InterObject: public OriginTargetRelation
 {
 public:
   InterObject():
-    OriginTargetRelation("inter_object")
+    OriginTargetRelation(origin_target_relation_id_t::INTER_OBJECT)
   {
   }
 
@@ -13,7 +13,7 @@ class IntraObject: public OriginTargetRelation
 {
 public:
   IntraObject():
-    OriginTargetRelation("intra_object")
+    OriginTargetRelation(origin_target_relation_id_t::INTRA_OBJECT)
   {
   }
 
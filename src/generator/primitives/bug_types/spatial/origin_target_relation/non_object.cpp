@@ -7,18 +7,13 @@
 
 #include "non_object.h"
 
-#include "misc.h"
-#include "generator/primitives/regions/global_region.h"
-#include "generator/primitives/regions/heap_region.h"
-#include "generator/primitives/regions/stack_region.h"
-
 
 bool NonObject::accepts(std::shared_ptr<Region> origin, std::shared_ptr<Region> target) const
 {
   // accept only same region origin and targets
-  if ( is_a<StackRegion>(origin) && is_a<StackRegion>(target) ) return true;
-  if ( is_a<HeapRegion>(origin) && is_a<HeapRegion>(target) ) return true;
-  if ( is_a<GlobalRegion>(origin) && is_a<GlobalRegion>(target) ) return true;
+  if ( origin->get_id() == region_id_t::STACK && target->get_id() == region_id_t::STACK ) return true;
+  if ( origin->get_id() == region_id_t::HEAP && target->get_id() == region_id_t::HEAP ) return true;
+  if ( origin->get_id() == region_id_t::GLOBAL && target->get_id() == region_id_t::GLOBAL ) return true;
   return false;
 }
 
@@ -37,14 +32,14 @@ std::vector< std::shared_ptr<OriginTargetCodeCanvas> > NonObject::generate(
   std::string distance_up = std::to_string(origin_size);
 
   std::shared_ptr<OriginTargetCodeCanvas> variant = std::make_shared<OriginTargetCodeCanvas>(
-    origin_canvas, 1, 8, "(origin + " + std::to_string(origin_size) + ")", "origin",
+    origin_canvas, 1, origin_size, "(origin + " + std::to_string(origin_size) + ")", "origin",
     distance_up, "N/A", /*is_target_allocated=*/false
   );
   variant->set_lifetime_pos( origin_canvas->get_lifetime_pos() );
   variants.push_back(variant);
 
   variant = std::make_shared<OriginTargetCodeCanvas>(
-    origin_canvas, 1, 8, "(origin - 1)", "origin", "-1", "N/A",
+    origin_canvas, 1, origin_size, "(origin - 1)", "origin", "-1", "N/A",
     /*is_target_allocated=*/false, /*requires_underflow=*/true
   );
   variant->set_lifetime_pos( origin_canvas->get_lifetime_pos() );
@@ -13,7 +13,7 @@ class NonObject: public OriginTargetRelation
 {
 public:
   NonObject():
-    OriginTargetRelation("non_object")
+    OriginTargetRelation(origin_target_relation_id_t::NON_OBJECT)
   {
   }
 
@@ -122,11 +122,11 @@ private:
   bool forces_underflow;
 };
 
-class OriginTargetRelation: public Property
+class OriginTargetRelation: public Property<origin_target_relation_id_t>
 {
 public:
-  explicit OriginTargetRelation(const std::string &name):
-    Property(name)
+  explicit OriginTargetRelation(origin_target_relation_id_t id):
+    Property(id)
   {
   }
   virtual ~OriginTargetRelation() = default;
@@ -17,10 +17,10 @@
 #include "generator/primitives/regions/region.h"
 
 
-class SpatialBugType: public Property
+class SpatialBugType: public Property<spatial_bug_id_t>
 {
 public:
-  explicit SpatialBugType(std::string name): Property(name) {}
+  explicit SpatialBugType(spatial_bug_id_t id): Property(id) {}
   virtual ~SpatialBugType() = default;
 
   virtual bool accepts(std::shared_ptr<Flow> flow) const = 0;
@@ -33,7 +33,9 @@ public:
     std::shared_ptr<OriginTargetRelation> origin_target_relation,
     std::shared_ptr<Flow> flow,
     std::shared_ptr<AccessAction> access_action,
-    std::shared_ptr<AccessLocation> access_location
+    std::shared_ptr<AccessLocation> access_location,
+    size_t origin_size,
+    size_t target_size
     ) const = 0;
 
   virtual std::vector< std::shared_ptr<OriginTargetCodeCanvas> > generate_validation(
@@ -42,6 +44,8 @@ public:
     std::shared_ptr<OriginTargetRelation> origin_target_relation,
     std::shared_ptr<Flow> flow,
     std::shared_ptr<AccessAction> access_action,
-    std::shared_ptr<AccessLocation> access_location
+    std::shared_ptr<AccessLocation> access_location,
+    size_t origin_size,
+    size_t target_size
     ) const = 0;
 };
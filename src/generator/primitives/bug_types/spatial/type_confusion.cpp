@@ -7,13 +7,11 @@
 
 #include "type_confusion.h"
 
-#include "misc.h"
-#include "generator/primitives/access_types/direct_location.h"
-#include "generator/primitives/bug_types/spatial/flow/overflow.h"
+#include <algorithm>
 
 bool TypeConfusion::accepts(std::shared_ptr<Flow> flow) const
 {
-  return is_a<Overflow>(flow);
+  return flow->get_id() == flow_id_t::OVERFLOW_FLOW;
 }
 
 bool TypeConfusion::accepts(std::shared_ptr<OriginTargetRelation> origin_target_relation) const
@@ -23,7 +21,7 @@ bool TypeConfusion::accepts(std::shared_ptr<OriginTargetRelation> origin_target_
 
 bool TypeConfusion::accepts(std::shared_ptr<AccessLocation> access_location) const
 {
-  return is_a<DirectLocation>(access_location);
+  return access_location->get_id() == access_location_id_t::DIRECT;
 }
 
 std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate(
@@ -32,7 +30,9 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate(
   std::shared_ptr<OriginTargetRelation> origin_target_relation,
   std::shared_ptr<Flow> flow,
   std::shared_ptr<AccessAction> access_action,
-  std::shared_ptr<AccessLocation> access_location
+  std::shared_ptr<AccessLocation> access_location,
+  size_t origin_size,
+  size_t target_size
 ) const
 {
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> >full_variants;
@@ -54,7 +54,7 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate(
   auto generate_preconditions_check_in_range = std::bind(&Flow::generate_preconditions_check_in_range, flow.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> > origin_target_canvases = origin_target_relation->generate(
-    variant, origin, 8, target, 8);
+    variant, origin, origin_size, target, target_size);
 
   for ( auto &origin_target_canvas : origin_target_canvases )
   {
@@ -82,6 +82,7 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate(
       "     || (" + variant_with_big_type->get_distance() + " < 0 && " + variant_with_big_type->get_distance() + "< -(MAX_OBJECT_SIZE) ) )"\
       "  _exit(PRECONDITIONS_FAILED_VALUE);"
     });
+    variant_with_big_type->add_during_lifetime("_trigger();");
     variant_with_big_type->add_during_lifetime(reach_target_code);
     variant_with_big_type->add_during_lifetime(access_target_code);
     variant_with_big_type->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
@@ -97,16 +98,18 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate(
     variant_with_big_type->add_variant_description_line("using a global index");
     full_variants.push_back( variant_with_big_type );
 
-    // load widening variant
+    // load widening variant, the 4-byte access starts inside the origin and ends one byte past it
+    if ( origin_target_canvas->get_origin_size() < 3 ) continue;
     std::shared_ptr<OriginTargetCodeCanvas> variant_with_load_widening = std::make_shared<OriginTargetCodeCanvas>(*origin_target_canvas);
     access_target_code = access_location->generate_uint32(
       access_action,
       variant_with_load_widening->get_origin_name(),
       variant_with_load_widening->get_origin_name(),
       variant_with_load_widening->get_distance(),
-      8,
+      variant_with_load_widening->get_origin_size(),
       generate_preconditions_check_distance
     );
+    variant_with_load_widening->add_during_lifetime("_trigger();");
     variant_with_load_widening->add_during_lifetime(access_target_code);
     variant_with_load_widening->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
     variant_with_load_widening->add_variant_description_line("using load widening");
@@ -123,7 +126,9 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate_val
   std::shared_ptr<OriginTargetRelation> origin_target_relation,
   std::shared_ptr<Flow> flow,
   std::shared_ptr<AccessAction> access_action,
-  std::shared_ptr<AccessLocation> access_location
+  std::shared_ptr<AccessLocation> access_location,
+  size_t origin_size,
+  size_t target_size
 ) const
 {
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> >full_variants;
@@ -139,7 +144,7 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate_val
   variant.add_test_case_description_line("Access type: " + access_location->get_name() + ", " + access_action->get_name());
 
   std::vector< std::shared_ptr<OriginTargetCodeCanvas> > origin_target_canvases = origin_target_relation->generate(
-    variant, origin, 8, target, 8);
+    variant, origin, origin_size, target, target_size);
 
   for ( auto &origin_target_canvas : origin_target_canvases )
   {
@@ -176,13 +181,14 @@ std::vector<std::shared_ptr<OriginTargetCodeCanvas>> TypeConfusion::generate_val
     full_variants.push_back( variant_with_big_type );
 
     // load widening variant
+    if ( origin_target_canvas->get_origin_size() < 3 ) continue;
     std::shared_ptr<OriginTargetCodeCanvas> variant_with_load_widening = std::make_shared<OriginTargetCodeCanvas>(*origin_target_canvas);
     access_target_code = access_location->generate_uint8(
       access_action,
       variant_with_load_widening->get_origin_name(),
       variant_with_load_widening->get_origin_name(),
       variant_with_load_widening->get_distance(),
-      4,
+      std::min<size_t>(4, variant_with_load_widening->get_origin_size()),
       nullptr
     );
     variant_with_load_widening->add_during_lifetime(access_target_code);
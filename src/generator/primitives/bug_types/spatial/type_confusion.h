@@ -13,7 +13,7 @@ class TypeConfusion: public SpatialBugType
 {
 public:
   TypeConfusion():
-    SpatialBugType("type_confusion_ooba")
+    SpatialBugType(spatial_bug_id_t::TYPE_CONFUSION_OOBA)
   {
   }
 
@@ -24,10 +24,10 @@ public:
   std::vector<std::shared_ptr<OriginTargetCodeCanvas>> generate(std::shared_ptr<Region> origin,
     std::shared_ptr<Region> target, std::shared_ptr<OriginTargetRelation> origin_target_relation,
     std::shared_ptr<Flow> flow, std::shared_ptr<AccessAction> access_action,
-    std::shared_ptr<AccessLocation> access_location) const override;
+    std::shared_ptr<AccessLocation> access_location, size_t origin_size, size_t target_size) const override;
 
   std::vector<std::shared_ptr<OriginTargetCodeCanvas>> generate_validation(std::shared_ptr<Region> origin,
     std::shared_ptr<Region> target, std::shared_ptr<OriginTargetRelation> origin_target_relation,
     std::shared_ptr<Flow> flow, std::shared_ptr<AccessAction> access_action,
-    std::shared_ptr<AccessLocation> access_location) const override;
+    std::shared_ptr<AccessLocation> access_location, size_t origin_size, size_t target_size) const override;
 };
@@ -10,23 +10,19 @@
 #include "generator/primitives/access_types/access_action.h"
 #include "generator/primitives/access_types/access_location.h"
 
-#include "misc.h"
-#include "generator/primitives/bug_types/temporal/memory_state/used.h"
-#include "generator/primitives/regions/heap_region.h"
-
 DoubleFree::DoubleFree():
-  TemporalBugType("double_free")
+  TemporalBugType(temporal_bug_id_t::DOUBLE_FREE)
 {
 }
 
 bool DoubleFree::accepts(std::shared_ptr<MemoryState> memory_state)
 {
-  return is_a<UsedMemory>(memory_state);
+  return memory_state->get_id() == memory_state_id_t::USED_MEMORY;
 }
 
 bool DoubleFree::accepts(std::shared_ptr<Region> region)
 {
-  return is_a<HeapRegion>(region);
+  return region->get_id() == region_id_t::HEAP;
 }
 
 bool DoubleFree::accepts(std::shared_ptr<AccessLocation> access_type)
@@ -74,6 +70,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >DoubleFree::generate(
     "char *pointer_to_use; // pointer to illegally use",
     "pointer_to_double_free = (char *)malloc(10);",
     "free(pointer_to_double_free);",
+    "_trigger();",
     "pointer_to_double_free[sizeof(void *)] = 0; // use-after-free for heap metadata corruption",
     "free(pointer_to_double_free); // double free",
     "pointer_to_use = (char *)malloc(8); // allocate a new object"
@@ -106,6 +103,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >DoubleFree::generate(
     "pointer_to_double_free = (char *)malloc(8);",
     "free(pointer_to_double_free);",
     "free(tmp); // no use after free required",
+    "_trigger();",
     "free(pointer_to_double_free); // double free",
     "pointer_to_use = (char *)malloc(8); // allocate a new object",
     "tmp3 = (char *)malloc(8);",
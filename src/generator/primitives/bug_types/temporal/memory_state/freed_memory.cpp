@@ -7,15 +7,12 @@
 
 #include "generator/primitives/bug_types/temporal/memory_state/freed_memory.h"
 
-#include "misc.h"
-#include "generator/primitives/regions/global_region.h"
-
 FreedMemory::FreedMemory():
-  MemoryState("freed_memory", "target")
+  MemoryState(memory_state_id_t::FREED_MEMORY, "target")
 {
 }
 
 bool FreedMemory::accepts(std::shared_ptr<Region> region)
 {
-  return !is_a<GlobalRegion>(region);
+  return region->get_id() != region_id_t::GLOBAL;
 }
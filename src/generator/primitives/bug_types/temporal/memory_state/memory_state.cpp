@@ -9,8 +9,8 @@
 
 #include <cassert>
 
-MemoryState::MemoryState(std::string name, std::string var_name):
-  Property(name),
+MemoryState::MemoryState(memory_state_id_t id, std::string var_name):
+  Property(id),
   var_name(var_name)
 {
 }
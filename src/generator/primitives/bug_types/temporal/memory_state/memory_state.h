@@ -13,10 +13,10 @@
 #include "generator/property.h"
 #include "generator/primitives/regions/region.h"
 
-class MemoryState: public Property
+class MemoryState: public Property<memory_state_id_t>
 {
 public:
-  MemoryState(std::string name, std::string var_name);
+  MemoryState(memory_state_id_t id, std::string var_name);
   virtual ~MemoryState() = default;
 
   virtual bool accepts(std::shared_ptr<Region> region) = 0;
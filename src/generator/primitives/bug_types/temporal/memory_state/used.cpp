@@ -10,7 +10,7 @@
 #include <iostream>
 
 UsedMemory::UsedMemory():
-  MemoryState("used_memory", "target")
+  MemoryState(memory_state_id_t::USED_MEMORY, "target")
 {
 }
 
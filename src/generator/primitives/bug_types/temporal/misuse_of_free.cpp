@@ -7,12 +7,8 @@
 
 #include "misuse_of_free.h"
 
-#include "misc.h"
-#include "generator/primitives/bug_types/temporal/memory_state/used.h"
-#include "generator/primitives/regions/heap_region.h"
-
 MisuseOfFree::MisuseOfFree():
-  TemporalBugType("misuse_of_free")
+  TemporalBugType(temporal_bug_id_t::MISUSE_OF_FREE)
 {
 }
 
@@ -86,6 +82,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >MisuseOfFree::generate(
       "unsigned long *crafted_ptr;",
       "crafted_ptr = (unsigned long *)&(target[2*8]); // pointing at byte 0x10, content of chunk 0",
       "(void)malloc(8);",
+      "_trigger();",
       "free(crafted_ptr);",
         "",
         "heap_obj = (char *)malloc(8);"
@@ -93,13 +90,13 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >MisuseOfFree::generate(
     std::vector<std::string> access_type_code = access_location->generate(
       access_action, "heap_obj", 8);
     CodeCanvas::code_pos_t index;
-    if (is_a<UsedMemory>(memory_state))
+    if (memory_state->get_id() == memory_state_id_t::USED_MEMORY)
     {
       index = region_canvas_with_magic_value->add_at(region_canvas_with_magic_value->get_lifetime_pos(), access_type_code, "  ");
     }
     else
     {
-      if ( std::dynamic_pointer_cast<HeapRegion>(memory_region) )
+      if ( memory_region->get_id() == region_id_t::HEAP )
       {
         // unused heap memory
         region_canvas_with_magic_value->add_at(
@@ -193,7 +190,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >MisuseOfFree::generate_validatio
     std::vector<std::string> access_type_code = access_location->generate(
       access_action, "heap_obj", 8);
     CodeCanvas::code_pos_t index;
-    if (is_a<UsedMemory>(memory_state))
+    if (memory_state->get_id() == memory_state_id_t::USED_MEMORY)
     {
       index = region_canvas_with_magic_value->add_at(region_canvas_with_magic_value->get_lifetime_pos(), access_type_code, "  ");
     }
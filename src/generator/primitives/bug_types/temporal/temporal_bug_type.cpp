@@ -9,7 +9,7 @@
 
 #include <utility>
 
-TemporalBugType::TemporalBugType(std::string name):
-  Property(std::move(name))
+TemporalBugType::TemporalBugType(temporal_bug_id_t id):
+  Property(id)
 {
 }
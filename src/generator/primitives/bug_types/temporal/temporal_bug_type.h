@@ -15,10 +15,10 @@
 #include "memory_state/memory_state.h"
 
 
-class TemporalBugType: public Property
+class TemporalBugType: public Property<temporal_bug_id_t>
 {
 public:
-  explicit TemporalBugType(std::string name);
+  explicit TemporalBugType(temporal_bug_id_t id);
   virtual ~TemporalBugType() = default;
 
   virtual bool accepts(std::shared_ptr<MemoryState> memory_state) = 0;
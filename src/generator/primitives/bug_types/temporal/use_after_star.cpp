@@ -9,9 +9,6 @@
 
 #include <cassert>
 
-#include "misc.h"
-#include "generator/primitives/bug_types/temporal/memory_state/freed_memory.h"
-#include "generator/primitives/bug_types/temporal/memory_state/used.h"
 #include "generator/primitives/regions/heap_region.h"
 #include "generator/primitives/regions/stack_region.h"
 
@@ -19,7 +16,7 @@ const std::string max_reallocated_retries = "1000000000";
 const std::string max_reallocated_retries_validation = "100";
 
 UseAfterStar::UseAfterStar():
-  TemporalBugType("use_after_star")
+  TemporalBugType(temporal_bug_id_t::USE_AFTER_STAR)
 {
 }
 
@@ -30,8 +27,8 @@ bool UseAfterStar::accepts(std::shared_ptr<MemoryState> memory_state)
 
 bool UseAfterStar::accepts(std::shared_ptr<Region> region)
 {
-  return is_a<HeapRegion>(region)
-    || is_a<StackRegion>(region);
+  return region->get_id() == region_id_t::HEAP
+    || region->get_id() == region_id_t::STACK;
 }
 
 bool UseAfterStar::accepts(std::shared_ptr<AccessLocation> access_location)
@@ -46,11 +43,11 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::generate(
   std::shared_ptr<AccessLocation> access_location
   ) const
 {
-  if (is_a<FreedMemory>(memory_state))
+  if (memory_state->get_id() == memory_state_id_t::FREED_MEMORY)
   {
     return _generate_unused_mem(memory_region, access_action, access_location);
   }
-  assert(is_a<UsedMemory>(memory_state));
+  assert(memory_state->get_id() == memory_state_id_t::USED_MEMORY);
   return _generate_reused_mem(memory_region, access_action, access_location);
 }
 
@@ -59,8 +56,8 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_unused_m
   std::shared_ptr<AccessAction> access_action,
   std::shared_ptr<AccessLocation> access_location) const
 {
-  if ( is_a<HeapRegion>(memory_region) ) return _generate_unused_mem_heap(memory_region, access_action, access_location);
-  assert( is_a<StackRegion>(memory_region) );
+  if ( memory_region->get_id() == region_id_t::HEAP ) return _generate_unused_mem_heap(memory_region, access_action, access_location);
+  assert( memory_region->get_id() == region_id_t::STACK );
   return _generate_unused_mem_stack(memory_region, access_action, access_location);
 }
 
@@ -73,7 +70,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_unused_m
   std::vector< std::shared_ptr<RegionCodeCanvas> >variants = {};
   CodeCanvas code_simple;
   code_simple.add_global("char *target_address;");
-  std::shared_ptr<StackRegion> stack_memory_region = std::dynamic_pointer_cast<StackRegion>(memory_region);
+  std::shared_ptr<StackRegion> stack_memory_region = std::static_pointer_cast<StackRegion>(memory_region);
   std::shared_ptr<StackRegion> stack_memory_region_simple = std::make_shared<StackRegion>(*stack_memory_region);
   std::shared_ptr<RegionCodeCanvas> region_canvas = stack_memory_region_simple->generate(std::make_shared<CodeCanvas>(code_simple), "target", 8, true);
 
@@ -81,6 +78,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_unused_m
   AccessLocation::SplitAccess access_type_code = access_location->generate_split_const_vars(
     access_action, "target_address", 8);
 
+  region_canvas->add_to_main_body("_trigger();");
   region_canvas->add_to_main_body(access_type_code.access_lines);
   region_canvas->add_to_main_body("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
 
@@ -106,11 +104,12 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_unused_m
   code.add_global("char *target_address;");
   std::shared_ptr<RegionCodeCanvas> region_canvas = memory_region->generate(std::make_shared<CodeCanvas>(code), "target", 8, /*initialize=*/true);
 
-  assert( is_a<HeapRegion>(memory_region) );
+  assert( memory_region->get_id() == region_id_t::HEAP );
   std::vector<std::string> access_type_code = access_location->generate(
     access_action, "target_address", 8);
   auto index = region_canvas->add_at(region_canvas->get_deallocation_pos(), "target_address = &target[0];", "  ");
   // region_canvas->add_during_lifetime("target_address = &target[0];");
+  index = region_canvas->add_at(index, "_trigger();", "  ");
   index = region_canvas->add_at(index, access_type_code, "  ");
   region_canvas->add_at(index, "_exit(TEST_CASE_SUCCESSFUL_VALUE);", "  ");
 
@@ -129,8 +128,8 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
   std::shared_ptr<AccessAction> access_action,
   std::shared_ptr<AccessLocation> access_location) const
 {
-  if ( is_a<HeapRegion>(memory_region) ) return _generate_reused_mem_heap(memory_region, access_action, access_location);
-  assert( is_a<StackRegion>(memory_region) );
+  if ( memory_region->get_id() == region_id_t::HEAP ) return _generate_reused_mem_heap(memory_region, access_action, access_location);
+  assert( memory_region->get_id() == region_id_t::STACK );
   return _generate_reused_mem_stack(memory_region, access_action, access_location);
 }
 
@@ -144,11 +143,11 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
   code.add_global("char *target_address;");
   std::shared_ptr<RegionCodeCanvas> region_canvas = memory_region->generate(std::make_shared<CodeCanvas>(code), "target", 8, false);
 
-  assert ( is_a<HeapRegion>(memory_region) );
+  assert ( memory_region->get_id() == region_id_t::HEAP );
   region_canvas->add_during_lifetime("target_address = &target[0];");
     std::vector<std::string> access_type_code = access_location->generate(
     access_action, "target_address", 8);
-  std::shared_ptr<HeapRegion> heap_memory_region = std::dynamic_pointer_cast<HeapRegion>(memory_region);
+  std::shared_ptr<HeapRegion> heap_memory_region = std::static_pointer_cast<HeapRegion>(memory_region);
 
   std::shared_ptr<RegionCodeCanvas> reused_region_canvas = heap_memory_region->generate(
     region_canvas->get_deallocation_pos(), region_canvas, "reallocated", 8, false);
@@ -157,6 +156,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
   reused_region_canvas_simple->add_during_lifetime(
     "if ( GET_ADDR_BITS(target) != GET_ADDR_BITS(reallocated) ) _exit(PRECONDITIONS_FAILED_VALUE);"
   );
+  reused_region_canvas_simple->add_during_lifetime("_trigger();");
   reused_region_canvas_simple->add_during_lifetime(access_type_code);
   reused_region_canvas_simple->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
 
@@ -181,6 +181,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
     "}",
     "if ( counter == " + max_reallocated_retries + " ) _exit(PRECONDITIONS_FAILED_VALUE);",
   });
+  reused_region_canvas_repeat->add_during_lifetime("_trigger();");
   reused_region_canvas_repeat->add_during_lifetime(access_type_code);
   reused_region_canvas_repeat->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
 
@@ -199,7 +200,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
   std::vector< std::shared_ptr<RegionCodeCanvas> >variants = {};
   CodeCanvas code_simple;
   code_simple.add_global("char *target_address;");
-  std::shared_ptr<StackRegion> stack_memory_region = std::dynamic_pointer_cast<StackRegion>(memory_region);
+  std::shared_ptr<StackRegion> stack_memory_region = std::static_pointer_cast<StackRegion>(memory_region);
   std::shared_ptr<StackRegion> stack_memory_region_simple = std::make_shared<StackRegion>(*stack_memory_region);
   std::shared_ptr<RegionCodeCanvas> region_canvas = stack_memory_region_simple->generate(std::make_shared<CodeCanvas>(code_simple), "target", 8, true);
   region_canvas->add_during_lifetime("target_address = &target[0];");
@@ -210,6 +211,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
     region_canvas, "reallocated", 8, false
   );
   reused_region_canvas_simple->add_during_lifetime("if (GET_ADDR_BITS(&reallocated[0]) != GET_ADDR_BITS(target_address)) _exit(PRECONDITIONS_FAILED_VALUE);");
+  reused_region_canvas_simple->add_during_lifetime("_trigger();");
   reused_region_canvas_simple->add_during_lifetime(access_type_code.access_lines);
   reused_region_canvas_simple->add_during_lifetime("_use(reallocated);");
   reused_region_canvas_simple->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
@@ -231,6 +233,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
     "last_address = &reallocated[0];",
     "if (GET_ADDR_BITS(&reallocated[0]) != GET_ADDR_BITS(target_address)) return PRECONDITIONS_FAILED_VALUE;"
   });
+  reused_region_canvas_repeated->add_during_lifetime("_trigger();");
   reused_region_canvas_repeated->add_during_lifetime(access_type_code.access_lines);
   reused_region_canvas_repeated->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
   reused_region_canvas_repeated->add_globals( AccessLocation::AuxiliaryVariable::to_string_vector( access_type_code.aux_variables ) );
@@ -272,6 +275,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
     "}",
     "if (counter == 16) _exit(PRECONDITIONS_FAILED_VALUE);"
   });
+  reused_region_canvas_simple_array->add_during_lifetime("_trigger();");
   reused_region_canvas_simple_array->add_during_lifetime(access_type_code.access_lines);
   reused_region_canvas_simple_array->add_during_lifetime("_exit(TEST_CASE_SUCCESSFUL_VALUE);");
   reused_region_canvas_simple_array->add_globals( AccessLocation::AuxiliaryVariable::to_string_vector( access_type_code.aux_variables ) );
@@ -299,6 +303,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
     "}",
     "if (counter == 16) _exit(PRECONDITIONS_FAILED_VALUE);"
   });
+  reused_region_canvas_array_repeated->add_during_lifetime("_trigger();");
   reused_region_canvas_array_repeated->add_during_lifetime(access_type_code.access_lines);
   reused_region_canvas_array_repeated->add_during_lifetime("return TEST_CASE_SUCCESSFUL_VALUE;");
 
@@ -336,11 +341,11 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::generate_validatio
   std::shared_ptr<AccessLocation> access_location
   ) const
 {
-  if (is_a<FreedMemory>(memory_state))
+  if (memory_state->get_id() == memory_state_id_t::FREED_MEMORY)
   {
     return _generate_unused_mem_validation(memory_region, access_action, access_location);
   }
-  assert(is_a<UsedMemory>(memory_state));
+  assert(memory_state->get_id() == memory_state_id_t::USED_MEMORY);
   return _generate_reused_mem_validation(memory_region, access_action, access_location);
 }
 
@@ -350,8 +355,8 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_unused_m
   std::shared_ptr<AccessAction> access_action,
   std::shared_ptr<AccessLocation> access_location) const
 {
-  if ( is_a<HeapRegion>(memory_region) ) return _generate_unused_mem_heap_validation(memory_region, access_action, access_location);
-  assert( is_a<StackRegion>(memory_region) );
+  if ( memory_region->get_id() == region_id_t::HEAP ) return _generate_unused_mem_heap_validation(memory_region, access_action, access_location);
+  assert( memory_region->get_id() == region_id_t::STACK );
   return _generate_unused_mem_stack_validation(memory_region, access_action, access_location);
 }
 
@@ -364,7 +369,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_unused_m
   std::vector< std::shared_ptr<RegionCodeCanvas> >variants = {};
   CodeCanvas code_simple;
   code_simple.add_global("char *target_address;");
-  std::shared_ptr<StackRegion> stack_memory_region = std::dynamic_pointer_cast<StackRegion>(memory_region);
+  std::shared_ptr<StackRegion> stack_memory_region = std::static_pointer_cast<StackRegion>(memory_region);
   std::shared_ptr<StackRegion> stack_memory_region_simple = std::make_shared<StackRegion>(*stack_memory_region);
   std::shared_ptr<RegionCodeCanvas> region_canvas = stack_memory_region_simple->generate(std::make_shared<CodeCanvas>(code_simple), "target", 8, true);
 
@@ -398,7 +403,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_unused_m
   code.add_global("char *target_address;");
   std::shared_ptr<RegionCodeCanvas> region_canvas = memory_region->generate(std::make_shared<CodeCanvas>(code), "target", 8, /*initialize=*/true);
 
-  assert( is_a<HeapRegion>(memory_region) );
+  assert( memory_region->get_id() == region_id_t::HEAP );
 
   std::vector<std::string> access_type_code = access_location->generate(
     access_action, "target_address", 8);
@@ -421,8 +426,8 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
   std::shared_ptr<AccessAction> access_action,
   std::shared_ptr<AccessLocation> access_location) const
 {
-  if ( is_a<HeapRegion>(memory_region) ) return _generate_reused_mem_heap_validation(memory_region, access_action, access_location);
-  assert( is_a<StackRegion>(memory_region) );
+  if ( memory_region->get_id() == region_id_t::HEAP ) return _generate_reused_mem_heap_validation(memory_region, access_action, access_location);
+  assert( memory_region->get_id() == region_id_t::STACK );
   return _generate_reused_mem_stack_validation(memory_region, access_action, access_location);
 }
 
@@ -437,12 +442,12 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
   // code.add_global("char *last_address = NULL;");
   std::shared_ptr<RegionCodeCanvas> region_canvas = memory_region->generate(std::make_shared<CodeCanvas>(code), "target", 8, false);
 
-  assert ( is_a<HeapRegion>(memory_region) );
+  assert ( memory_region->get_id() == region_id_t::HEAP );
 
   region_canvas->add_during_lifetime("target_address = &target[0];");
     std::vector<std::string> access_type_code = access_location->generate(
     access_action, "target_address", 8);
-  std::shared_ptr<HeapRegion> heap_memory_region = std::dynamic_pointer_cast<HeapRegion>(memory_region);
+  std::shared_ptr<HeapRegion> heap_memory_region = std::static_pointer_cast<HeapRegion>(memory_region);
 
   std::shared_ptr<RegionCodeCanvas> reused_region_canvases = heap_memory_region->generate(
     region_canvas->get_lifetime_pos(), region_canvas, "reallocated", 8, false);
@@ -491,7 +496,7 @@ std::vector< std::shared_ptr<RegionCodeCanvas> >UseAfterStar::_generate_reused_m
   code_simple.add_test_case_description_line("Bug type: use-after-*, reused memory");
   code_simple.add_test_case_description_line("Access type: " + access_location->get_name() + ", " + access_action->get_name());
 
-  std::shared_ptr<StackRegion> stack_memory_region = std::dynamic_pointer_cast<StackRegion>(memory_region);
+  std::shared_ptr<StackRegion> stack_memory_region = std::static_pointer_cast<StackRegion>(memory_region);
   std::shared_ptr<StackRegion> stack_memory_region_simple = std::make_shared<StackRegion>(*stack_memory_region);
   std::shared_ptr<RegionCodeCanvas> region_canvas = stack_memory_region_simple->generate(std::make_shared<CodeCanvas>(code_simple), "target", 8, true);
 
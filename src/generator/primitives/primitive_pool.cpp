@@ -7,6 +7,8 @@
 
 #include "generator/primitives/primitive_pool.h"
 
+#include <cassert>
+
 #include "generator/primitives/access_types/direct_location.h"
 #include "generator/primitives/access_types/read_action.h"
 #include "generator/primitives/access_types/stdlib_location.h"
@@ -28,59 +30,76 @@
 #include "generator/primitives/regions/heap_region.h"
 #include "generator/primitives/regions/stack_region.h"
 
+/**
+ * Places each primitive at the index of its ID. Every ID of the dimension must be covered exactly once.
+ */
+template <typename T>
+static std::vector< std::shared_ptr<T> > make_pool(std::initializer_list< std::shared_ptr<T> > primitives)
+{
+  std::vector< std::shared_ptr<T> > pool(primitives.size());
+  for ( const auto &primitive: primitives )
+  {
+    const size_t id = static_cast<size_t>(primitive->get_id());
+    assert(id < pool.size() && !pool[id]);
+    pool[id] = primitive;
+  }
+  assert(pool.size() == get_dimension(pool.front()->get_id()).size());
+  return pool;
+}
+
 /**
  * Memory regions
  */
-std::set< std::shared_ptr<Region> > memory_regions = {
-  std::make_shared<StackRegion>(),
+std::vector< std::shared_ptr<Region> > memory_regions = make_pool<Region>({
   std::make_shared<HeapRegion>(),
+  std::make_shared<StackRegion>(),
   std::make_shared<GlobalRegion>()
-};
+});
 
 /**
  * Temporal memory bug types
  */
-std::set< std::shared_ptr<MemoryState> > memory_states = {
+std::vector< std::shared_ptr<MemoryState> > memory_states = make_pool<MemoryState>({
   std::make_shared<UsedMemory>(),
   std::make_shared<FreedMemory>()
-};
+});
 
-std::set< std::shared_ptr<TemporalBugType> > temporal_bug_types = {
-   std::make_shared<DoubleFree>(),
-   std::make_shared<MisuseOfFree>(),
-   std::make_shared<UseAfterStar>()
-};
+std::vector< std::shared_ptr<TemporalBugType> > temporal_bug_types = make_pool<TemporalBugType>({
+  std::make_shared<MisuseOfFree>(),
+  std::make_shared<DoubleFree>(),
+  std::make_shared<UseAfterStar>()
+});
 
 
 /**
  * Spatial memory bug types
  */
-std::set< std::shared_ptr<Flow> > flows = {
+std::vector< std::shared_ptr<Flow> > flows = make_pool<Flow>({
   std::make_shared<Overflow>(),
   std::make_shared<Underflow>()
-};
+});
 
-std::set< std::shared_ptr<OriginTargetRelation> > origin_target_relations = {
-  std::make_shared<InterObject>(),
+std::vector< std::shared_ptr<OriginTargetRelation> > origin_target_relations = make_pool<OriginTargetRelation>({
+  std::make_shared<NonObject>(),
   std::make_shared<IntraObject>(),
-  std::make_shared<NonObject>()
-};
+  std::make_shared<InterObject>()
+});
 
-std::set< std::shared_ptr<SpatialBugType> > spatial_bug_types = {
+std::vector< std::shared_ptr<SpatialBugType> > spatial_bug_types = make_pool<SpatialBugType>({
   std::make_shared<LinearOOBA>(),
   std::make_shared<NonLinearOOBA>(),
   std::make_shared<TypeConfusion>()
-};
+});
 
 /**
  * Access types
  */
-std::set< std::shared_ptr<AccessAction> > access_type_actions = {
+std::vector< std::shared_ptr<AccessAction> > access_type_actions = make_pool<AccessAction>({
   std::make_shared<ReadAction>(),
   std::make_shared<WriteAction>()
-};
+});
 
-std::set< std::shared_ptr<AccessLocation> > access_type_locations = {
-  std::make_shared<DirectLocation>(),
-  std::make_shared<StdlibLocation>()
-};
+std::vector< std::shared_ptr<AccessLocation> > access_type_locations = make_pool<AccessLocation>({
+  std::make_shared<StdlibLocation>(),
+  std::make_shared<DirectLocation>()
+});
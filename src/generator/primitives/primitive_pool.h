@@ -8,7 +8,7 @@
 #pragma once
 
 #include <memory>
-#include <set>
+#include <vector>
 
 #include "bug_types/spatial/spatial_bug_type.h"
 #include "bug_types/temporal/temporal_bug_type.h"
@@ -17,26 +17,31 @@
 #include "generator/primitives/access_types/access_location.h"
 #include "generator/primitives/regions/region.h"
 
+/**
+ * The pools hold one instance of each primitive of a dimension, indexed by its ID (see primitive_registry.h),
+ * so the generator enumerates the primitives in ID order.
+ */
+
 /**
  * Memory regions
  */
-extern std::set< std::shared_ptr<Region> > memory_regions;
+extern std::vector< std::shared_ptr<Region> > memory_regions;
 
 /**
  * Temporal memory bug types
  */
-extern std::set< std::shared_ptr<MemoryState> > memory_states;
-extern std::set< std::shared_ptr<TemporalBugType> > temporal_bug_types;
+extern std::vector< std::shared_ptr<MemoryState> > memory_states;
+extern std::vector< std::shared_ptr<TemporalBugType> > temporal_bug_types;
 
 /**
  * Spatial memory bug types
  */
-extern std::set< std::shared_ptr<SpatialBugType> > spatial_bug_types;
-extern std::set< std::shared_ptr<Flow> > flows;
-extern std::set< std::shared_ptr<OriginTargetRelation> > origin_target_relations;
+extern std::vector< std::shared_ptr<SpatialBugType> > spatial_bug_types;
+extern std::vector< std::shared_ptr<Flow> > flows;
+extern std::vector< std::shared_ptr<OriginTargetRelation> > origin_target_relations;
 
 /**
  * Access types
  */
-extern std::set< std::shared_ptr<AccessAction> > access_type_actions;
-extern std::set< std::shared_ptr<AccessLocation> > access_type_locations;
+extern std::vector< std::shared_ptr<AccessAction> > access_type_actions;
+extern std::vector< std::shared_ptr<AccessLocation> > access_type_locations;
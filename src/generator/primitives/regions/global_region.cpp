@@ -10,7 +10,7 @@
 #include <cassert>
 
 GlobalRegion::GlobalRegion():
-  Region("global")
+  Region(region_id_t::GLOBAL)
 {
 }
 
@@ -21,12 +21,7 @@ std::shared_ptr<RegionCodeCanvas> GlobalRegion::generate(std::shared_ptr<CodeCan
   std::string definition = "char " + name + "[" + std::to_string(size) + "]";
   if (initialize)
   {
-    definition += " = {";
-    for (size_t i = 0; i < (size - 1); i++)
-    {
-      definition += "0xAA, ";
-    }
-    definition += "0xAA}";
+    definition += " = " + generate_initializer("0xAA", size);
   }
   definition += ";";
   auto it = populated_code_canvas->add_global(definition);
@@ -61,17 +56,7 @@ std::shared_ptr<RegionCodeCanvas> GlobalRegion::generate(
   std::string definition = "struct T " + name;
   if (initialize)
   {
-    definition += " = { {";
-    for (size_t i = 0; i < (size_field_1 - 1); i++)
-    {
-      definition += "0xAA, ";
-    }
-    definition += "0xAA}, {";
-    for (size_t i = 0; i < (size_field_2 - 1); i++)
-    {
-      definition += "0xBB, ";
-    }
-    definition += "0xBB} }";
+    definition += " = { " + generate_initializer("0xAA", size_field_1) + ", " + generate_initializer("0xBB", size_field_2) + " }";
   }
   definition += ";";
   auto it = populated_code_canvas->add_global(definition);
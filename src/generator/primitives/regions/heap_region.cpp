@@ -12,7 +12,7 @@
 #include <ostream>
 
 HeapRegion::HeapRegion():
-  Region("heap")
+  Region(region_id_t::HEAP)
 {
 }
 
@@ -30,9 +30,9 @@ std::shared_ptr<RegionCodeCanvas> HeapRegion::generate(CodeCanvas::code_pos_t wh
   CodeCanvas::code_pos_t lifetime_pos;
   if (initialize)
   {
-    for (size_t i = 0; i < size; i++)
+    for (const auto &line: generate_initialization(name, "0xAA", size))
     {
-      where = populated_code_canvas->add_at(where, name + "[" + std::to_string(i) + "] = 0xAA;", "  ");
+      where = populated_code_canvas->add_at(where, line, "  ");
     }
     lifetime_pos = where;
   }
@@ -58,9 +58,9 @@ std::shared_ptr<RegionCodeCanvas> HeapRegion::generate(std::shared_ptr<CodeCanva
   CodeCanvas::code_pos_t lifetime_pos = populated_code_canvas->get_lifetime_pos();
   if (initialize)
   {
-    for (size_t i = 0; i < size; i++)
+    for (const auto &line: generate_initialization(name, "0xAA", size))
     {
-      lifetime_pos = populated_code_canvas->add_to_f_body(name + "[" + std::to_string(i) + "] = 0xAA;");
+      lifetime_pos = populated_code_canvas->add_to_f_body(line);
     }
   }
   else
@@ -99,13 +99,13 @@ std::shared_ptr<RegionCodeCanvas> HeapRegion::generate(
   CodeCanvas::code_pos_t lifetime_pos = populated_code_canvas->get_lifetime_pos();
   if (initialize)
   {
-    for (size_t i = 0; i < size_field_1; i++)
+    for (const auto &line: generate_initialization(name + "->" + name_field_1, "0xAA", size_field_1))
     {
-      lifetime_pos = populated_code_canvas->add_to_f_body(name + "->" + name_field_1 + "[" + std::to_string(i) + "] = 0xAA;");
+      lifetime_pos = populated_code_canvas->add_to_f_body(line);
     }
-    for (size_t i = 0; i < size_field_2; i++)
+    for (const auto &line: generate_initialization(name + "->" + name_field_2, "0xBB", size_field_2))
     {
-      lifetime_pos = populated_code_canvas->add_to_f_body(name + "->" + name_field_2 + "[" + std::to_string(i) + "] = 0xBB;");
+      lifetime_pos = populated_code_canvas->add_to_f_body(line);
     }
   }
   else
@@ -126,9 +126,9 @@ std::vector<std::string> HeapRegion::generate_reallocation(std::string name, siz
 
   if (initialize)
   {
-    for (size_t i = 0; i < size; i++)
+    for (const auto &line: generate_initialization(name, "0xAA", size))
     {
-      reallocation.push_back(indent + name + "[" + std::to_string(i) + "] = 0xAA;");
+      reallocation.push_back(indent + line);
     }
   }
   return reallocation;
@@ -54,8 +54,37 @@ CodeCanvas::code_pos_t RegionCodeCanvas::add_during_lifetime(const std::string &
 }
 
 
-Region::Region(std::string name):
-  Property(std::move(name))
+Region::Region(region_id_t id):
+  Property(id)
 {
 }
 
+
+std::vector<std::string> Region::generate_initialization(const std::string &target, const std::string &value, size_t size)
+{
+  if ( CodeCanvas::is_compact_emission() )
+  {
+    return {"_fill(" + target + ", " + value + ", " + std::to_string(size) + ");"};
+  }
+  std::vector<std::string> lines;
+  for (size_t i = 0; i < size; i++)
+  {
+    lines.push_back(target + "[" + std::to_string(i) + "] = " + value + ";");
+  }
+  return lines;
+}
+
+std::string Region::generate_initializer(const std::string &value, size_t size)
+{
+  assert(size);
+  if ( CodeCanvas::is_compact_emission() )
+  {
+    return "{[0 ... " + std::to_string(size - 1) + "] = " + value + "}";
+  }
+  std::string initializer = "{";
+  for (size_t i = 0; i < (size - 1); i++)
+  {
+    initializer += value + ", ";
+  }
+  return initializer + value + "}";
+}
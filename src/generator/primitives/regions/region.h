@@ -100,10 +100,10 @@ private:
   size_t static_var_size;
 };
 
-class Region: public Property
+class Region: public Property<region_id_t>
 {
 public:
-  explicit Region(std::string name);
+  explicit Region(region_id_t id);
   virtual ~Region() = default;
 
   virtual std::shared_ptr<RegionCodeCanvas> generate(std::shared_ptr<CodeCanvas> canvas, std::string name, size_t size, bool initialize) const = 0;
@@ -115,4 +115,16 @@ public:
     std::string name_field_2, size_t size_field_2,
     bool initialize
   ) const = 0;
+
+protected:
+  /**
+   * Statements setting the first size bytes of the char array target to value: one statement per byte,
+   * or a single _fill() call when emitting compact code.
+   */
+  static std::vector<std::string> generate_initialization(const std::string &target, const std::string &value, size_t size);
+
+  /**
+   * Initializer for a char array of size bytes, all set to value.
+   */
+  static std::string generate_initializer(const std::string &value, size_t size);
 };
@@ -11,7 +11,7 @@
 #include <cassert>
 
 StackRegion::StackRegion():
-  Region("stack")
+  Region(region_id_t::STACK)
 {
 }
 
@@ -22,9 +22,9 @@ std::shared_ptr<RegionCodeCanvas> StackRegion::generate(std::shared_ptr<CodeCanv
   CodeCanvas::code_pos_t current = allocation_pos;
   if (initialize)
   {
-    for (size_t i = 0; i < size; i++)
+    for (const auto &line: generate_initialization(name, "0xAA", size))
     {
-      current = populated_code_canvas->add_to_f_body(name + "[" + std::to_string(i) + "] = 0xAA;");
+      current = populated_code_canvas->add_to_f_body(line);
     }
   }
   populated_code_canvas->set_allocation_pos(allocation_pos - 1);
@@ -47,9 +47,9 @@ std::shared_ptr<RegionCodeCanvas> StackRegion::generate_in_other_f(std::shared_p
   CodeCanvas::code_pos_t current = allocation_pos;
   if (initialize)
   {
-    for (size_t i = 0; i < size; i++)
+    for (const auto &line: generate_initialization(name, "0xAA", size))
     {
-      current = populated_code_canvas->add_to_other_f_body(name + "[" + std::to_string(i) + "] = 0xAA;");
+      current = populated_code_canvas->add_to_other_f_body(line);
     }
   }
   populated_code_canvas->set_allocation_pos(allocation_pos - 1);
@@ -70,9 +70,9 @@ std::shared_ptr<RegionCodeCanvas> StackRegion::generate_array(std::shared_ptr<Co
   {
     populated_code_canvas->add_to_f_body("for (int i = 0; i < " + std::to_string(array_size) + "; i++)");
     populated_code_canvas->add_to_f_body("{");
-    for (size_t i = 0; i < size; i++)
+    for (const auto &line: generate_initialization(name + "[i]", "0xAA", size))
     {
-      populated_code_canvas->add_to_f_body("  " + name + "[i][" + std::to_string(i) + "] = 0xAA;");
+      populated_code_canvas->add_to_f_body("  " + line);
     }
     current = populated_code_canvas->add_to_f_body("}");
   }
@@ -105,13 +105,13 @@ std::shared_ptr<RegionCodeCanvas> StackRegion::generate(
   CodeCanvas::code_pos_t current = allocation_pos;
   if (initialize)
   {
-    for (size_t i = 0; i < size_field_1; i++)
+    for (const auto &line: generate_initialization(name + "." + name_field_1, "0xAA", size_field_1))
     {
-      current = populated_code_canvas->add_to_f_body(name + "." + name_field_1 + "[" + std::to_string(i) + "] = 0xAA;");
+      current = populated_code_canvas->add_to_f_body(line);
     }
-    for (size_t i = 0; i < size_field_2; i++)
+    for (const auto &line: generate_initialization(name + "." + name_field_2, "0xBB", size_field_2))
     {
-      current = populated_code_canvas->add_to_f_body(name + "." + name_field_2 + "[" + std::to_string(i) + "] = 0xBB;");
+      current = populated_code_canvas->add_to_f_body(line);
     }
   }
   populated_code_canvas->set_allocation_pos(allocation_pos - 1);
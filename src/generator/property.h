@@ -8,16 +8,23 @@
 #pragma once
 #include <algorithm>
 #include <string>
-#include <utility>
 
+#include "primitive_registry.h"
 
+/**
+ * Base of all primitives. Id is the ID enum of the primitive's dimension (see primitive_registry.h), which
+ * provides its name; comparing IDs replaces checking the dynamic type of a primitive.
+ */
+template <typename Id>
 class Property
 {
 public:
-  explicit Property(std::string name):
-    name(std::move(name))
+  explicit Property(Id id):
+    id(id),
+    name(get_primitive_names(id).name)
   {}
 
+  Id get_id() const { return id; }
   std::string get_name() const { return name; }
   std::string get_printable_name() const
   {
@@ -26,5 +33,6 @@ public:
     return printable_name;
   }
 private:
+  Id id;
   std::string name;
 };
@@ -5,14 +5,23 @@
  * Initial author: Emanuel Vintila
  */
 
+#include <cerrno>
+#include <cstdlib>
 #include <iostream>
+#include <sstream>
 #include <vector>
 
 #include "arg_parser.h"
 #include "config.h"
 #include "misc.h"
 #include "evaluator/evaluator.h"
+#include "evaluator/scheduler.h"
+#include "generator/code_canvas.h"
+#include "generator/generation_profile.h"
 #include "generator/generator.h"
+#include "test_case_selector.h"
+#include "server.h"
+#include "trace.h"
 
 static const std::string DEFAULT_GENERATED_DIR_NAME = "test_cases";
 static const std::string DEFAULT_GENERATED_PATH = "../" + DEFAULT_GENERATED_DIR_NAME;
@@ -22,27 +31,81 @@ static bool do_evaluate = false;
 static bool do_evaluate_prebuilt = false;
 static bool do_generate = false;
 static bool do_compile = false;
+static bool do_merge = false;
 static bool remove_dir = false;
 static bool print_table_summary = false;
 static bool verbose = false;
+static bool json_log = false;
 static bool evaluate_baseline = false;
 static bool run_all_variants = false;
 static bool keep_binaries = false;
-static std::string sanitizer_config_path;
+static bool in_memory = false;
+static bool compact = false;
+static std::vector<std::string> sanitizer_config_paths;
+static size_t jobs = 0; // 0: not given, see run()
+static size_t speculation = 1;
+static size_t shard_index = 0;
+static size_t shard_count = 1;
+static std::string results_path;
+static std::vector<std::string> partial_results_paths;
+static std::string export_path;
+static std::string journal_path;
+static bool resume = false;
+static bool no_dedup = false;
+static bool measure_footprint = false;
+static bool measure_latency = false;
+static std::string durations_path;
+static size_t budget_seconds = 0;
+static bool print_stats = false;
+static std::string metrics_path;
+static std::string trace_path;
+static std::string serve_socket_path;
+static std::string coordinator_address;
+static std::string worker_address;
+static bool is_daemon_job = false; // run by the daemon, see serve()
+static std::string packed_suite_path;
+static std::string generation_profile_path;
+static std::unique_ptr<TestCaseSelector> selector;
 
 const std::vector<std::tuple< std::string, ArgParser::Argument>> accepted_arguments
 {
   // arg name,                                                          has_value, value_name,              default_value,              description,   [hidden]
-  std::make_tuple( "--evaluate",                    ArgParser::Argument{true,      "<SANITIZER_CONFIG>",    "",                         "\t\t\tEvaluate the sanitizer configured in <SANITIZER_CONFIG> using the test case files in <TEST_CASE_DIR>."} ),
+  std::make_tuple( "--evaluate",                    ArgParser::Argument{true,      "<SANITIZER_CONFIG>",    "",                         "\t\t\tEvaluate the sanitizer configured in <SANITIZER_CONFIG> using the test case files in <TEST_CASE_DIR>. Several sanitizers are evaluated at once when given a comma-separated list of configuration files; the test cases are then parsed and the baseline evaluated only once, and a comparison table is printed."} ),
   std::make_tuple( "--evaluate-baseline",           ArgParser::Argument{false ,    "",                      "",                         "\t\t\t\tEvaluate the baseline alongside the sanitizer. This option is applicable only when --evaluate is specified."} ),
   std::make_tuple( "--generate",                    ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tRegenerate test cases. The generated files will be placed in <TEST_CASE_DIR>. If the directory is not empty and --clean-test-cases is not specified, the test case generation is aborted."} ),
   std::make_tuple( "--test-case-dir",               ArgParser::Argument{true,      "<TEST_CASE_DIR>",       DEFAULT_GENERATED_DIR_NAME, "\t\tSpecify <TEST_CASE_DIR> as the location for the generated test case files. Default: \"../" + DEFAULT_GENERATED_DIR_NAME + "/\"."} ),
   std::make_tuple( "--clean-test-cases",            ArgParser::Argument{false,     "",                      "",                         "\t\t\t\tRemove all contents from <TEST_CASE_DIR> before generating test cases. This option is applicable only when --generate is specified."} ),
   std::make_tuple( "--verbose",                     ArgParser::Argument{false ,    "",                      "",                         "\t\t\t\t\tPrint detailed evaluation results."} ),
+  std::make_tuple( "--log-format",                  ArgParser::Argument{true,      "<text|json>",           "",                         "\t\t\tPrint the evaluation results as text (default) or as JSON lines, one object per line with the fields time, level, thread and message."} ),
   std::make_tuple( "--run-all-variants",            ArgParser::Argument{false ,    "",                      "",                         "\t\t\t\tRun all variants of a test case, even if one has already been successful. This option is applicable only when --evaluate is specified."} ),
   std::make_tuple( "--keep-binaries",               ArgParser::Argument{false ,    "",                      "",                         "\t\t\t\tKeep the test case binaries. This option is applicable only when --evaluate is specified."} ),
   std::make_tuple( "--evaluate-prebuilt-binaries",  ArgParser::Argument{true ,     "<SANITIZER_CONFIG>",    "",                         "\t\t\t\tEvaluate the sanitizer configured in <SANITIZER_CONFIG> using the pre-built binaries in <TEST_CASE_DIR>."} ),
   std::make_tuple( "--compile",                     ArgParser::Argument{true,      "<SANITIZER_CONFIG>",    "",                         "\t\t\tCompile all the test case files in <TEST_CASE_DIR> using the sanitizer configured in <SANITIZER_CONFIG>."} ),
+  std::make_tuple( "--packed-suite",                ArgParser::Argument{true,      "<SUITE_FILE>",          "",                         "\t\t\tUse the single packed file <SUITE_FILE> instead of the test case files in <TEST_CASE_DIR>. With --generate, all test cases are packed into <SUITE_FILE>. With --evaluate or --compile, the test cases are read from <SUITE_FILE>."} ),
+  std::make_tuple( "--in-memory",                   ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tPipe the test case sources to the compiler and keep binaries on tmpfs until they are evaluated. Combined with --generate and --evaluate, no test case file is written. This option is applicable only when --evaluate or --compile is specified."} ),
+  std::make_tuple( "--only",                        ArgParser::Argument{true,      "<QUERY>",               "",                         "\t\t\t\tOnly generate, compile, or evaluate the test cases selected by <QUERY>: an ID such as 10000001:3 (see --verbose), a group ID such as 10000001 selecting all variants, or a dimension query such as bug=linear_ooba,origin=heap,action=write."} ),
+  std::make_tuple( "--compact",                     ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tGenerate compact test cases: the common prelude is shared in mset_prelude.h and objects are initialized by a loop instead of one statement per byte. This option is applicable only when --generate is specified."} ),
+  std::make_tuple( "--generation-profile",          ArgParser::Argument{true,      "<PROFILE>",             "",                         "\t\t\tGenerate the spatial test cases for each of the object sizes listed or swept in the XML file <PROFILE> instead of the default 8-byte objects. This option is applicable only when --generate is specified."} ),
+  std::make_tuple( "--jobs",                        ArgParser::Argument{true,      "<N>",                   "",                         "\t\t\t\tCompile and execute up to <N> test cases concurrently. Default: the number of online CPUs when several sanitizer configurations are given, otherwise 1. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--speculate",                   ArgParser::Argument{true,      "<K>",                   "",                         "\t\t\t\tEvaluate up to <K> variants of a test case concurrently instead of one after the other. The results are the same as without this option: results are still considered in variant order, and variants following a successful one are killed and their results discarded. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--shard",                       ArgParser::Argument{true,      "<I/N>",                 "",                         "\t\t\t\tOnly compile or evaluate the test cases of shard <I> out of <N> shards, numbered from 0. The test cases are assigned to shards by a hash of their ID, keeping all variants of a test case in the same shard. Combine with --save-results and --merge-results to split an evaluation across machines."} ),
+  std::make_tuple( "--save-results",                ArgParser::Argument{true,      "<RESULTS_FILE>",        "",                         "\t\tWrite the results to <RESULTS_FILE>, e.g., the partial results of a shard. This option is applicable only when --evaluate or --evaluate-prebuilt-binaries is specified."} ),
+  std::make_tuple( "--merge-results",               ArgParser::Argument{true,      "<RESULTS_FILE>",        "",                         "\t\tCombine the comma-separated results files written by --save-results, e.g., by all shards of an evaluation, and print the results as if they came from a single evaluation."} ),
+  std::make_tuple( "--export",                      ArgParser::Argument{true,      "<EXPORT_FILE>",         "",                         "\t\tWrite a record per evaluated variant to <EXPORT_FILE> as soon as its result is known, with its test case, dimensions, variant, phase, result, compile and run time and peak memory, and the aggregated results per primitive of each dimension at the end. The file is written as CSV if its name ends in .csv, and as JSON Lines otherwise. This option is applicable only when --evaluate, --evaluate-prebuilt-binaries or --merge-results is specified."} ),
+  std::make_tuple( "--journal",                     ArgParser::Argument{true,      "<JOURNAL_FILE>",        "",                         "\t\tAppend the result of each variant to <JOURNAL_FILE> as soon as it is evaluated, so that an interrupted evaluation can be resumed with --resume. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--resume",                      ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tResume the evaluation recorded in the --journal file: the test cases it finished are not evaluated again, and the final results are the same as those of an uninterrupted evaluation. The other options must be the same as for the interrupted evaluation."} ),
+  std::make_tuple( "--durations",                   ArgParser::Argument{true,      "<DURATIONS_FILE>",      "",                         "\t\tRecord the compile and run durations of each variant in <DURATIONS_FILE>, and use the durations recorded by previous evaluations to start the longest test cases first, to estimate the duration of the evaluation up front and to report the remaining time while evaluating. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--budget",                      ArgParser::Argument{true,      "<SECONDS>",             "",                         "\t\t\tEvaluate only a stratified sample of the test cases, across bug types and regions or origin-target relations, that is expected to take at most <SECONDS> according to the --durations file, and print the estimated detection rates of all test cases with 95% confidence intervals. Test cases not started when the budget is spent are skipped. This option is applicable only when --evaluate is specified and cannot be combined with --journal or --save-results."} ),
+  std::make_tuple( "--stats",                       ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tPrint the wall time spent in each phase of the evaluation, the compile and run latencies of the variants, the throughput and the utilization of the threads at the end. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--metrics-file",                ArgParser::Argument{true,      "<METRICS_FILE>",        "",                         "\t\tRewrite <METRICS_FILE> every few seconds during the evaluation with its metrics in the Prometheus text format, e.g., for the textfile collector of the node exporter: time per phase, compile and run latency histograms, queued and finished jobs, busy threads, throughput and expected remaining time. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--trace-out",                   ArgParser::Argument{true,      "<TRACE_FILE>",          "",                         "\t\tWrite a timeline of the run to <TRACE_FILE> in the trace event format, viewable in Perfetto or chrome://tracing: a span for generating the test cases, for evaluating each test case and each of its variants, for each compile and setup command, each execution, each timeout kill and the aggregation of the results, tagged with the thread and the test case."} ),
+  std::make_tuple( "--serve",                       ArgParser::Argument{true,      "<SOCKET>",              "",                         "\t\t\tRun as a daemon accepting jobs from --connect on the Unix socket <SOCKET> until terminated. The sanitizer configurations given with --evaluate and the test cases of <TEST_CASE_DIR> or --packed-suite are loaded once at startup and reused by the jobs while their files are unchanged, and the binaries and deterministic results of the jobs are kept for the following jobs. Jobs run one at a time."} ),
+  std::make_tuple( "--connect",                     ArgParser::Argument{true,      "<SOCKET>",              "",                         "\t\t\tRun the command given by the other arguments as a job of the daemon listening on <SOCKET> (see --serve), in the current directory, printing its output as it runs. Without other arguments, print the status of the daemon."} ),
+  std::make_tuple( "--coordinate",                  ArgParser::Argument{true,      "<ADDRESS>",             "",                         "\t\tInstead of evaluating the test cases, hand them out to the --worker processes connecting to <ADDRESS>, a Unix socket path or <HOST>:<PORT>, and report their results. An empty <HOST> listens on the loopback interface only; workers are not authenticated, so only listen on trusted networks. Workers pull one test case at a time, and the test cases of a worker that is lost or stops renewing its lease within a minute are handed out again. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--worker",                      ArgParser::Argument{true,      "<ADDRESS>",             "",                         "\t\t\tEvaluate the test cases handed out by the --coordinate process at <ADDRESS> until it has none left, on --jobs threads. The worker must be given the same sanitizer configurations, options, and test cases as the coordinator. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--no-dedup",                    ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tCompile and execute every variant, even if it builds like another one. By default, variants whose sources differ only in comments share one binary, and sanitizers configured as deterministic execute identical binaries only once. This option is applicable only when --evaluate is specified."} ),
+  std::make_tuple( "--footprint",                   ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tRead the sizes of the .text, .data, .bss and .data.index sections and the number of calls to sanitizer checks (e.g., __asan_report_*) of each binary once it is built, and print them per sanitizer at the end, as the mean per binary and its growth against the baseline binaries of the same variants if --evaluate-baseline is specified, and per variant with --verbose. This option is applicable only when --evaluate is specified and cannot be combined with --coordinate or --worker."} ),
+  std::make_tuple( "--latency",                     ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tMeasure the time from each test case triggering its bug until it terminated, for the variants that the sanitizer detects, and print its percentiles per sanitizer and bug type at the end. Only test cases generated with _trigger() in their prelude report the trigger; the baseline and the validation variants are not measured. This option is applicable only when --evaluate is specified and cannot be combined with --coordinate or --worker."} ),
   std::make_tuple( "--help",                        ArgParser::Argument{false,     "",                      "",                         "\t\t\t\t\tShow this help message and exit."} ),
   // hidden options:
   std::make_tuple( "--print-table-summary",         ArgParser::Argument{false ,    "",                      "",                         "", true } )
@@ -65,6 +128,42 @@ static void print_usage()
   }
 }
 
+static std::vector<std::string> split_list(const std::string &list)
+{
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while ( std::getline(stream, item, ',') )
+  {
+    if ( !item.empty() )
+    {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+// e.g., "1/4"
+static bool parse_shard(const std::string &shard, size_t &index, size_t &count)
+{
+  const size_t separator = shard.find('/');
+  if ( separator == std::string::npos )
+  {
+    return false;
+  }
+  const std::string index_part = shard.substr(0, separator);
+  const std::string count_part = shard.substr(separator + 1);
+  if ( index_part.empty() || count_part.empty()
+    || index_part.find_first_not_of("0123456789") != std::string::npos || count_part.find_first_not_of("0123456789") != std::string::npos )
+  {
+    return false;
+  }
+  errno = 0;
+  index = std::strtoull(index_part.c_str(), nullptr, 10);
+  count = std::strtoull(count_part.c_str(), nullptr, 10);
+  return errno != ERANGE && count > 0 && index < count;
+}
+
 static bool parse_arguments(int argc, char **argv)
 {
   std::unique_ptr<ArgParser> parser = ArgParser::construct( argc, const_cast<const char **>(argv), accepted_arguments );
@@ -81,18 +180,55 @@ static bool parse_arguments(int argc, char **argv)
     return false;
   }
 
+  if ( parser->check("--serve") )
+  {
+    std::unique_ptr<std::string> serve_socket_path_ptr = parser->get_value_and_consume("--serve");
+    if ( !serve_socket_path_ptr )
+    {
+      std::cerr << "--serve requires a path to the socket." << std::endl;
+      print_usage();
+      return false;
+    }
+    serve_socket_path = *serve_socket_path_ptr;
+    if ( is_daemon_job )
+    {
+      std::cerr << "--serve cannot be used in a job of a daemon." << std::endl;
+      return false;
+    }
+  }
+
   do_generate = parser->check_and_consume("--generate");
   do_evaluate = parser->check("--evaluate");
   do_evaluate_prebuilt = parser->check("--evaluate-prebuilt-binaries");
   do_compile = parser->check("--compile");
+  do_merge = parser->check("--merge-results");
   remove_dir = parser->check_and_consume("--clean-test-cases");
 
-  if ( !do_generate && !do_evaluate && !do_compile && !do_evaluate_prebuilt && !remove_dir  )
+  if ( !do_generate && !do_evaluate && !do_compile && !do_evaluate_prebuilt && !do_merge && !remove_dir && serve_socket_path.empty() )
   {
-    std::cerr << "You must either specify --generate, --evaluate, --evaluate-prebuilt-binaries, or --compile." << std::endl;
+    std::cerr << "You must either specify --generate, --evaluate, --evaluate-prebuilt-binaries, --compile, or --merge-results." << std::endl;
     print_usage();
     return false;
   }
+  if ( do_merge )
+  {
+    if ( do_generate || do_evaluate || do_compile || do_evaluate_prebuilt )
+    {
+      std::cerr << "--merge-results cannot be used with --generate, --evaluate, --evaluate-prebuilt-binaries, or --compile." << std::endl;
+      return false;
+    }
+    std::unique_ptr<std::string> partial_results_paths_ptr = parser->get_value_and_consume("--merge-results");
+    if ( partial_results_paths_ptr )
+    {
+      partial_results_paths = split_list(*partial_results_paths_ptr);
+    }
+    if ( partial_results_paths.empty() )
+    {
+      std::cerr << "--merge-results requires the paths to the results files." << std::endl;
+      print_usage();
+      return false;
+    }
+  }
 
   std::unique_ptr<std::string> test_case_dir = parser->get_value_and_consume("--test-case-dir");
   if ( test_case_dir )
@@ -113,6 +249,252 @@ static bool parse_arguments(int argc, char **argv)
   keep_binaries = parser->check_and_consume("--keep-binaries");
   evaluate_baseline = parser->check_and_consume("--evaluate-baseline");
   verbose = parser->check_and_consume("--verbose");
+  if ( parser->check("--log-format") )
+  {
+    std::unique_ptr<std::string> log_format_ptr = parser->get_value_and_consume("--log-format");
+    if ( !log_format_ptr || (*log_format_ptr != "text" && *log_format_ptr != "json") )
+    {
+      std::cerr << "--log-format requires text or json." << std::endl;
+      print_usage();
+      return false;
+    }
+    json_log = *log_format_ptr == "json";
+  }
+  in_memory = parser->check_and_consume("--in-memory");
+  compact = parser->check_and_consume("--compact");
+  if ( parser->check("--packed-suite") )
+  {
+    std::unique_ptr<std::string> packed_suite_path_ptr = parser->get_value_and_consume("--packed-suite");
+    if ( !packed_suite_path_ptr )
+    {
+      std::cerr << "--packed-suite requires a path to the packed suite file." << std::endl;
+      print_usage();
+      return false;
+    }
+    packed_suite_path = *packed_suite_path_ptr;
+  }
+  if ( parser->check("--generation-profile") )
+  {
+    std::unique_ptr<std::string> generation_profile_path_ptr = parser->get_value_and_consume("--generation-profile");
+    if ( !generation_profile_path_ptr )
+    {
+      std::cerr << "--generation-profile requires a path to the generation profile file." << std::endl;
+      print_usage();
+      return false;
+    }
+    generation_profile_path = *generation_profile_path_ptr;
+  }
+  if ( parser->check("--only") )
+  {
+    std::unique_ptr<std::string> query = parser->get_value_and_consume("--only");
+    if ( !query )
+    {
+      std::cerr << "--only requires a test case ID or a dimension query." << std::endl;
+      print_usage();
+      return false;
+    }
+    selector = TestCaseSelector::parse(*query);
+    if ( !selector )
+    {
+      return false;
+    }
+  }
+  if ( parser->check("--jobs") )
+  {
+    std::unique_ptr<std::string> jobs_ptr = parser->get_value_and_consume("--jobs");
+    if ( !jobs_ptr || !is_number(*jobs_ptr) || std::stoll(*jobs_ptr) < 1 )
+    {
+      std::cerr << "--jobs requires a positive number of jobs." << std::endl;
+      print_usage();
+      return false;
+    }
+    jobs = static_cast<size_t>(std::stoll(*jobs_ptr));
+  }
+  if ( parser->check("--speculate") )
+  {
+    std::unique_ptr<std::string> speculation_ptr = parser->get_value_and_consume("--speculate");
+    if ( !speculation_ptr || !is_number(*speculation_ptr) || std::stoll(*speculation_ptr) < 1 )
+    {
+      std::cerr << "--speculate requires a positive number of variants." << std::endl;
+      print_usage();
+      return false;
+    }
+    speculation = static_cast<size_t>(std::stoll(*speculation_ptr));
+  }
+  if ( parser->check("--shard") )
+  {
+    std::unique_ptr<std::string> shard = parser->get_value_and_consume("--shard");
+    if ( !shard || !parse_shard(*shard, shard_index, shard_count) )
+    {
+      std::cerr << "--shard requires a shard such as 0/4, numbered from 0." << std::endl;
+      print_usage();
+      return false;
+    }
+    if ( !do_evaluate && !do_compile && !do_evaluate_prebuilt )
+    {
+      std::cerr << "WARNING: --shard used when not compiling or evaluating.\n";
+    }
+  }
+  if ( parser->check("--save-results") )
+  {
+    std::unique_ptr<std::string> results_path_ptr = parser->get_value_and_consume("--save-results");
+    if ( !results_path_ptr )
+    {
+      std::cerr << "--save-results requires a path to the results file." << std::endl;
+      print_usage();
+      return false;
+    }
+    results_path = *results_path_ptr;
+    if ( !do_evaluate && !do_evaluate_prebuilt && !do_merge )
+    {
+      std::cerr << "WARNING: --save-results used when not evaluating.\n";
+    }
+  }
+  if ( parser->check("--export") )
+  {
+    std::unique_ptr<std::string> export_path_ptr = parser->get_value_and_consume("--export");
+    if ( !export_path_ptr )
+    {
+      std::cerr << "--export requires a path to the export file." << std::endl;
+      print_usage();
+      return false;
+    }
+    export_path = *export_path_ptr;
+    if ( !do_evaluate && !do_evaluate_prebuilt && !do_merge )
+    {
+      std::cerr << "WARNING: --export used when not evaluating.\n";
+    }
+  }
+  if ( parser->check("--journal") )
+  {
+    std::unique_ptr<std::string> journal_path_ptr = parser->get_value_and_consume("--journal");
+    if ( !journal_path_ptr )
+    {
+      std::cerr << "--journal requires a path to the journal file." << std::endl;
+      print_usage();
+      return false;
+    }
+    journal_path = *journal_path_ptr;
+    if ( !do_evaluate )
+    {
+      std::cerr << "WARNING: --journal used when not evaluating.\n";
+    }
+  }
+  resume = parser->check_and_consume("--resume");
+  no_dedup = parser->check_and_consume("--no-dedup");
+  if ( parser->check("--durations") )
+  {
+    std::unique_ptr<std::string> durations_path_ptr = parser->get_value_and_consume("--durations");
+    if ( !durations_path_ptr )
+    {
+      std::cerr << "--durations requires a path to the durations file." << std::endl;
+      print_usage();
+      return false;
+    }
+    durations_path = *durations_path_ptr;
+  }
+  print_stats = parser->check_and_consume("--stats");
+  measure_footprint = parser->check_and_consume("--footprint");
+  measure_latency = parser->check_and_consume("--latency");
+  if ( parser->check("--trace-out") )
+  {
+    std::unique_ptr<std::string> trace_path_ptr = parser->get_value_and_consume("--trace-out");
+    if ( !trace_path_ptr )
+    {
+      std::cerr << "--trace-out requires a path to the trace file." << std::endl;
+      print_usage();
+      return false;
+    }
+    trace_path = *trace_path_ptr;
+  }
+  if ( parser->check("--metrics-file") )
+  {
+    std::unique_ptr<std::string> metrics_path_ptr = parser->get_value_and_consume("--metrics-file");
+    if ( !metrics_path_ptr )
+    {
+      std::cerr << "--metrics-file requires a path to the metrics file." << std::endl;
+      print_usage();
+      return false;
+    }
+    metrics_path = *metrics_path_ptr;
+  }
+  if ( parser->check("--budget") )
+  {
+    std::unique_ptr<std::string> budget_ptr = parser->get_value_and_consume("--budget");
+    if ( !budget_ptr || !is_number(*budget_ptr) || std::stoll(*budget_ptr) < 1 )
+    {
+      std::cerr << "--budget requires a positive number of seconds." << std::endl;
+      print_usage();
+      return false;
+    }
+    budget_seconds = static_cast<size_t>(std::stoll(*budget_ptr));
+    if ( !journal_path.empty() || !results_path.empty() )
+    {
+      // the sample depends on the recorded durations, and partial results cannot be extrapolated once merged
+      std::cerr << "--budget cannot be combined with --journal or --save-results." << std::endl;
+      print_usage();
+      return false;
+    }
+  }
+  if ( parser->check("--coordinate") )
+  {
+    std::unique_ptr<std::string> coordinator_address_ptr = parser->get_value_and_consume("--coordinate");
+    if ( !coordinator_address_ptr )
+    {
+      std::cerr << "--coordinate requires an address to listen on." << std::endl;
+      print_usage();
+      return false;
+    }
+    coordinator_address = *coordinator_address_ptr;
+  }
+  if ( parser->check("--worker") )
+  {
+    std::unique_ptr<std::string> worker_address_ptr = parser->get_value_and_consume("--worker");
+    if ( !worker_address_ptr )
+    {
+      std::cerr << "--worker requires the address of the coordinator." << std::endl;
+      print_usage();
+      return false;
+    }
+    worker_address = *worker_address_ptr;
+  }
+  if ( !coordinator_address.empty() || !worker_address.empty() )
+  {
+    if ( !coordinator_address.empty() && !worker_address.empty() )
+    {
+      std::cerr << "--coordinate cannot be used with --worker." << std::endl;
+      return false;
+    }
+    if ( budget_seconds != 0 )
+    {
+      std::cerr << "--budget cannot be combined with --coordinate or --worker." << std::endl;
+      return false;
+    }
+    if ( measure_footprint )
+    {
+      // the binaries are only built by the workers
+      std::cerr << "--footprint cannot be combined with --coordinate or --worker." << std::endl;
+      return false;
+    }
+    if ( measure_latency )
+    {
+      // the latencies are only measured by the workers
+      std::cerr << "--latency cannot be combined with --coordinate or --worker." << std::endl;
+      return false;
+    }
+    if ( !worker_address.empty() && (!journal_path.empty() || !results_path.empty() || !export_path.empty()) )
+    {
+      // the results are reported by the coordinator
+      std::cerr << "--worker cannot be combined with --journal, --save-results or --export." << std::endl;
+      return false;
+    }
+  }
+  if ( resume && journal_path.empty() )
+  {
+    std::cerr << "--resume requires --journal." << std::endl;
+    print_usage();
+    return false;
+  }
   if ( do_evaluate )
   {
     if ( do_compile )
@@ -132,7 +514,13 @@ static bool parse_arguments(int argc, char **argv)
       print_usage();
       return false;
     }
-    sanitizer_config_path = *sanitizer_config_path_ptr;
+    sanitizer_config_paths = split_list(*sanitizer_config_path_ptr);
+    if ( sanitizer_config_paths.empty() )
+    {
+      std::cerr << "--evaluate requires a path to the sanitizer configuration file." << std::endl;
+      print_usage();
+      return false;
+    }
   }
   else
   {
@@ -154,6 +542,54 @@ static bool parse_arguments(int argc, char **argv)
       {
         std::cerr << "WARNING: --keep-binaries used when not evaluating.\n";
       }
+      if ( in_memory && !do_compile )
+      {
+        std::cerr << "WARNING: --in-memory used when not evaluating or compiling.\n";
+      }
+      if ( jobs != 0 )
+      {
+        std::cerr << "WARNING: --jobs used when not evaluating.\n";
+      }
+      if ( speculation != 1 )
+      {
+        std::cerr << "WARNING: --speculate used when not evaluating.\n";
+      }
+      if ( no_dedup )
+      {
+        std::cerr << "WARNING: --no-dedup used when not evaluating.\n";
+      }
+      if ( !durations_path.empty() )
+      {
+        std::cerr << "WARNING: --durations used when not evaluating.\n";
+      }
+      if ( budget_seconds != 0 )
+      {
+        std::cerr << "WARNING: --budget used when not evaluating.\n";
+      }
+      if ( print_stats )
+      {
+        std::cerr << "WARNING: --stats used when not evaluating.\n";
+      }
+      if ( measure_footprint )
+      {
+        std::cerr << "WARNING: --footprint used when not evaluating.\n";
+      }
+      if ( measure_latency )
+      {
+        std::cerr << "WARNING: --latency used when not evaluating.\n";
+      }
+      if ( !metrics_path.empty() )
+      {
+        std::cerr << "WARNING: --metrics-file used when not evaluating.\n";
+      }
+      if ( !coordinator_address.empty() )
+      {
+        std::cerr << "WARNING: --coordinate used when not evaluating.\n";
+      }
+      if ( !worker_address.empty() )
+      {
+        std::cerr << "WARNING: --worker used when not evaluating.\n";
+      }
     }
     else
     {
@@ -161,6 +597,58 @@ static bool parse_arguments(int argc, char **argv)
       {
         std::cerr << "WARNING: --keep-binaries ignores when evaluating prebuilt binaries.\n";
       }
+      if ( !packed_suite_path.empty() )
+      {
+        std::cerr << "WARNING: --packed-suite ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( in_memory )
+      {
+        std::cerr << "WARNING: --in-memory ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( jobs != 0 )
+      {
+        std::cerr << "WARNING: --jobs ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( speculation != 1 )
+      {
+        std::cerr << "WARNING: --speculate ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( no_dedup )
+      {
+        std::cerr << "WARNING: --no-dedup ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( !durations_path.empty() )
+      {
+        std::cerr << "WARNING: --durations ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( budget_seconds != 0 )
+      {
+        std::cerr << "WARNING: --budget ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( print_stats )
+      {
+        std::cerr << "WARNING: --stats ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( measure_footprint )
+      {
+        std::cerr << "WARNING: --footprint ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( measure_latency )
+      {
+        std::cerr << "WARNING: --latency ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( !metrics_path.empty() )
+      {
+        std::cerr << "WARNING: --metrics-file ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( !coordinator_address.empty() )
+      {
+        std::cerr << "WARNING: --coordinate ignored when evaluating prebuilt binaries.\n";
+      }
+      if ( !worker_address.empty() )
+      {
+        std::cerr << "WARNING: --worker ignored when evaluating prebuilt binaries.\n";
+      }
     }
   }
 
@@ -170,6 +658,14 @@ static bool parse_arguments(int argc, char **argv)
     {
       std::cerr << "WARNING: --clean-test-cases used when not generating (--generate).\n";
     }
+    if ( compact )
+    {
+      std::cerr << "WARNING: --compact used when not generating (--generate).\n";
+    }
+    if ( !generation_profile_path.empty() )
+    {
+      std::cerr << "WARNING: --generation-profile used when not generating (--generate).\n";
+    }
   }
 
   if ( do_compile )
@@ -186,7 +682,7 @@ static bool parse_arguments(int argc, char **argv)
       std::cerr << "--compile cannot be used with --evaluate-prebuilt-binaries." << std::endl;
       return false;
     }
-    sanitizer_config_path = *sanitizer_config_path_ptr;
+    sanitizer_config_paths.push_back(*sanitizer_config_path_ptr);
   }
 
   if ( do_evaluate_prebuilt )
@@ -198,7 +694,7 @@ static bool parse_arguments(int argc, char **argv)
       print_usage();
       return false;
     }
-    sanitizer_config_path = *sanitizer_config_path_ptr;
+    sanitizer_config_paths.push_back(*sanitizer_config_path_ptr);
   }
 
   if ( !parser->consumed_everything() )
@@ -214,13 +710,15 @@ static bool parse_arguments(int argc, char **argv)
   return true;
 }
 
-int main( int argc, char **argv )
+static std::string describe_test_case_source()
 {
-  if ( !parse_arguments( argc, argv ) )
-  {
-    return 1;
-  }
+  if ( do_generate && in_memory ) return "memory";
+  if ( !packed_suite_path.empty() ) return packed_suite_path;
+  return generated_path;
+}
 
+static int run()
+{
   if ( remove_dir )
   {
     if ( directory_exists( generated_path ) )
@@ -229,7 +727,38 @@ int main( int argc, char **argv )
     }
   }
 
-  if ( do_generate )
+  if ( !trace_path.empty() )
+  {
+    Trace::enable();
+  }
+
+  CodeCanvas::set_compact_emission( compact );
+
+  std::unique_ptr<GenerationProfile> generation_profile;
+  if ( do_generate && !generation_profile_path.empty() )
+  {
+    generation_profile.reset( new GenerationProfile( generation_profile_path ) );
+    if ( !compact && generation_profile->get_max_object_size() > 64 )
+    {
+      std::cerr << "WARNING: objects larger than 64 bytes are initialized one statement per byte; consider --compact.\n";
+    }
+  }
+
+  std::vector<GeneratedTestCase> generated_test_cases;
+  const bool generate_in_memory_only = do_generate && in_memory && ( do_evaluate || do_compile );
+  if ( generate_in_memory_only )
+  {
+    std::cout << "Generating test cases in memory" << std::endl;
+    TraceSpan span( "generate" );
+    generated_test_cases = generate_in_memory( selector.get(), generation_profile.get() );
+  }
+  else if ( do_generate && !packed_suite_path.empty() )
+  {
+    std::cout << "Generating packed test suite: '" << packed_suite_path << "'" << std::endl;
+    TraceSpan span( "generate" );
+    generate( generated_path, packed_suite_path, selector.get(), generation_profile.get() );
+  }
+  else if ( do_generate )
   {
     if ( directory_exists( generated_path ) )
     {
@@ -244,10 +773,15 @@ int main( int argc, char **argv )
       create_directory( generated_path );
     }
     std::cout << "Generating test cases in: '" << generated_path << "'" << std::endl;
-    generate( generated_path );
+    TraceSpan span( "generate" );
+    generate( generated_path, "", selector.get(), generation_profile.get() );
   }
 
-  if ( do_compile || do_evaluate || do_evaluate_prebuilt )
+  if ( ( do_compile || do_evaluate ) && ( generate_in_memory_only || !packed_suite_path.empty() ) )
+  {
+    create_directory( generated_path ); // only holds the binaries
+  }
+  else if ( do_compile || do_evaluate || do_evaluate_prebuilt )
   {
     if ( !directory_exists( generated_path ) )
     {
@@ -261,16 +795,60 @@ int main( int argc, char **argv )
     }
   }
 
+  EvaluationOptions options;
+  options.test_cases_dir_path = generated_path;
+  options.sanitizer_configs = sanitizer_config_paths;
+  options.packed_suite_path = packed_suite_path;
+  options.print_table_summary = print_table_summary;
+  options.run_all_variants = run_all_variants;
+  options.verbose = verbose;
+  options.json_log = json_log;
+  options.compute_baseline = evaluate_baseline;
+  options.keep_binaries = keep_binaries;
+  options.in_memory = in_memory;
+  if ( jobs != 0 )
+  {
+    options.jobs = jobs;
+  }
+  else
+  {
+    // one test case at a time as before, unless the sanitizers are compared on a shared scheduler
+    options.jobs = sanitizer_config_paths.size() > 1 ? Scheduler::get_default_thread_count() : 1;
+  }
+  options.speculation = speculation;
+  options.shard_index = shard_index;
+  options.shard_count = shard_count;
+  options.results_path = results_path;
+  options.partial_results_paths = partial_results_paths;
+  options.export_path = export_path;
+  options.journal_path = journal_path;
+  options.resume = resume;
+  options.no_dedup = no_dedup;
+  options.measure_footprint = measure_footprint;
+  options.measure_latency = measure_latency;
+  options.durations_path = durations_path;
+  options.budget_seconds = budget_seconds;
+  options.print_stats = print_stats;
+  options.metrics_path = metrics_path;
+  options.keep_build_cache = is_daemon_job;
+  options.coordinator_address = coordinator_address;
+  options.worker_address = worker_address;
+  options.selector = selector.get();
+  if ( generate_in_memory_only )
+  {
+    options.generated_test_cases = &generated_test_cases;
+  }
+
   std::string test_case_binaries_path = generated_path + "/" + TEST_CASE_BINARIES_DIR_NAME;
   bool test_cases_binaries_dir_exists = directory_exists( test_case_binaries_path );
   if ( do_compile )
   {
-    std::cout << "Compiling test cases from: '" << generated_path << "'" << std::endl;
+    std::cout << "Compiling test cases from: '" << describe_test_case_source() << "'" << std::endl;
     if ( !test_cases_binaries_dir_exists )
     {
       create_directory( test_case_binaries_path );
     }
-    compile_all( generated_path, sanitizer_config_path, verbose );
+    compile_all( options );
   }
   else if ( do_evaluate_prebuilt )
   {
@@ -280,7 +858,7 @@ int main( int argc, char **argv )
       return 1;
     }
     std::cout << "Evaluating pre-built binaries from: '" << generated_path << "'" << std::endl;
-    evaluate_prebuilt_binaries( generated_path, sanitizer_config_path, print_table_summary, run_all_variants, verbose, evaluate_baseline );
+    evaluate_prebuilt_binaries( options );
   }
   else if ( do_evaluate )
   {
@@ -288,9 +866,133 @@ int main( int argc, char **argv )
     {
       create_directory( test_case_binaries_path );
     }
-    std::cout << "Evaluating test cases from: '" << generated_path << "'" << std::endl;
-    compile_and_evaluate( generated_path, sanitizer_config_path, print_table_summary, run_all_variants, verbose, evaluate_baseline, keep_binaries );
+    if ( !worker_address.empty() )
+    {
+      std::cout << "Evaluating test cases from: '" << describe_test_case_source() << "' for " << worker_address << std::endl;
+      run_worker( options );
+    }
+    else
+    {
+      std::cout << "Evaluating test cases from: '" << describe_test_case_source() << "'" << std::endl;
+      compile_and_evaluate( options );
+    }
+  }
+  else if ( do_merge )
+  {
+    merge_results( options );
+  }
+
+  if ( !trace_path.empty() && !Trace::write( trace_path ) )
+  {
+    std::cerr << "WARNING: Could not write the trace to " << trace_path << ".\n";
   }
 
   return 0;
 }
+
+/**
+ * Restores the defaults of the arguments, which a job of the daemon would otherwise inherit from the daemon.
+ */
+static void reset_arguments()
+{
+  generated_path.clear();
+  do_evaluate = false;
+  do_evaluate_prebuilt = false;
+  do_generate = false;
+  do_compile = false;
+  do_merge = false;
+  remove_dir = false;
+  print_table_summary = false;
+  verbose = false;
+  json_log = false;
+  evaluate_baseline = false;
+  run_all_variants = false;
+  keep_binaries = false;
+  in_memory = false;
+  compact = false;
+  sanitizer_config_paths.clear();
+  jobs = 0;
+  speculation = 1;
+  shard_index = 0;
+  shard_count = 1;
+  results_path.clear();
+  partial_results_paths.clear();
+  export_path.clear();
+  journal_path.clear();
+  resume = false;
+  no_dedup = false;
+  measure_footprint = false;
+  measure_latency = false;
+  durations_path.clear();
+  budget_seconds = 0;
+  print_stats = false;
+  metrics_path.clear();
+  trace_path.clear();
+  serve_socket_path.clear();
+  coordinator_address.clear();
+  worker_address.clear();
+  packed_suite_path.clear();
+  generation_profile_path.clear();
+  selector.reset();
+}
+
+static int run_job( const std::vector<std::string> &args )
+{
+  reset_arguments();
+  std::string program_name = "mset";
+  std::vector<char *> argv{ &program_name[0] };
+  for ( const std::string &arg: args )
+  {
+    argv.push_back( const_cast<char *>( arg.c_str() ) );
+  }
+  argv.push_back( nullptr );
+  if ( !parse_arguments( static_cast<int>( argv.size() - 1 ), argv.data() ) )
+  {
+    return 1;
+  }
+  return run();
+}
+
+static int serve_jobs()
+{
+  EvaluationOptions options;
+  options.test_cases_dir_path = generated_path;
+  options.sanitizer_configs = sanitizer_config_paths;
+  options.packed_suite_path = packed_suite_path;
+  const std::string test_case_binaries_path = generated_path + "/" + TEST_CASE_BINARIES_DIR_NAME;
+  if ( packed_suite_path.empty() && directory_exists( generated_path ) && !directory_exists( test_case_binaries_path ) )
+  {
+    // otherwise created by the first job, which would change the test case directory loaded here
+    create_directory( test_case_binaries_path );
+  }
+  const std::string loaded = preload( options );
+  std::cout << loaded;
+  is_daemon_job = true; // in the processes forked for the jobs
+  return serve( serve_socket_path, loaded, run_job );
+}
+
+int main( int argc, char **argv )
+{
+  for ( int i = 1; i < argc; i++ )
+  {
+    if ( std::string( argv[i] ) != "--connect" ) continue;
+    if ( i + 1 == argc )
+    {
+      std::cerr << "--connect requires a path to the socket of the daemon." << std::endl;
+      return 1;
+    }
+    std::vector<std::string> args( argv + 1, argv + i );
+    args.insert( args.end(), argv + i + 2, argv + argc );
+    return run_remotely( argv[i + 1], args );
+  }
+
+  if ( !parse_arguments( argc, argv ) )
+  {
+    return 1;
+  }
+  if ( !serve_socket_path.empty() )
+  {
+    return serve_jobs();
+  }
+  return run();
+}
@@ -6,6 +6,7 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -27,16 +28,15 @@ inline bool is_number(const std::string& s)
   }
 }
 
-template <typename T, typename U>
-bool is_a(const std::shared_ptr<U>& ptr)
+inline uint64_t fnv1a_64(const char *data, size_t length)
 {
-  return std::dynamic_pointer_cast<T>(ptr) != nullptr;
-}
-
-template <typename T, typename U>
-bool are_the_same_type(const std::shared_ptr<T>& a, const std::shared_ptr<U>& b)
-{
-  return a && b && typeid(*a) == typeid(*b);
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
 }
 
 extern bool directory_exists(const std::string& dir_path);
@@ -0,0 +1,170 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "packed_suite.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>    // open
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+#include "misc.h"
+#include "evaluator/test_case_information.h"
+
+bool PackedSuiteWriter::add(const std::string &name, const std::string &source)
+{
+  std::shared_ptr<TestCaseInformation> test_case_information = TestCaseInformation::construct_from_file_name(name, "", /*is_binary=*/true);
+  if ( !test_case_information || test_case_information->get_origin_size() > UINT32_MAX || test_case_information->get_target_size() > UINT32_MAX )
+  {
+    return false;
+  }
+
+  PackedSuiteEntry entry{};
+  entry.source_offset = sources.size();
+  entry.source_length = source.size();
+  entry.source_hash = fnv1a_64(source.data(), source.size());
+  entry.name_offset = static_cast<uint32_t>(names.size());
+  entry.name_length = static_cast<uint16_t>(name.size());
+  entry.variant_number = static_cast<uint16_t>(test_case_information->get_variant_number());
+  const std::vector<uint8_t> &dimension_ids = test_case_information->get_dimension_ids();
+  entry.dimension_count = static_cast<uint8_t>(dimension_ids.size());
+  std::copy(dimension_ids.begin(), dimension_ids.end(), entry.dimension_ids);
+  entry.is_validation = test_case_information->get_is_validation();
+  entry.origin_size = static_cast<uint32_t>(test_case_information->get_origin_size());
+  entry.target_size = static_cast<uint32_t>(test_case_information->get_target_size());
+
+  entries.push_back(entry);
+  names += name;
+  sources += source;
+  return true;
+}
+
+bool PackedSuiteWriter::write(const std::string &path) const
+{
+  PackedSuiteHeader header{};
+  std::memcpy(header.magic, PACKED_SUITE_MAGIC, sizeof(header.magic));
+  header.version = PACKED_SUITE_VERSION;
+  header.entry_count = static_cast<uint32_t>(entries.size());
+  header.index_offset = sizeof(PackedSuiteHeader);
+  header.names_offset = header.index_offset + entries.size() * sizeof(PackedSuiteEntry);
+  header.sources_offset = header.names_offset + names.size();
+  header.file_size = header.sources_offset + sources.size();
+
+  std::vector<PackedSuiteEntry> relocated_entries = entries;
+  for ( auto &entry: relocated_entries )
+  {
+    entry.name_offset += static_cast<uint32_t>(header.names_offset);
+    entry.source_offset += header.sources_offset;
+  }
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if ( !file )
+  {
+    std::cerr << "Error opening file: " << path << ": " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char *>(relocated_entries.data()), relocated_entries.size() * sizeof(PackedSuiteEntry));
+  file.write(names.data(), names.size());
+  file.write(sources.data(), sources.size());
+  if ( !file )
+  {
+    std::cerr << "Error writing file: " << path << ": " << std::strerror(errno) << std::endl;
+    return false;
+  }
+  return true;
+}
+
+PackedSuite::PackedSuite(const char *data, size_t size):
+  data(data),
+  data_size(size),
+  header(reinterpret_cast<const PackedSuiteHeader *>(data)),
+  entries(reinterpret_cast<const PackedSuiteEntry *>(data + header->index_offset))
+{
+}
+
+PackedSuite::~PackedSuite()
+{
+  munmap(const_cast<char *>(data), data_size);
+}
+
+std::unique_ptr<PackedSuite> PackedSuite::open(const std::string &path)
+{
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if ( fd == -1 )
+  {
+    std::cerr << "Error opening packed suite " << path << ": " << std::strerror(errno) << '\n';
+    return nullptr;
+  }
+  struct stat file_stat{};
+  if ( fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(PackedSuiteHeader) )
+  {
+    std::cerr << "Invalid packed suite " << path << ": file too small.\n";
+    close(fd);
+    return nullptr;
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( mapping == MAP_FAILED )
+  {
+    std::cerr << "Error mapping packed suite " << path << ": " << std::strerror(errno) << '\n';
+    return nullptr;
+  }
+
+  std::unique_ptr<PackedSuite> suite(new PackedSuite(static_cast<const char *>(mapping), size));
+  const PackedSuiteHeader *header = suite->header;
+  if ( std::memcmp(header->magic, PACKED_SUITE_MAGIC, sizeof(header->magic)) != 0 || header->version != PACKED_SUITE_VERSION )
+  {
+    std::cerr << "Invalid packed suite " << path << ": unknown format or version.\n";
+    return nullptr;
+  }
+  // the offsets come from the file, so they are compared without sums that could overflow
+  if ( header->file_size != size
+    || header->sources_offset > size
+    || header->names_offset > header->sources_offset
+    || header->index_offset > header->names_offset
+    || (header->names_offset - header->index_offset) / sizeof(PackedSuiteEntry) < header->entry_count )
+  {
+    std::cerr << "Invalid packed suite " << path << ": corrupted header.\n";
+    return nullptr;
+  }
+  for ( size_t i = 0; i < suite->size(); i++ )
+  {
+    const PackedSuiteEntry &entry = suite->entry(i);
+    if ( entry.name_offset > header->sources_offset
+      || entry.name_length > header->sources_offset - entry.name_offset
+      || entry.source_offset < header->sources_offset
+      || entry.source_offset > size
+      || entry.source_length > size - entry.source_offset
+      || entry.dimension_count > sizeof(entry.dimension_ids) )
+    {
+      std::cerr << "Invalid packed suite " << path << ": corrupted index entry " << i << ".\n";
+      return nullptr;
+    }
+  }
+  return suite;
+}
+
+std::string PackedSuite::name(size_t index) const
+{
+  return std::string(data + entries[index].name_offset, entries[index].name_length);
+}
+
+const char *PackedSuite::source(size_t index) const
+{
+  return data + entries[index].source_offset;
+}
+
+bool PackedSuite::verify(size_t index) const
+{
+  return fnv1a_64(source(index), entries[index].source_length) == entries[index].source_hash;
+}
@@ -0,0 +1,90 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * A packed suite holds the sources of all test cases in a single file, preceded by an index.
+ *
+ * Layout: header | index entries | names | sources
+ * All offsets are absolute file offsets. The file is read through mmap, so the evaluator can
+ * iterate over the index without parsing file names or touching the file system per test case.
+ */
+struct PackedSuiteHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_count;
+  uint64_t index_offset;
+  uint64_t names_offset;
+  uint64_t sources_offset;
+  uint64_t file_size;
+};
+
+struct PackedSuiteEntry
+{
+  uint64_t source_offset;
+  uint64_t source_length;
+  uint64_t source_hash;     // FNV-1a of the source
+  uint32_t name_offset;     // test case name, i.e., file name without ".c"
+  uint16_t name_length;
+  uint16_t variant_number;
+  uint8_t dimension_count;  // TestCaseInformation::TEMPORAL_DIMENSIONS or SPATIAL_DIMENSIONS
+  uint8_t dimension_ids[7]; // see TestCaseInformation::get_dimension_ids()
+  uint8_t is_validation;
+  uint8_t reserved[7];
+  uint32_t origin_size;     // spatial test cases only, see TestCaseInformation::get_origin_size()
+  uint32_t target_size;
+};
+
+const char PACKED_SUITE_MAGIC[8] = {'M', 'S', 'E', 'T', 'P', 'A', 'C', 'K'};
+const uint32_t PACKED_SUITE_VERSION = 2;
+
+class PackedSuiteWriter
+{
+public:
+  /**
+   * Adds a test case. The dimensions are derived from the name, which must follow the test case file name grammar.
+   * Returns false if the name is not a valid test case name, or its object sizes do not fit the index.
+   */
+  bool add(const std::string &name, const std::string &source);
+  bool write(const std::string &path) const;
+  size_t size() const { return entries.size(); }
+
+private:
+  std::vector<PackedSuiteEntry> entries;
+  std::string names;
+  std::string sources;
+};
+
+class PackedSuite
+{
+public:
+  ~PackedSuite();
+  PackedSuite(const PackedSuite &) = delete;
+  PackedSuite &operator=(const PackedSuite &) = delete;
+
+  static std::unique_ptr<PackedSuite> open(const std::string &path);
+
+  size_t size() const { return header->entry_count; }
+  const PackedSuiteEntry &entry(size_t index) const { return entries[index]; }
+  std::string name(size_t index) const;
+  const char *source(size_t index) const;
+  bool verify(size_t index) const;
+
+private:
+  PackedSuite(const char *data, size_t size);
+
+  const char *data;
+  size_t data_size;
+  const PackedSuiteHeader *header;
+  const PackedSuiteEntry *entries;
+};
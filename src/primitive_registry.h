@@ -0,0 +1,151 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Registry of the primitives of each test case dimension, shared by the generator and the evaluator.
+ *
+ * Every dimension has an enum of dense IDs and a table of names indexed by them. The IDs are the dimension IDs of
+ * TestCaseInformation::get_dimension_ids() and test case IDs, packed suites and stored results depend on them, so new
+ * primitives are appended. The generator enumerates the primitives of a dimension in ID order.
+ * Adding a primitive takes a new ID and names here, and the class implementing it registered in primitive_pool.cpp.
+ */
+
+struct PrimitiveNames
+{
+  const char *name;           // used in file names and test case queries, e.g., "heap"
+  const char *printable_name; // used in results, e.g., "Heap"
+};
+
+/**
+ * The names of all primitives of one dimension, indexed by ID.
+ */
+class PrimitiveDimension
+{
+public:
+  template <size_t N>
+  constexpr PrimitiveDimension(const PrimitiveNames (&names)[N]):
+    names(names), count(N)
+  {
+  }
+
+  constexpr size_t size() const { return count; }
+  constexpr const PrimitiveNames &operator[](size_t id) const { return names[id]; }
+  constexpr const PrimitiveNames *begin() const { return names; }
+  constexpr const PrimitiveNames *end() const { return names + count; }
+
+  /**
+   * ID of the primitive called name, or -1 if there is none.
+   */
+  int find(const std::string &name) const
+  {
+    for ( size_t i = 0; i < count; i++ )
+    {
+      if ( name == names[i].name )
+      {
+        return static_cast<int>(i);
+      }
+    }
+    return -1;
+  }
+
+private:
+  const PrimitiveNames *names;
+  size_t count;
+};
+
+
+enum class region_id_t: uint8_t { HEAP, STACK, GLOBAL, COUNT };
+constexpr PrimitiveNames REGIONS[] = {
+  {"heap", "Heap"},
+  {"stack", "Stack"},
+  {"global", "Global"}
+};
+
+enum class temporal_bug_id_t: uint8_t { MISUSE_OF_FREE, DOUBLE_FREE, USE_AFTER_STAR, COUNT };
+constexpr PrimitiveNames TEMPORAL_BUG_TYPES[] = {
+  {"misuse_of_free", "Misuse-of-free"},
+  {"double_free", "Double-free"},
+  {"use_after_star", "Use-after-*"}
+};
+
+enum class memory_state_id_t: uint8_t { USED_MEMORY, FREED_MEMORY, COUNT };
+constexpr PrimitiveNames MEMORY_STATES[] = {
+  {"used_memory", "(Re)used Memory"},
+  {"freed_memory", "Freed Memory"}
+};
+
+enum class spatial_bug_id_t: uint8_t { LINEAR_OOBA, NON_LINEAR_OOBA, TYPE_CONFUSION_OOBA, COUNT };
+constexpr PrimitiveNames SPATIAL_BUG_TYPES[] = {
+  {"linear_ooba", "Linear OOBA"},
+  {"non_linear_ooba", "Non-Linear OOBA"},
+  {"type_confusion_ooba", "Type Confusion OOBA"}
+};
+
+enum class origin_target_relation_id_t: uint8_t { NON_OBJECT, INTRA_OBJECT, INTER_OBJECT, COUNT };
+constexpr PrimitiveNames ORIGIN_TARGET_RELATIONS[] = {
+  {"non_object", "Non-Object"},
+  {"intra_object", "Intra-Object"},
+  {"inter_object", "Inter-Object"}
+};
+
+// suffixed, since the math.h of older glibc versions defines OVERFLOW and UNDERFLOW
+enum class flow_id_t: uint8_t { OVERFLOW_FLOW, UNDERFLOW_FLOW, COUNT };
+constexpr PrimitiveNames FLOWS[] = {
+  {"overflow", "Overflow"},
+  {"underflow", "Underflow"}
+};
+
+enum class access_location_id_t: uint8_t { STDLIB, DIRECT, COUNT };
+constexpr PrimitiveNames ACCESS_LOCATIONS[] = {
+  {"stdlib", "Stdlib"},
+  {"direct", "Direct"}
+};
+
+enum class access_action_id_t: uint8_t { READ, WRITE, COUNT };
+constexpr PrimitiveNames ACCESS_ACTIONS[] = {
+  {"read", "Read"},
+  {"write", "Write"}
+};
+
+constexpr PrimitiveDimension get_dimension(region_id_t) { return REGIONS; }
+constexpr PrimitiveDimension get_dimension(temporal_bug_id_t) { return TEMPORAL_BUG_TYPES; }
+constexpr PrimitiveDimension get_dimension(memory_state_id_t) { return MEMORY_STATES; }
+constexpr PrimitiveDimension get_dimension(spatial_bug_id_t) { return SPATIAL_BUG_TYPES; }
+constexpr PrimitiveDimension get_dimension(origin_target_relation_id_t) { return ORIGIN_TARGET_RELATIONS; }
+constexpr PrimitiveDimension get_dimension(flow_id_t) { return FLOWS; }
+constexpr PrimitiveDimension get_dimension(access_location_id_t) { return ACCESS_LOCATIONS; }
+constexpr PrimitiveDimension get_dimension(access_action_id_t) { return ACCESS_ACTIONS; }
+
+template <typename Id>
+constexpr const PrimitiveNames &get_primitive_names(Id id)
+{
+  return get_dimension(id)[static_cast<size_t>(id)];
+}
+
+static_assert(get_dimension(region_id_t::COUNT).size() == static_cast<size_t>(region_id_t::COUNT), "REGIONS does not match region_id_t");
+static_assert(get_dimension(temporal_bug_id_t::COUNT).size() == static_cast<size_t>(temporal_bug_id_t::COUNT), "TEMPORAL_BUG_TYPES does not match temporal_bug_id_t");
+static_assert(get_dimension(memory_state_id_t::COUNT).size() == static_cast<size_t>(memory_state_id_t::COUNT), "MEMORY_STATES does not match memory_state_id_t");
+static_assert(get_dimension(spatial_bug_id_t::COUNT).size() == static_cast<size_t>(spatial_bug_id_t::COUNT), "SPATIAL_BUG_TYPES does not match spatial_bug_id_t");
+static_assert(get_dimension(origin_target_relation_id_t::COUNT).size() == static_cast<size_t>(origin_target_relation_id_t::COUNT), "ORIGIN_TARGET_RELATIONS does not match origin_target_relation_id_t");
+static_assert(get_dimension(flow_id_t::COUNT).size() == static_cast<size_t>(flow_id_t::COUNT), "FLOWS does not match flow_id_t");
+static_assert(get_dimension(access_location_id_t::COUNT).size() == static_cast<size_t>(access_location_id_t::COUNT), "ACCESS_LOCATIONS does not match access_location_id_t");
+static_assert(get_dimension(access_action_id_t::COUNT).size() == static_cast<size_t>(access_action_id_t::COUNT), "ACCESS_ACTIONS does not match access_action_id_t");
+
+// group IDs (see make_group_id()) and the result store keys pack each dimension ID into a nibble
+static_assert(static_cast<size_t>(region_id_t::COUNT) <= 16, "region_id_t does not fit into a nibble of the group IDs");
+static_assert(static_cast<size_t>(temporal_bug_id_t::COUNT) <= 16, "temporal_bug_id_t does not fit into a nibble of the group IDs");
+static_assert(static_cast<size_t>(memory_state_id_t::COUNT) <= 16, "memory_state_id_t does not fit into a nibble of the group IDs");
+static_assert(static_cast<size_t>(spatial_bug_id_t::COUNT) <= 16, "spatial_bug_id_t does not fit into a nibble of the group IDs");
+static_assert(static_cast<size_t>(origin_target_relation_id_t::COUNT) <= 16, "origin_target_relation_id_t does not fit into a nibble of the group IDs");
+static_assert(static_cast<size_t>(flow_id_t::COUNT) <= 16, "flow_id_t does not fit into a nibble of the group IDs");
+static_assert(static_cast<size_t>(access_location_id_t::COUNT) <= 16, "access_location_id_t does not fit into a nibble of the group IDs");
+static_assert(static_cast<size_t>(access_action_id_t::COUNT) <= 16, "access_action_id_t does not fit into a nibble of the group IDs");
@@ -0,0 +1,251 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "server.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// the request of a job is its working directory and its arguments, each terminated by a NUL; the response is the
+// output of the job, followed by a NUL and its exit status
+static const size_t MAX_REQUEST_SIZE = 1024 * 1024;
+
+static volatile sig_atomic_t stopping = 0;
+
+static void stop(int)
+{
+  stopping = 1;
+}
+
+static bool make_address(const std::string &socket_path, struct sockaddr_un &address)
+{
+  address = {};
+  address.sun_family = AF_UNIX;
+  if ( socket_path.size() >= sizeof(address.sun_path) )
+  {
+    std::cerr << "ERROR: The socket path " << socket_path << " is too long.\n";
+    return false;
+  }
+  std::strcpy(address.sun_path, socket_path.c_str());
+  return true;
+}
+
+static bool write_all(int fd, const char *data, size_t size)
+{
+  while ( size > 0 )
+  {
+    const ssize_t written = write(fd, data, size);
+    if ( written < 0 && errno == EINTR ) continue;
+    if ( written <= 0 ) return false;
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+static bool read_request(int connection, std::string &working_dir, std::vector<std::string> &args)
+{
+  std::string request;
+  char buffer[4096];
+  ssize_t length;
+  while ( (length = read(connection, buffer, sizeof(buffer))) != 0 )
+  {
+    if ( length < 0 && errno == EINTR ) continue;
+    if ( length < 0 || request.size() + static_cast<size_t>(length) > MAX_REQUEST_SIZE ) return false;
+    request.append(buffer, static_cast<size_t>(length));
+  }
+  if ( request.empty() || request.back() != '\0' ) return false;
+
+  for ( size_t begin = 0, end; (end = request.find('\0', begin)) != std::string::npos; begin = end + 1 )
+  {
+    args.push_back(request.substr(begin, end - begin));
+  }
+  working_dir = args.front();
+  args.erase(args.begin());
+  return true;
+}
+
+static int run_job_process(int listen_fd, int connection, const std::string &working_dir, const std::vector<std::string> &args,
+  const std::function<int(const std::vector<std::string> &)> &run_job)
+{
+  std::cout.flush(); // or the output of the daemon so far would be repeated by the job
+  pid_t pid = fork();
+  if ( pid == -1 )
+  {
+    perror("fork");
+    return EXIT_FAILURE;
+  }
+  if ( pid == 0 )
+  {
+    close(listen_fd);
+    signal(SIGPIPE, SIG_DFL);
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    dup2(connection, STDOUT_FILENO);
+    dup2(connection, STDERR_FILENO);
+    close(connection);
+    if ( chdir(working_dir.c_str()) != 0 )
+    {
+      std::cerr << "ERROR: Cannot change to the directory " << working_dir << ": " << strerror(errno) << "\n";
+      _exit(EXIT_FAILURE);
+    }
+    exit(run_job(args)); // runs the destructors, which flush the output of the job
+  }
+
+  int wstatus;
+  while ( waitpid(pid, &wstatus, 0) == -1 && errno == EINTR ) { }
+  if ( WIFSIGNALED(wstatus) ) return 128 + WTERMSIG(wstatus);
+  return WEXITSTATUS(wstatus);
+}
+
+extern int serve(const std::string &socket_path, const std::string &status_description,
+  const std::function<int(const std::vector<std::string> &)> &run_job)
+{
+  struct sockaddr_un address;
+  if ( !make_address(socket_path, address) ) return EXIT_FAILURE;
+
+  const int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if ( listen_fd == -1 )
+  {
+    perror("socket");
+    return EXIT_FAILURE;
+  }
+  struct stat socket_stat{};
+  if ( stat(socket_path.c_str(), &socket_stat) == 0 && S_ISSOCK(socket_stat.st_mode) )
+  {
+    if ( connect(listen_fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == 0 )
+    {
+      std::cerr << "ERROR: A daemon is already listening on " << socket_path << ". Aborting.\n";
+      return EXIT_FAILURE;
+    }
+    unlink(socket_path.c_str()); // left by a daemon that did not stop cleanly
+  }
+  if ( bind(listen_fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0 || listen(listen_fd, SOMAXCONN) != 0 )
+  {
+    std::cerr << "ERROR: Cannot listen on " << socket_path << ": " << strerror(errno) << ". Aborting.\n";
+    return EXIT_FAILURE;
+  }
+
+  // without SA_RESTART, so that accept() returns when the daemon is stopped
+  struct sigaction stop_action{};
+  stop_action.sa_handler = stop;
+  sigemptyset(&stop_action.sa_mask);
+  sigaction(SIGINT, &stop_action, nullptr);
+  sigaction(SIGTERM, &stop_action, nullptr);
+  signal(SIGPIPE, SIG_IGN); // a client may leave before its job is done
+
+  const auto start = std::chrono::steady_clock::now();
+  size_t served_jobs = 0;
+  std::cout << "Listening on " << socket_path << std::endl;
+  while ( !stopping )
+  {
+    const int connection = accept(listen_fd, nullptr, nullptr);
+    if ( connection == -1 )
+    {
+      if ( errno != EINTR ) perror("accept");
+      continue;
+    }
+
+    std::string working_dir;
+    std::vector<std::string> args;
+    int status = EXIT_FAILURE;
+    if ( !read_request(connection, working_dir, args) )
+    {
+      const std::string error = "ERROR: Invalid request.\n";
+      write_all(connection, error.data(), error.size());
+    }
+    else if ( args.empty() )
+    {
+      const long uptime = static_cast<long>(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      const std::string description = "Daemon " + std::to_string(getpid()) + " listening on " + socket_path + " for "
+        + std::to_string(uptime) + "s, " + std::to_string(served_jobs) + " jobs served.\n" + status_description;
+      write_all(connection, description.data(), description.size());
+      status = EXIT_SUCCESS;
+    }
+    else
+    {
+      status = run_job_process(listen_fd, connection, working_dir, args, run_job);
+      served_jobs++;
+    }
+    const std::string trailer = std::string(1, '\0') + std::to_string(status) + "\n";
+    write_all(connection, trailer.data(), trailer.size());
+    close(connection);
+  }
+
+  close(listen_fd);
+  unlink(socket_path.c_str());
+  std::cout << "Stopped after " << served_jobs << " jobs." << std::endl;
+  return EXIT_SUCCESS;
+}
+
+extern int run_remotely(const std::string &socket_path, const std::vector<std::string> &args)
+{
+  struct sockaddr_un address;
+  if ( !make_address(socket_path, address) ) return EXIT_FAILURE;
+  const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if ( fd == -1 || connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) != 0 )
+  {
+    std::cerr << "ERROR: No daemon listening on " << socket_path << ": " << strerror(errno) << "\n";
+    return EXIT_FAILURE;
+  }
+
+  char working_dir[PATH_MAX];
+  if ( !getcwd(working_dir, sizeof(working_dir)) )
+  {
+    perror("getcwd");
+    return EXIT_FAILURE;
+  }
+  std::string request = std::string(working_dir) + '\0';
+  for ( const std::string &arg: args )
+  {
+    request += arg + '\0';
+  }
+  if ( !write_all(fd, request.data(), request.size()) || shutdown(fd, SHUT_WR) != 0 )
+  {
+    std::cerr << "ERROR: Cannot send the job to " << socket_path << ": " << strerror(errno) << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // the output is copied as it arrives, until the NUL preceding the exit status
+  std::string status;
+  bool in_status = false;
+  char buffer[4096];
+  ssize_t length;
+  while ( (length = read(fd, buffer, sizeof(buffer))) != 0 )
+  {
+    if ( length < 0 && errno == EINTR ) continue;
+    if ( length < 0 ) break;
+    const char *end = buffer + length;
+    const char *output_end = in_status ? buffer : std::find(static_cast<const char *>(buffer), end, '\0');
+    std::cout.write(buffer, output_end - buffer);
+    std::cout.flush();
+    if ( output_end != end )
+    {
+      status.append(output_end + (in_status ? 0 : 1), end);
+      in_status = true;
+    }
+  }
+  close(fd);
+  if ( !in_status || status.empty() || !std::isdigit(static_cast<unsigned char>(status[0])) )
+  {
+    std::cerr << "ERROR: The daemon closed the connection before the job ended.\n";
+    return EXIT_FAILURE;
+  }
+  return std::atoi(status.c_str());
+}
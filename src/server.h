@@ -0,0 +1,28 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Runs as a daemon accepting jobs, i.e., mset command lines, on the Unix socket at socket_path until terminated, see
+ * --serve. Each job runs in a process forked from the daemon, so that it starts with everything the daemon loaded and
+ * whatever it fails on only ends the job; run_job runs the command line given without the program name, with its
+ * output sent to the client, and returns the exit status. Jobs run one at a time, in the order they connect. A
+ * connection without a command line queries the status of the daemon, which ends with status_description.
+ * Returns the exit status of the daemon.
+ */
+extern int serve(const std::string &socket_path, const std::string &status_description,
+  const std::function<int(const std::vector<std::string> &)> &run_job);
+
+/**
+ * Runs the command line args as a job of the daemon listening on socket_path, in the current working directory, and
+ * copies its output to std::cout while it runs, see --connect. Returns the exit status of the job.
+ */
+extern int run_remotely(const std::string &socket_path, const std::vector<std::string> &args);
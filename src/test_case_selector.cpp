@@ -0,0 +1,289 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "test_case_selector.h"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+
+#include "misc.h"
+#include "evaluator/test_case_information.h"
+
+uint32_t make_group_id(const std::vector<uint8_t> &dimension_ids)
+{
+  uint32_t group_id = dimension_ids.size() == TestCaseInformation::SPATIAL_DIMENSIONS ? 0x10000000 : 0;
+  for ( size_t i = 0; i < dimension_ids.size(); i++ )
+  {
+    const size_t shift = 4 * (dimension_ids.size() - 1 - i);
+    group_id |= static_cast<uint32_t>(dimension_ids[i] & 0xF) << shift;
+  }
+  return group_id;
+}
+
+std::string group_id_to_string(uint32_t group_id)
+{
+  char buffer[9];
+  std::snprintf(buffer, sizeof(buffer), "%08x", group_id);
+  return buffer;
+}
+
+std::string make_test_case_group_id(const TestCaseInformation &test_case_information)
+{
+  std::string id = group_id_to_string(make_group_id(test_case_information.get_dimension_ids()));
+  if ( !test_case_information.has_default_object_sizes() )
+  {
+    id += "-" + test_case_information.get_object_sizes_name();
+  }
+  return id;
+}
+
+std::string make_test_case_id(const TestCaseInformation &test_case_information)
+{
+  return make_test_case_group_id(test_case_information) + ":" + (test_case_information.get_is_validation() ? "v" : "")
+    + std::to_string(test_case_information.get_variant_number());
+}
+
+bool is_in_shard(const TestCaseInformation &test_case_information, size_t shard_index, size_t shard_count)
+{
+  const std::string group_id = make_test_case_group_id(test_case_information);
+  return fnv1a_64(group_id.data(), group_id.size()) % shard_count == shard_index;
+}
+
+static bool parse_number(const std::string &in, int &out)
+{
+  if ( in.empty() || in.find_first_not_of("0123456789") != std::string::npos )
+  {
+    return false;
+  }
+  out = std::stoi(in);
+  return true;
+}
+
+// e.g., "4096x4096"
+static bool parse_object_sizes(const std::string &in, size_t &origin_size, size_t &target_size)
+{
+  const size_t separator = in.find('x');
+  int origin = 0;
+  int target = 0;
+  if ( separator == std::string::npos
+    || !parse_number(in.substr(0, separator), origin) || !parse_number(in.substr(separator + 1), target)
+    || origin == 0 || target == 0 )
+  {
+    return false;
+  }
+  origin_size = static_cast<size_t>(origin);
+  target_size = static_cast<size_t>(target);
+  return true;
+}
+
+static void invalid_query(const std::string &query, const std::string &reason)
+{
+  std::cerr << "Invalid test case query \'" << query << "\'. " << reason << std::endl;
+}
+
+std::unique_ptr<TestCaseSelector> TestCaseSelector::parse(const std::string &query)
+{
+  std::unique_ptr<TestCaseSelector> selector(new TestCaseSelector());
+
+  if ( query.find('=') == std::string::npos )
+  {
+    // group ID, optionally followed by the object sizes and the variant
+    const std::string group_and_sizes_part = query.substr(0, query.find(':'));
+    const std::string group_part = group_and_sizes_part.substr(0, group_and_sizes_part.find('-'));
+    if ( group_part.size() != 8 || group_part.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos )
+    {
+      invalid_query(query, "Expected an ID such as 10000001:3 or a dimension query such as bug=linear_ooba.");
+      return nullptr;
+    }
+    const uint32_t group_id = static_cast<uint32_t>(std::stoul(group_part, nullptr, 16));
+    selector->kind = static_cast<int>(group_id >> 28);
+    const size_t dimension_count = selector->kind == 0 ? TestCaseInformation::TEMPORAL_DIMENSIONS : TestCaseInformation::SPATIAL_DIMENSIONS;
+    if ( selector->kind > 1 || (selector->kind == 0 && (group_id >> (4 * dimension_count)) != 0) )
+    {
+      invalid_query(query, "Unknown test case kind.");
+      return nullptr;
+    }
+    std::vector<uint8_t> dimension_ids;
+    for ( size_t i = 0; i < dimension_count; i++ )
+    {
+      const size_t shift = 4 * (dimension_count - 1 - i);
+      dimension_ids.push_back(static_cast<uint8_t>((group_id >> shift) & 0xF));
+      selector->dimension_ids[i] = dimension_ids.back();
+    }
+    if ( !TestCaseInformation::construct_from_dimension_ids(dimension_ids, false, 0, "") )
+    {
+      invalid_query(query, "Dimension out of range.");
+      return nullptr;
+    }
+
+    selector->origin_size = TestCaseInformation::DEFAULT_OBJECT_SIZE;
+    selector->target_size = TestCaseInformation::DEFAULT_OBJECT_SIZE;
+    if ( group_part.size() < group_and_sizes_part.size()
+      && ( selector->kind != 1 || !parse_object_sizes(group_and_sizes_part.substr(group_part.size() + 1), selector->origin_size, selector->target_size) ) )
+    {
+      invalid_query(query, "Expected object sizes such as 4096x4096 after '-'.");
+      return nullptr;
+    }
+
+    if ( group_and_sizes_part.size() < query.size() )
+    {
+      std::string variant_part = query.substr(group_and_sizes_part.size() + 1);
+      selector->is_validation = !variant_part.empty() && variant_part[0] == 'v';
+      if ( selector->is_validation )
+      {
+        variant_part = variant_part.substr(1);
+      }
+      if ( !parse_number(variant_part, selector->variant_number) )
+      {
+        invalid_query(query, "Expected a variant number after ':'.");
+        return nullptr;
+      }
+    }
+    return selector;
+  }
+
+  // dimension query, e.g., bug=linear_ooba,origin=heap
+  std::stringstream stream(query);
+  std::string pair;
+  while ( std::getline(stream, pair, ',') )
+  {
+    const size_t equals = pair.find('=');
+    if ( equals == std::string::npos )
+    {
+      invalid_query(query, "Expected key=value, got " + pair + ".");
+      return nullptr;
+    }
+    const std::string key = pair.substr(0, equals);
+    const std::string value = pair.substr(equals + 1);
+
+    // kind (0: temporal, 1: spatial, ANY: both), dimension index in file name order, names
+    struct Dimension { int kind; int index; PrimitiveDimension names; };
+    Dimension dimension{ANY, 0, REGIONS};
+    if ( key == "bug" )
+    {
+      if ( PrimitiveDimension(TEMPORAL_BUG_TYPES).find(value) != -1 )
+        dimension = Dimension{0, 0, TEMPORAL_BUG_TYPES};
+      else
+        dimension = Dimension{1, 0, SPATIAL_BUG_TYPES};
+    }
+    else if ( key == "state" ) dimension = Dimension{0, 1, MEMORY_STATES};
+    else if ( key == "region" ) dimension = Dimension{0, 2, REGIONS};
+    else if ( key == "origin" ) dimension = Dimension{1, 1, REGIONS};
+    else if ( key == "target" ) dimension = Dimension{1, 2, REGIONS};
+    else if ( key == "relation" ) dimension = Dimension{1, 3, ORIGIN_TARGET_RELATIONS};
+    else if ( key == "flow" ) dimension = Dimension{1, 4, FLOWS};
+    else if ( key == "location" ) dimension = Dimension{ANY, 3, ACCESS_LOCATIONS};
+    else if ( key == "action" ) dimension = Dimension{ANY, 4, ACCESS_ACTIONS};
+    else if ( key == "size" )
+    {
+      if ( !parse_object_sizes(value, selector->origin_size, selector->target_size) )
+      {
+        invalid_query(query, "Expected object sizes such as 4096x4096, got " + value + ".");
+        return nullptr;
+      }
+      if ( selector->kind == 0 )
+      {
+        invalid_query(query, "Cannot combine temporal and spatial dimensions.");
+        return nullptr;
+      }
+      selector->kind = 1;
+      continue;
+    }
+    else if ( key == "variant" )
+    {
+      if ( !parse_number(value, selector->variant_number) )
+      {
+        invalid_query(query, "Expected a variant number, got " + value + ".");
+        return nullptr;
+      }
+      continue;
+    }
+    else if ( key == "validation" )
+    {
+      if ( value != "yes" && value != "no" )
+      {
+        invalid_query(query, "Expected validation=yes or validation=no.");
+        return nullptr;
+      }
+      selector->is_validation = value == "yes";
+      continue;
+    }
+    else
+    {
+      invalid_query(query, "Unknown key " + key + ".");
+      return nullptr;
+    }
+
+    const int id = dimension.names.find(value);
+    if ( id == -1 )
+    {
+      invalid_query(query, "Unknown " + key + " " + value + ".");
+      return nullptr;
+    }
+    if ( dimension.kind != ANY )
+    {
+      if ( selector->kind != ANY && selector->kind != dimension.kind )
+      {
+        invalid_query(query, "Cannot combine temporal and spatial dimensions.");
+        return nullptr;
+      }
+      selector->kind = dimension.kind;
+    }
+    if ( dimension.kind == ANY )
+    {
+      // access location and action are the last two dimensions of both kinds, stored relative to the end
+      selector->location_action_ids[dimension.index - 3] = id;
+    }
+    else
+    {
+      selector->dimension_ids[dimension.index] = id;
+    }
+  }
+  return selector;
+}
+
+bool TestCaseSelector::matches_group(const std::string &group_name) const
+{
+  std::shared_ptr<TestCaseInformation> test_case_information = TestCaseInformation::construct_from_file_name(group_name + "_0", "", /*is_binary=*/true);
+  return test_case_information && matches_group(*test_case_information);
+}
+
+bool TestCaseSelector::matches_group(const TestCaseInformation &test_case_information) const
+{
+  const std::vector<uint8_t> &ids = test_case_information.get_dimension_ids();
+  const int group_kind = ids.size() == TestCaseInformation::SPATIAL_DIMENSIONS ? 1 : 0;
+  if ( kind != ANY && kind != group_kind )
+  {
+    return false;
+  }
+  for ( size_t i = 0; i < ids.size(); i++ )
+  {
+    if ( dimension_ids[i] != ANY && dimension_ids[i] != ids[i] )
+    {
+      return false;
+    }
+  }
+  for ( size_t i = 0; i < location_action_ids.size(); i++ )
+  {
+    if ( location_action_ids[i] != ANY && location_action_ids[i] != ids[ids.size() - 2 + i] )
+    {
+      return false;
+    }
+  }
+  if ( group_kind == 1 && origin_size != 0
+    && ( origin_size != test_case_information.get_origin_size() || target_size != test_case_information.get_target_size() ) )
+  {
+    return false;
+  }
+  return true;
+}
+
+bool TestCaseSelector::matches_variant(bool validation, int number) const
+{
+  return (is_validation == ANY || is_validation == validation) && (variant_number == ANY || variant_number == number);
+}
@@ -0,0 +1,70 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TestCaseInformation;
+
+/**
+ * Test case IDs are derived from the dimension IDs of a test case (see TestCaseInformation::get_dimension_ids()).
+ *
+ * The group ID identifies all variants of a test case: 8 hexadecimal digits, where the most significant digit is 0 for
+ * temporal and 1 for spatial test cases, followed by one digit per dimension in file name order, right-aligned.
+ * Spatial test cases with other than the default object sizes append them, e.g., "10000001-4096x4096".
+ * The full ID appends the variant, e.g., "10000001:3" or "10000001:v0" for a validation variant.
+ */
+extern uint32_t make_group_id(const std::vector<uint8_t> &dimension_ids);
+extern std::string group_id_to_string(uint32_t group_id);
+extern std::string make_test_case_group_id(const TestCaseInformation &test_case_information);
+extern std::string make_test_case_id(const TestCaseInformation &test_case_information);
+
+/**
+ * Whether a test case belongs to shard shard_index of shard_count. Test cases are assigned by a hash of their ID without
+ * the variant, so all variants of a test case are in the same shard, independently of the machine and the suite.
+ */
+extern bool is_in_shard(const TestCaseInformation &test_case_information, size_t shard_index, size_t shard_count);
+
+/**
+ * Selects test cases by ID or by a dimension query.
+ *
+ * Accepted queries:
+ *  - a full ID, e.g., "10000001:3", selecting a single variant
+ *  - a group ID, e.g., "10000001", selecting all variants of a test case
+ *  - comma separated key=value pairs, e.g., "bug=linear_ooba,origin=heap,action=write", where the values are the names
+ *    used in file names. Keys: bug, state, region (temporal), origin, target, relation, flow, size (spatial),
+ *    location, action, variant and validation (yes/no). Sizes are given as origin and target size, e.g., 4096x4096.
+ * IDs select the default object sizes unless they name other sizes; dimension queries select all sizes unless
+ * the size key is given.
+ */
+class TestCaseSelector
+{
+public:
+  static std::unique_ptr<TestCaseSelector> parse(const std::string &query);
+
+  /**
+   * group_name is a test case file name without the variant suffix, e.g., "double_free_used_memory_heap_direct_read".
+   */
+  bool matches_group(const std::string &group_name) const;
+  bool matches_group(const TestCaseInformation &test_case_information) const;
+  bool matches_variant(bool is_validation, int variant_number) const;
+
+private:
+  TestCaseSelector() = default;
+
+  enum { ANY = -1 };
+  int kind = ANY; // 0: temporal, 1: spatial
+  std::vector<int> dimension_ids = std::vector<int>(7, ANY);
+  std::vector<int> location_action_ids = std::vector<int>(2, ANY); // shared by both kinds, the last two dimensions
+  int variant_number = ANY;
+  int is_validation = ANY;
+  size_t origin_size = 0; // 0: any
+  size_t target_size = 0;
+};
@@ -0,0 +1,186 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#include "trace.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+struct trace_event_t
+{
+  const char *name;
+  std::string test_key;
+  std::string detail;
+  int64_t start_us; // since Trace::enable()
+  int64_t duration_us;
+};
+
+/**
+ * The spans recorded by the threads of one row of the trace, only accessed by the thread holding the row until
+ * Trace::write(). A thread holds a row until it exits, then the row is handed to the next thread that records a span,
+ * so that short-lived threads, e.g., those of speculative variants, do not add a row each.
+ */
+struct thread_trace_t
+{
+  size_t index; // the thread ID shown in the trace
+  bool is_main;
+  std::string test_key; // of the innermost TraceSpan
+  std::vector<trace_event_t> events;
+};
+
+/**
+ * Returns the row of the thread to the free rows when the thread exits.
+ */
+struct thread_row_t
+{
+  thread_trace_t *trace = nullptr;
+  ~thread_row_t();
+};
+}
+
+bool Trace::enabled = false;
+
+static Trace::time_point_t trace_start;
+static std::thread::id main_thread_id;
+static std::mutex threads_mutex; // only taken when a thread records its first span and when it exits
+static std::vector<std::unique_ptr<thread_trace_t>> thread_traces; // outlive their threads
+static std::set<size_t> free_rows; // indices of the thread_traces of exited threads
+static thread_local thread_row_t thread_row;
+
+thread_row_t::~thread_row_t()
+{
+  if ( !trace || trace->is_main ) return;
+  std::lock_guard<std::mutex> lock(threads_mutex);
+  trace->test_key.clear();
+  free_rows.insert(trace->index);
+}
+
+static thread_trace_t &get_thread_trace()
+{
+  if ( !thread_row.trace )
+  {
+    std::lock_guard<std::mutex> lock(threads_mutex);
+    const bool is_main = std::this_thread::get_id() == main_thread_id;
+    if ( !is_main && !free_rows.empty() )
+    {
+      thread_row.trace = thread_traces[*free_rows.begin()].get();
+      free_rows.erase(free_rows.begin());
+      return *thread_row.trace;
+    }
+    thread_traces.emplace_back(new thread_trace_t());
+    thread_row.trace = thread_traces.back().get();
+    thread_row.trace->index = thread_traces.size() - 1;
+    thread_row.trace->is_main = is_main;
+  }
+  return *thread_row.trace;
+}
+
+static int64_t to_us(Trace::time_point_t time_point)
+{
+  return std::chrono::duration_cast<std::chrono::microseconds>(time_point - trace_start).count();
+}
+
+void Trace::enable()
+{
+  trace_start = std::chrono::steady_clock::now();
+  main_thread_id = std::this_thread::get_id();
+  enabled = true;
+}
+
+void Trace::add_span(const char *name, time_point_t start, time_point_t end, const std::string &test_key, const std::string &detail)
+{
+  if ( !enabled ) return;
+  thread_trace_t &trace = get_thread_trace();
+  trace.events.push_back({name, test_key.empty() ? trace.test_key : test_key, detail, to_us(start), to_us(end) - to_us(start)});
+}
+
+static void write_json_string(std::ostream &out, const std::string &value)
+{
+  out << '"';
+  for ( const char c: value )
+  {
+    if ( c == '"' || c == '\\' )
+    {
+      out << '\\' << c;
+    }
+    else if ( static_cast<unsigned char>(c) < 0x20 )
+    {
+      char escaped[8];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+      out << escaped;
+    }
+    else
+    {
+      out << c;
+    }
+  }
+  out << '"';
+}
+
+bool Trace::write(const std::string &path)
+{
+  std::ofstream out(path);
+  if ( !out ) return false;
+  const pid_t pid = getpid();
+  std::lock_guard<std::mutex> lock(threads_mutex);
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool first = true;
+  for ( const auto &trace: thread_traces )
+  {
+    out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"tid\":" << trace->index
+      << ",\"args\":{\"name\":\"" << (trace->is_main ? std::string("main") : "worker " + std::to_string(trace->index)) << "\"}}";
+    first = false;
+    for ( const trace_event_t &event: trace->events )
+    {
+      out << ",\n{\"name\":";
+      write_json_string(out, event.name);
+      out << ",\"cat\":\"mset\",\"ph\":\"X\",\"ts\":" << event.start_us << ",\"dur\":" << event.duration_us
+        << ",\"pid\":" << pid << ",\"tid\":" << trace->index << ",\"args\":{\"worker\":" << trace->index;
+      if ( !event.test_key.empty() )
+      {
+        out << ",\"test case\":";
+        write_json_string(out, event.test_key);
+      }
+      if ( !event.detail.empty() )
+      {
+        out << ",\"detail\":";
+        write_json_string(out, event.detail);
+      }
+      out << "}}";
+    }
+  }
+  out << "\n]}\n";
+  out.close();
+  return !out.fail();
+}
+
+TraceSpan::TraceSpan(const char *name, const std::string &test_key, const std::string &detail):
+  name(name), recording(Trace::is_enabled())
+{
+  if ( !recording ) return;
+  this->detail = detail;
+  thread_trace_t &trace = get_thread_trace();
+  previous_key = trace.test_key;
+  if ( !test_key.empty() ) trace.test_key = test_key;
+  start = std::chrono::steady_clock::now();
+}
+
+TraceSpan::~TraceSpan()
+{
+  if ( !recording ) return;
+  Trace::add_span(name, start, std::chrono::steady_clock::now(), "", detail);
+  get_thread_trace().test_key = previous_key;
+}
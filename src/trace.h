@@ -0,0 +1,60 @@
+/*
+ * This file is distributed under the Apache License, Version 2.0; refer to
+ * LICENSE for details.
+ *
+ * Initial author: Emanuel Vintila
+ */
+
+#pragma once
+#include <chrono>
+#include <string>
+
+/**
+ * Records a timeline of spans in the trace event format, viewable in Perfetto or chrome://tracing, see --trace-out.
+ *
+ * Each thread appends its spans to the buffer of its row without locking; the row of a thread that exited is reused by
+ * the next new thread. The buffers are only written, all at once, by write(), which must be called once the recording
+ * threads are done. Recording is a no-op unless enable() was called.
+ */
+class Trace
+{
+public:
+  typedef std::chrono::steady_clock::time_point time_point_t;
+
+  static void enable();
+  static bool is_enabled() { return enabled; }
+
+  /**
+   * Records a span of the calling thread. The span is tagged with test_key, or if empty, with the test key of the
+   * innermost enclosing TraceSpan of the thread. detail, e.g., the command run, is shown with the span if not empty.
+   */
+  static void add_span(const char *name, time_point_t start, time_point_t end, const std::string &test_key = "", const std::string &detail = "");
+
+  /**
+   * Writes the spans of all threads to path. Returns false on failure.
+   */
+  static bool write(const std::string &path);
+
+private:
+  static bool enabled;
+};
+
+/**
+ * Records a span from its construction until it goes out of scope. The spans recorded by the same thread meanwhile are
+ * tagged with its test key, unless given their own.
+ */
+class TraceSpan
+{
+public:
+  TraceSpan(const char *name, const std::string &test_key = "", const std::string &detail = "");
+  ~TraceSpan();
+  TraceSpan(const TraceSpan &) = delete;
+  TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+  const char *name;
+  bool recording;
+  std::string detail;
+  std::string previous_key; // of the enclosing span, restored when this one ends
+  Trace::time_point_t start;
+};
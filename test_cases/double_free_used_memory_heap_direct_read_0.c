@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h> // clock_gettime
 
 #ifdef ADDR_MASK
 #define GET_ADDR_BITS(p) ((size_t)(p) & ADDR_MASK)
@@ -29,6 +30,16 @@
 
 volatile void *_use(volatile void *p) { return p; }
 const char content[8] = "ZZZZZZZ";
+// called right before the bug; writes the time to the file descriptor given by the evaluator, see --latency
+void _trigger()
+{
+  const char *fd = getenv("MSET_TRIGGER_FD");
+  struct timespec now;
+  if ( !fd || clock_gettime(CLOCK_MONOTONIC, &now) != 0 ) return;
+  int64_t nanoseconds = (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+  ssize_t written = pwrite(atoi(fd), &nanoseconds, sizeof(nanoseconds), 0);
+  (void)written;
+}
 
 // types
 
@@ -47,6 +58,7 @@ int f()
   char *pointer_to_use; // pointer to illegally use
   pointer_to_double_free = (char *)malloc(10);
   free(pointer_to_double_free);
+  _trigger();
   pointer_to_double_free[sizeof(void *)] = 0; // use-after-free for heap metadata corruption
   free(pointer_to_double_free); // double free
   pointer_to_use = (char *)malloc(8); // allocate a new object
@@ -17,6 +17,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h> // clock_gettime
 
 #ifdef ADDR_MASK
 #define GET_ADDR_BITS(p) ((size_t)(p) & ADDR_MASK)
@@ -29,6 +30,16 @@
 
 volatile void *_use(volatile void *p) { return p; }
 const char content[8] = "ZZZZZZZ";
+// called right before the bug; writes the time to the file descriptor given by the evaluator, see --latency
+void _trigger()
+{
+  const char *fd = getenv("MSET_TRIGGER_FD");
+  struct timespec now;
+  if ( !fd || clock_gettime(CLOCK_MONOTONIC, &now) != 0 ) return;
+  int64_t nanoseconds = (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+  ssize_t written = pwrite(atoi(fd), &nanoseconds, sizeof(nanoseconds), 0);
+  (void)written;
+}
 
 // types
 
@@ -51,6 +62,7 @@ int f()
   pointer_to_double_free = (char *)malloc(8);
   free(pointer_to_double_free);
   free(tmp); // no use after free required
+  _trigger();
   free(pointer_to_double_free); // double free
   pointer_to_use = (char *)malloc(8); // allocate a new object
   tmp3 = (char *)malloc(8);
@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h> // clock_gettime
 
 #ifdef ADDR_MASK
 #define GET_ADDR_BITS(p) ((size_t)(p) & ADDR_MASK)
@@ -33,6 +34,16 @@
 
 volatile void *_use(volatile void *p) { return p; }
 const char content[8] = "ZZZZZZZ";
+// called right before the bug; writes the time to the file descriptor given by the evaluator, see --latency
+void _trigger()
+{
+  const char *fd = getenv("MSET_TRIGGER_FD");
+  struct timespec now;
+  if ( !fd || clock_gettime(CLOCK_MONOTONIC, &now) != 0 ) return;
+  int64_t nanoseconds = (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+  ssize_t written = pwrite(atoi(fd), &nanoseconds, sizeof(nanoseconds), 0);
+  (void)written;
+}
 
 // types
 
@@ -51,6 +62,7 @@ int f()
 
   _use(target);
   _use(origin);
+  _trigger();
   if ( !((ssize_t)(GET_ADDR_BITS(target) - GET_ADDR_BITS(origin)) >= 0) ) _exit(PRECONDITIONS_FAILED_VALUE);
   aux_ptr = &origin[0];
   while( GET_ADDR_BITS(aux_ptr) != GET_ADDR_BITS(target) )
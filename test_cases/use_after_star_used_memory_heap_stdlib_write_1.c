@@ -14,6 +14,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h> // clock_gettime
 
 #ifdef ADDR_MASK
 #define GET_ADDR_BITS(p) ((size_t)(p) & ADDR_MASK)
@@ -26,6 +27,16 @@
 
 volatile void *_use(volatile void *p) { return p; }
 const char content[8] = "ZZZZZZZ";
+// called right before the bug; writes the time to the file descriptor given by the evaluator, see --latency
+void _trigger()
+{
+  const char *fd = getenv("MSET_TRIGGER_FD");
+  struct timespec now;
+  if ( !fd || clock_gettime(CLOCK_MONOTONIC, &now) != 0 ) return;
+  int64_t nanoseconds = (int64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+  ssize_t written = pwrite(atoi(fd), &nanoseconds, sizeof(nanoseconds), 0);
+  (void)written;
+}
 
 // types
 
@@ -61,6 +72,7 @@ int f()
     if ( GET_ADDR_BITS(target) == GET_ADDR_BITS(reallocated) ) break;
     counter++;}
   if ( counter == 1000000000 ) _exit(PRECONDITIONS_FAILED_VALUE);
+  _trigger();
   memset( (void *)target_address, 0xFF, 8);
   _use(target_address);
   _exit(TEST_CASE_SUCCESSFUL_VALUE);